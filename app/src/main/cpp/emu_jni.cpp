@@ -18,6 +18,7 @@
 #include "skyline/gpu.h"
 #include "skyline/audio.h"
 #include "skyline/input.h"
+#include "skyline/nce.h"
 #include "skyline/kernel/types/KProcess.h"
 
 jint Fps; //!< An approximation of the amount of frames being submitted every second
@@ -181,6 +182,19 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_updatePerformanceSt
     if (!averageFrametimeDeviationField)
         averageFrametimeDeviationField = env->GetFieldID(clazz, "averageFrametimeDeviation", "F");
     env->SetFloatField(thiz, averageFrametimeDeviationField, AverageFrametimeDeviationMs);
+
+    static jfieldID averageInputLatencyField{};
+    if (!averageInputLatencyField)
+        averageInputLatencyField = env->GetFieldID(clazz, "averageInputLatency", "F");
+    auto input{InputWeak.lock()};
+    env->SetFloatField(thiz, averageInputLatencyField, input ? std::chrono::duration<float, std::milli>(input->sampler.GetAverageLatency()).count() : 0.0f);
+}
+
+extern "C" JNIEXPORT jstring Java_emu_skyline_EmulationActivity_getSvcStatistics(JNIEnv *env, jobject) {
+    auto os{OsWeak.lock()};
+    if (!os || !os->state.nce->svcStatistics)
+        return nullptr;
+    return env->NewStringUTF(os->state.nce->svcStatistics->Dump().c_str());
 }
 
 extern "C" JNIEXPORT void JNICALL Java_emu_skyline_EmulationActivity_setController(JNIEnv *, jobject, jint index, jint type, jint partnerIndex) {
@@ -2,22 +2,26 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include "common.h"
+#include "common/settings.h"
 #include "nce.h"
 #include "soc.h"
 #include "gpu.h"
 #include "audio.h"
 #include "input.h"
 #include "kernel/types/KProcess.h"
+#include "kernel/host_thread_pool.h"
+#include "os.h"
 
 namespace skyline {
     DeviceState::DeviceState(kernel::OS *os, std::shared_ptr<JvmManager> jvmManager, std::shared_ptr<Settings> settings)
         : os(os), jvm(std::move(jvmManager)), settings(std::move(settings)) {
         // We assign these later as they use the state in their constructor and we don't want null pointers
         gpu = std::make_shared<gpu::GPU>(*this);
-        soc = std::make_shared<soc::SOC>(*this);
+        soc = std::make_shared<soc::SOC>(*this, this->settings->gpuCapture ? os->appFilesPath + "gpu_capture.skpb" : std::string{});
         audio = std::make_shared<audio::Audio>(*this);
         nce = std::make_shared<nce::NCE>(*this);
         scheduler = std::make_shared<kernel::Scheduler>(*this);
+        threadPool = std::make_shared<kernel::HostThreadPool>();
         input = std::make_shared<input::Input>(*this);
     }
 
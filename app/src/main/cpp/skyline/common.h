@@ -39,6 +39,7 @@ namespace skyline {
             class KThread;
         }
         class Scheduler;
+        class HostThreadPool;
         class OS;
     }
     namespace audio {
@@ -71,6 +72,7 @@ namespace skyline {
         std::shared_ptr<audio::Audio> audio;
         std::shared_ptr<nce::NCE> nce;
         std::shared_ptr<kernel::Scheduler> scheduler;
+        std::shared_ptr<kernel::HostThreadPool> threadPool;
         std::shared_ptr<input::Input> input;
     };
 }
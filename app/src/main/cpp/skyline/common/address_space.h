@@ -5,6 +5,7 @@
 
 #include <concepts>
 #include <common.h>
+#include <common/thread_local.h>
 
 namespace skyline {
     template<typename VaType, size_t AddressSpaceBits>
@@ -50,8 +51,9 @@ namespace skyline {
             }
         };
 
-        std::mutex blockMutex;
+        std::shared_mutex blockMutex; //!< Exclusively locked while the blocks are modified, lookups and accesses to the memory of the blocks only need a shared lock
         std::vector<Block> blocks{Block{}};
+        std::atomic<size_t> generation{1}; //!< A counter incremented on every change to the mappings, it's used to invalidate cached translations
 
         /**
          * @brief Maps a PA range into the given AS region
@@ -76,11 +78,13 @@ namespace skyline {
 
         void Map(VaType virt, PaType phys, VaType size, ExtraBlockInfo extraInfo = {}) {
             std::scoped_lock lock(blockMutex);
+            generation.fetch_add(1, std::memory_order_release);
             MapLocked(virt, phys, size, extraInfo);
         }
 
         void Unmap(VaType virt, VaType size) {
             std::scoped_lock lock(blockMutex);
+            generation.fetch_add(1, std::memory_order_release);
             UnmapLocked(virt, size);
         }
     };
@@ -101,6 +105,51 @@ namespace skyline {
         static constexpr u64 SparseMapSize{0x400000000}; //!< 16GiB pool size for sparse mappings returned by TranslateRange, this number is arbritary and should be large enough to fit the largest sparse mapping in the AS
         u8 *sparseMap; //!< Pointer to a zero filled memory region that is returned by TranslateRange for sparse mappings
 
+        static constexpr size_t TlbPageBits{12}; //!< The granularity at which blocks are indexed in the TLB in bits, this matches the smallest GMMU page size
+        static constexpr size_t TlbEntryCount{256}; //!< The amount of entries in the TLB of each thread, this must be a power of 2
+
+        struct TlbEntry {
+            VaType virt{UnmappedVa}; //!< The VA of the start of the block this entry translates
+            VaType virtEnd{UnmappedVa}; //!< The VA of the end of the block
+            u8 *phys{}; //!< The host address of the start of the block, this is null for entries which were never filled
+            size_t generation{}; //!< The mapping generation at which this entry was filled, the entry is stale if it doesn't match the current generation
+        };
+
+        /**
+         * @brief A direct-mapped cache of block translations indexed by page, this avoids searching the blocks for accesses to recently used memory
+         * @note Only regular (non-sparse) mapped blocks are cached, all other accesses go through the blocks
+         */
+        struct Tlb {
+            std::array<TlbEntry, TlbEntryCount> entries{};
+        };
+        ThreadLocal<Tlb, false> tlb; //!< The TLB of each thread, it's thread-local to avoid synchronizing lookups and fills
+
+        /**
+         * @brief A translation of a VA to host memory which is contiguous until the end of the block containing it
+         */
+        struct Translation {
+            u8 *phys; //!< The host address corresponding to the VA, this is null if the VA isn't inside a regular mapping
+            VaType size; //!< The amount of bytes from the VA until the end of the block
+        };
+
+        /**
+         * @brief Translates a VA using the TLB of the calling thread, filling it with the entire block containing the VA on a miss
+         * @note blockMutex MUST be locked (shared or exclusively) when calling this and for as long as the returned pointer is accessed, this ensures that the mapping cannot be changed concurrently
+         */
+        Translation TranslateLocked(VaType virt);
+
+        /**
+         * @brief Reads from the AS by searching the blocks, this supports sparse mappings and accesses that cross mappings
+         * @note blockMutex MUST be locked (shared or exclusively) when calling this
+         */
+        void ReadSlowLocked(u8 *destination, VaType virt, VaType size);
+
+        /**
+         * @brief Writes to the AS by searching the blocks, this supports sparse mappings and accesses that cross mappings
+         * @note blockMutex MUST be locked (shared or exclusively) when calling this
+         */
+        void WriteSlowLocked(VaType virt, u8 *source, VaType size);
+
       public:
         FlatMemoryManager();
 
@@ -113,11 +162,56 @@ namespace skyline {
             return reinterpret_cast<u8 *>(0xCAFEBABE);
         }
 
+        /**
+         * @brief Calls the supplied function with all physical ranges inside of the given virtual range in ascending order, this doesn't allocate any memory
+         * @note The function is called while holding the block mutex, it must not call back into the memory manager
+         */
+        template<typename Function>
+        void TranslateRange(VaType virt, VaType size, Function &&function) {
+            std::shared_lock lock(this->blockMutex);
+
+            auto successor{std::upper_bound(this->blocks.begin(), this->blocks.end(), virt, [] (auto virt, const auto &block) {
+                return virt < block.virt;
+            })};
+
+            auto predecessor{std::prev(successor)};
+
+            u8 *blockPhys{predecessor->phys + (virt - predecessor->virt)};
+            VaType blockSize{std::min(successor->virt - virt, size)};
+
+            while (size) {
+                // Return a zeroed out map to emulate sparse mappings
+                if (predecessor->extraInfo.sparseMapped) {
+                    if (blockSize > SparseMapSize)
+                        throw exception("Size of the sparse map is too small to fit block of size: 0x{:X}", blockSize);
+
+                    blockPhys = sparseMap;
+                }
+
+                function(span<u8>(blockPhys, blockSize));
+
+                size -= blockSize;
+
+                if (size) {
+                    predecessor = successor++;
+                    blockPhys = predecessor->phys;
+                    blockSize = std::min(successor->virt - predecessor->virt, size);
+                }
+            }
+        }
+
         /**
          * @brief Returns a vector of all physical ranges inside of the given virtual range
          */
         std::vector<span<u8>> TranslateRange(VaType virt, VaType size);
 
+        /**
+         * @return A pointer to the physical memory backing the given virtual range if it is contiguous in host memory, nullptr otherwise
+         * @note Ranges spanning multiple mappings are considered contiguous if the mappings are backed by adjacent host memory
+         * @note nullptr is returned if any part of the range is unmapped or sparse mapped, callers must fall back to Read/Write in that case
+         */
+        u8 *TranslateContiguous(VaType virt, VaType size);
+
         void Read(u8 *destination, VaType virt, VaType size);
 
         template<typename T>
@@ -31,6 +31,11 @@ namespace skyline {
         logTag = std::string("emu-cpp-") + threadName;
     }
 
+    void Logger::UpdateTag(std::string name) {
+        threadName = std::move(name);
+        logTag = std::string("emu-cpp-") + threadName;
+    }
+
     Logger::LoggerContext *Logger::GetContext() {
         return context;
     }
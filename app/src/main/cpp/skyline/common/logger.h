@@ -51,6 +51,12 @@ namespace skyline {
          */
         static void UpdateTag();
 
+        /**
+         * @brief Update the tag in log messages with the supplied name without renaming the host thread
+         * @note This is used by threads which run a succession of different tasks, where renaming the host thread for each of them would be wasteful
+         */
+        static void UpdateTag(std::string name);
+
         static LoggerContext *GetContext();
 
         static void SetContext(LoggerContext *context);
@@ -21,6 +21,13 @@ namespace skyline {
             PREF_ELEM("operation_mode", operationMode, element.attribute("value").as_bool()),
             PREF_ELEM("force_triple_buffering", forceTripleBuffering, element.attribute("value").as_bool()),
             PREF_ELEM("disable_frame_throttling", disableFrameThrottling, element.attribute("value").as_bool()),
+            PREF_ELEM("gpu_capture", gpuCapture, element.attribute("value").as_bool()),
+            PREF_ELEM("huge_pages", hugePages, element.attribute("value").as_bool()),
+            PREF_ELEM("guest_profiler", guestProfiler, element.attribute("value").as_bool()),
+            PREF_ELEM("svc_statistics", svcStatistics, element.attribute("value").as_bool()),
+            PREF_ELEM("guest_snapshots", guestSnapshots, element.attribute("value").as_bool()),
+            PREF_ELEM("block_cache_size", blockCacheSize, element.text().as_uint(32)),
+            PREF_ELEM("input_sampling_rate", inputSamplingRate, element.text().as_uint(200)),
         };
 
         #undef PREF_ELEM
@@ -16,6 +16,13 @@ namespace skyline {
         bool operationMode; //!< If the emulated Switch should be handheld or docked
         bool forceTripleBuffering; //!< If the presentation engine should always triple buffer even if the swapchain supports double buffering
         bool disableFrameThrottling; //!< Allow the guest to submit frames without any blocking calls
+        bool gpuCapture; //!< If the GPU pushbuffers of the guest should be captured to a file for offline replay
+        bool hugePages; //!< If the guest code, alias and heap regions should be backed by transparent huge pages
+        bool guestProfiler; //!< If guest code should be profiled by sampling the call stacks of running guest threads
+        bool svcStatistics; //!< If the amount of calls and latency of every SVC should be tracked
+        bool guestSnapshots; //!< If incremental snapshots of the guest state should periodically be written to disk
+        u32 blockCacheSize; //!< The size of the cache for decrypted blocks of ROM files in MiB
+        u32 inputSamplingRate; //!< The rate at which host input is published to the guest in Hz
 
         /**
          * @param fd An FD to the preference XML file
@@ -100,4 +100,11 @@ namespace skyline::signal {
             sigaddset(&set, signal);
         Sigprocmask(SIG_BLOCK, set, nullptr);
     }
+
+    inline void UnblockSignal(std::initializer_list<int> signals) {
+        sigset_t set{};
+        for (int signal : signals)
+            sigaddset(&set, signal);
+        Sigprocmask(SIG_UNBLOCK, set, nullptr);
+    }
 }
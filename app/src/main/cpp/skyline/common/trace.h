@@ -14,6 +14,8 @@ PERFETTO_DEFINE_CATEGORIES(
     perfetto::Category("guest").SetDescription("Events relating to guest code"),
     perfetto::Category("gpu").SetDescription("Events from the emulated GPU"),
     perfetto::Category("service").SetDescription("Events from the HLE sysmodule implementations"),
+    perfetto::Category("input").SetDescription("Events from the sampling of host input"),
+    perfetto::Category("loader").SetDescription("Events from loading the guest application during startup"),
     perfetto::Category("containers").SetDescription("Events from custom container implementations")
 );
 
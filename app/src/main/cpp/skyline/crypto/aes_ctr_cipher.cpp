@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#include <arm_neon.h>
+#include "aes_ctr_cipher.h"
+
+namespace skyline::crypto {
+    /**
+     * @brief The forward AES S-Box, this is only used during key expansion as the rounds themselves are done by the hardware or mbedtls
+     */
+    constexpr std::array<u8, 0x100> SBox{
+        0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+        0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+        0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+        0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+        0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+        0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+        0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+        0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+        0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+        0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+        0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+        0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+        0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+        0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+        0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+        0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+    };
+
+    constexpr std::array<u8, 10> RoundConstants{0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+    /**
+     * @return If the host CPU implements the AES instructions from ARMv8 Crypto Extensions
+     */
+    static bool HasHardwareAes() {
+        static const bool hasAes{(getauxval(AT_HWCAP) & HWCAP_AES) != 0};
+        return hasAes;
+    }
+
+    AesCtrCipher::AesCtrCipher(const Block &key, const Block &ctr) : hardwareAes(HasHardwareAes()) {
+        std::memcpy(&nonce, ctr.data(), sizeof(u64));
+        u64 counterBe;
+        std::memcpy(&counterBe, ctr.data() + sizeof(u64), sizeof(u64));
+        counterBase = util::SwapEndianness(counterBe);
+
+        // AES-128 key expansion (FIPS-197 Section 5.2), the schedule is stored as a contiguous sequence of 4-byte words
+        auto words{reinterpret_cast<u8 *>(roundKeys.data())};
+        std::memcpy(words, key.data(), key.size());
+        for (size_t word{4}; word < (RoundCount + 1) * 4; word++) {
+            std::array<u8, 4> temp;
+            std::memcpy(temp.data(), words + (word - 1) * 4, temp.size());
+
+            if (word % 4 == 0) {
+                temp = {
+                    static_cast<u8>(SBox[temp[1]] ^ RoundConstants[(word / 4) - 1]),
+                    SBox[temp[2]],
+                    SBox[temp[3]],
+                    SBox[temp[0]],
+                };
+            }
+
+            for (size_t i{}; i < temp.size(); i++)
+                words[word * 4 + i] = words[(word - 4) * 4 + i] ^ temp[i];
+        }
+
+        mbedtls_aes_init(&fallbackContext);
+        if (!hardwareAes && mbedtls_aes_setkey_enc(&fallbackContext, key.data(), static_cast<unsigned int>(key.size() * 8)) != 0)
+            throw exception("Failed to set key for AES-CTR fallback context");
+    }
+
+    AesCtrCipher::~AesCtrCipher() {
+        mbedtls_aes_free(&fallbackContext);
+    }
+
+    void AesCtrCipher::TransformBlocksHardware(u8 *destination, const u8 *source, u64 block, size_t count) const {
+        std::array<uint8x16_t, RoundCount + 1> keys;
+        for (size_t round{}; round < keys.size(); round++)
+            keys[round] = vld1q_u8(roundKeys[round].data());
+
+        uint8x8_t nonceVector{vcreate_u8(nonce)};
+        auto counter{[&](u64 index) {
+            return vcombine_u8(nonceVector, vrev64_u8(vcreate_u8(counterBase + index)));
+        }};
+
+        auto encrypt{[&](uint8x16_t state) {
+            for (size_t round{}; round < RoundCount - 1; round++)
+                state = vaesmcq_u8(vaeseq_u8(state, keys[round]));
+            return veorq_u8(vaeseq_u8(state, keys[RoundCount - 1]), keys[RoundCount]);
+        }};
+
+        // Independent blocks are interleaved so the AESE/AESMC pairs from each can be pipelined
+        for (; count >= BatchBlocks; count -= BatchBlocks, block += BatchBlocks, source += BatchBlocks * BlockSize, destination += BatchBlocks * BlockSize) {
+            uint8x16_t state0{counter(block)}, state1{counter(block + 1)}, state2{counter(block + 2)}, state3{counter(block + 3)};
+            for (size_t round{}; round < RoundCount - 1; round++) {
+                state0 = vaesmcq_u8(vaeseq_u8(state0, keys[round]));
+                state1 = vaesmcq_u8(vaeseq_u8(state1, keys[round]));
+                state2 = vaesmcq_u8(vaeseq_u8(state2, keys[round]));
+                state3 = vaesmcq_u8(vaeseq_u8(state3, keys[round]));
+            }
+            state0 = veorq_u8(vaeseq_u8(state0, keys[RoundCount - 1]), keys[RoundCount]);
+            state1 = veorq_u8(vaeseq_u8(state1, keys[RoundCount - 1]), keys[RoundCount]);
+            state2 = veorq_u8(vaeseq_u8(state2, keys[RoundCount - 1]), keys[RoundCount]);
+            state3 = veorq_u8(vaeseq_u8(state3, keys[RoundCount - 1]), keys[RoundCount]);
+
+            vst1q_u8(destination, veorq_u8(vld1q_u8(source), state0));
+            vst1q_u8(destination + BlockSize, veorq_u8(vld1q_u8(source + BlockSize), state1));
+            vst1q_u8(destination + BlockSize * 2, veorq_u8(vld1q_u8(source + BlockSize * 2), state2));
+            vst1q_u8(destination + BlockSize * 3, veorq_u8(vld1q_u8(source + BlockSize * 3), state3));
+        }
+
+        for (; count; count--, block++, source += BlockSize, destination += BlockSize)
+            vst1q_u8(destination, veorq_u8(vld1q_u8(source), encrypt(counter(block))));
+    }
+
+    void AesCtrCipher::TransformBlocksSoftware(u8 *destination, const u8 *source, u64 block, size_t count) const {
+        for (; count; count--, block++, source += BlockSize, destination += BlockSize) {
+            Block keystream{GetCounter(block)};
+            mbedtls_aes_crypt_ecb(&fallbackContext, MBEDTLS_AES_ENCRYPT, keystream.data(), keystream.data());
+            for (size_t i{}; i < BlockSize; i++)
+                destination[i] = source[i] ^ keystream[i];
+        }
+    }
+
+    void AesCtrCipher::TransformBlocks(u8 *destination, const u8 *source, u64 block, size_t count) const {
+        if (hardwareAes)
+            TransformBlocksHardware(destination, source, block, count);
+        else
+            TransformBlocksSoftware(destination, source, block, count);
+    }
+
+    void AesCtrCipher::Decrypt(u8 *destination, const u8 *source, size_t size, size_t offset) const {
+        u64 block{offset / BlockSize};
+
+        // Partial blocks at the head or tail are transformed through a stack buffer, only the overlapping bytes are copied out
+        auto transformPartial{[&](size_t blockOffset, size_t length) {
+            Block buffer{};
+            std::memcpy(buffer.data() + blockOffset, source, length);
+            TransformBlocks(buffer.data(), buffer.data(), block++, 1);
+            std::memcpy(destination, buffer.data() + blockOffset, length);
+            source += length;
+            destination += length;
+            size -= length;
+        }};
+
+        if (size_t blockOffset{offset % BlockSize}; blockOffset && size)
+            transformPartial(blockOffset, std::min(BlockSize - blockOffset, size));
+
+        if (size_t blocks{size / BlockSize}) {
+            TransformBlocks(destination, source, block, blocks);
+            block += blocks;
+            source += blocks * BlockSize;
+            destination += blocks * BlockSize;
+            size -= blocks * BlockSize;
+        }
+
+        if (size)
+            transformPartial(0, size);
+    }
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <mbedtls/aes.h>
+#include <common.h>
+
+namespace skyline::crypto {
+    /**
+     * @brief A stateless AES-128-CTR cipher which derives the keystream for any offset directly from the counter
+     * @note Unlike AesCipher, no IV state is retained between calls so this can be used concurrently from multiple threads without any locking
+     * @note ARMv8 Crypto Extensions are used when the host supports them, otherwise this falls back to mbedtls' ECB encryption for keystream generation
+     */
+    class AesCtrCipher {
+      public:
+        static constexpr size_t BlockSize{0x10};
+        using Block = std::array<u8, BlockSize>;
+
+      private:
+        static constexpr size_t RoundCount{10}; //!< The amount of rounds in AES-128
+        static constexpr size_t BatchBlocks{4}; //!< The amount of blocks that are transformed together to hide the latency of the AES instructions
+
+        std::array<Block, RoundCount + 1> roundKeys; //!< The expanded encryption key schedule
+        u64 nonce; //!< The upper half of the initial counter, this is used verbatim in every counter block
+        u64 counterBase; //!< The lower half of the initial counter in host byte order, block indices are added to this
+        bool hardwareAes; //!< If the AES instructions from ARMv8 Crypto Extensions can be used
+        mutable mbedtls_aes_context fallbackContext; //!< An ECB encryption context for hosts without hardware AES, ECB encryption doesn't mutate it so sharing is safe
+
+        /**
+         * @return The counter block for the block at the supplied index relative to the initial counter
+         */
+        Block GetCounter(u64 block) const {
+            Block counter;
+            u64 counterBe{util::SwapEndianness(counterBase + block)};
+            std::memcpy(counter.data(), &nonce, sizeof(u64));
+            std::memcpy(counter.data() + sizeof(u64), &counterBe, sizeof(u64));
+            return counter;
+        }
+
+        /**
+         * @brief Encrypts the counters for a sequence of blocks and XORs the resulting keystream with the source
+         * @param block The index of the first block relative to the initial counter
+         * @param count The amount of blocks to transform
+         */
+        void TransformBlocks(u8 *destination, const u8 *source, u64 block, size_t count) const;
+
+        /**
+         * @brief The ARMv8 Crypto Extensions implementation of TransformBlocks
+         */
+        void TransformBlocksHardware(u8 *destination, const u8 *source, u64 block, size_t count) const;
+
+        /**
+         * @brief The mbedtls implementation of TransformBlocks
+         */
+        void TransformBlocksSoftware(u8 *destination, const u8 *source, u64 block, size_t count) const;
+
+      public:
+        /**
+         * @param key The 128-bit AES key
+         * @param ctr The counter corresponding to the block at offset 0, the lower 64 bits are incremented as a big-endian integer for subsequent blocks
+         */
+        AesCtrCipher(const Block &key, const Block &ctr);
+
+        AesCtrCipher(const AesCtrCipher &) = delete;
+
+        AesCtrCipher &operator=(const AesCtrCipher &) = delete;
+
+        ~AesCtrCipher();
+
+        /**
+         * @brief Decrypts the supplied buffer into the destination buffer, as CTR is symmetric this can be used for encryption too
+         * @param offset The byte offset of the data relative to the initial counter, this doesn't need to be block-aligned
+         * @note The destination and source buffers can be the same
+         */
+        void Decrypt(u8 *destination, const u8 *source, size_t size, size_t offset) const;
+
+        /**
+         * @brief Decrypts the supplied data in-place
+         */
+        void Decrypt(span<u8> data, size_t offset) const {
+            Decrypt(data.data(), data.data(), data.size(), offset);
+        }
+    };
+}
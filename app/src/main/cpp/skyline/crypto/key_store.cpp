@@ -39,6 +39,7 @@ namespace skyline::crypto {
     }
 
     void KeyStore::PopulateTitleKey(Key128 keyName, Key128 value) {
+        std::unique_lock lock(titleKeyMutex);
         if (!titleKeys.contains(keyName))
             titleKeys.emplace(keyName, value);
     }
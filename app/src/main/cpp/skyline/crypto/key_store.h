@@ -25,6 +25,7 @@ namespace skyline::crypto {
         IndexedKeys128 areaKeyOcean;
         IndexedKeys128 areaKeySystem;
       private:
+        std::shared_mutex titleKeyMutex; //!< Synchronizes access to titleKeys as tickets may be populated while other threads look up keys
         std::map<Key128, Key128> titleKeys;
 
         std::unordered_map<std::string_view, std::optional<Key256> &> key256Names{
@@ -48,6 +49,7 @@ namespace skyline::crypto {
 
       public:
         std::optional<Key128> GetTitleKey(const Key128 &title) {
+            std::shared_lock lock(titleKeyMutex);
             auto it{titleKeys.find(title)};
             if (it == titleKeys.end())
                 return std::nullopt;
@@ -56,6 +58,7 @@ namespace skyline::crypto {
 
         /**
          * @note Any title keys which are already in the store will not have their values updated
+         * @note This is thread-safe so a single KeyStore can be shared by concurrent loaders
          */
         void PopulateTitleKey(Key128 keyName, Key128 value);
     };
@@ -119,10 +119,15 @@ namespace skyline::gpu {
         return std::move(vk::raii::PhysicalDevices(instance).front()); // We just select the first device as we aren't expecting multiple GPUs
     }
 
-    vk::raii::Device GPU::CreateDevice(const vk::raii::PhysicalDevice &physicalDevice, typeof(vk::DeviceQueueCreateInfo::queueCount) &vkQueueFamilyIndex) {
+    vk::raii::Device GPU::CreateDevice(const vk::raii::PhysicalDevice &physicalDevice, typeof(vk::DeviceQueueCreateInfo::queueCount) &vkQueueFamilyIndex, bool &timelineSemaphoreSupported, bool &bcnSupported) {
         auto properties{physicalDevice.getProperties()}; // We should check for required properties here, if/when we have them
 
-        // auto features{physicalDevice.getFeatures()}; // Same as above
+        // BCn support is optional as guest BCn textures are decoded on the CPU when it isn't present, this is common on mobile GPUs
+        auto features{physicalDevice.getFeatures()};
+        bcnSupported = features.textureCompressionBC;
+        vk::PhysicalDeviceFeatures enabledFeatures{
+            .textureCompressionBC = bcnSupported,
+        };
 
         constexpr std::array<const char *, 1> requiredDeviceExtensions{
             VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -135,6 +140,18 @@ namespace skyline::gpu {
                 throw exception("Cannot find Vulkan device extension: \"{}\"", requiredExtension);
         }
 
+        std::vector<const char *> enabledDeviceExtensions(requiredDeviceExtensions.begin(), requiredDeviceExtensions.end());
+
+        // Timeline semaphores allow the command scheduler to batch submissions, they're optional as a fence per command buffer is used otherwise
+        vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures{};
+        timelineSemaphoreSupported = std::any_of(deviceExtensions.begin(), deviceExtensions.end(), [&](const vk::ExtensionProperties &deviceExtension) {
+            return std::string_view(deviceExtension.extensionName) == std::string_view(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+        }) && physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceTimelineSemaphoreFeatures>().get<vk::PhysicalDeviceTimelineSemaphoreFeatures>().timelineSemaphore;
+        if (timelineSemaphoreSupported) {
+            enabledDeviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+            timelineSemaphoreFeatures.timelineSemaphore = true;
+        }
+
         auto queueFamilies{physicalDevice.getQueueFamilyProperties()};
         float queuePriority{1.0f}; //!< The priority of the only queue we use, it's set to the maximum of 1.0
         vk::DeviceQueueCreateInfo queue{[&] {
@@ -167,12 +184,14 @@ namespace skyline::gpu {
         }
 
         return vk::raii::Device(physicalDevice, vk::DeviceCreateInfo{
+            .pNext = timelineSemaphoreSupported ? &timelineSemaphoreFeatures : nullptr,
             .queueCreateInfoCount = 1,
             .pQueueCreateInfos = &queue,
-            .enabledExtensionCount = requiredDeviceExtensions.size(),
-            .ppEnabledExtensionNames = requiredDeviceExtensions.data(),
+            .enabledExtensionCount = static_cast<u32>(enabledDeviceExtensions.size()),
+            .ppEnabledExtensionNames = enabledDeviceExtensions.data(),
+            .pEnabledFeatures = &enabledFeatures,
         });
     }
 
-    GPU::GPU(const DeviceState &state) : vkInstance(CreateInstance(state, vkContext)), vkDebugReportCallback(CreateDebugReportCallback(vkInstance)), vkPhysicalDevice(CreatePhysicalDevice(vkInstance)), vkDevice(CreateDevice(vkPhysicalDevice, vkQueueFamilyIndex)), vkQueue(vkDevice, vkQueueFamilyIndex, 0), memory(*this), scheduler(*this), presentation(state, *this), texture(*this) {}
+    GPU::GPU(const DeviceState &state) : vkInstance(CreateInstance(state, vkContext)), vkDebugReportCallback(CreateDebugReportCallback(vkInstance)), vkPhysicalDevice(CreatePhysicalDevice(vkInstance)), vkDevice(CreateDevice(vkPhysicalDevice, vkQueueFamilyIndex, timelineSemaphoreSupported, bcnSupported)), vkQueue(vkDevice, vkQueueFamilyIndex, 0), memory(*this), scheduler(*this), presentation(state, *this), texture(*this) {}
 }
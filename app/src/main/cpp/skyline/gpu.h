@@ -22,7 +22,11 @@ namespace skyline::gpu {
 
         static vk::raii::PhysicalDevice CreatePhysicalDevice(const vk::raii::Instance &instance);
 
-        static vk::raii::Device CreateDevice(const vk::raii::PhysicalDevice &physicalDevice, typeof(vk::DeviceQueueCreateInfo::queueCount)& queueConfiguration);
+        /**
+         * @param timelineSemaphoreSupported Set to whether VK_KHR_timeline_semaphore is supported and was enabled on the device
+         * @param bcnSupported Set to whether BCn textures can be sampled on the device (textureCompressionBC) and the feature was enabled
+         */
+        static vk::raii::Device CreateDevice(const vk::raii::PhysicalDevice &physicalDevice, typeof(vk::DeviceQueueCreateInfo::queueCount)& queueConfiguration, bool &timelineSemaphoreSupported, bool &bcnSupported);
 
       public:
         static constexpr u32 VkApiVersion{VK_API_VERSION_1_1}; //!< The version of core Vulkan that we require
@@ -32,6 +36,8 @@ namespace skyline::gpu {
         vk::raii::DebugReportCallbackEXT vkDebugReportCallback; //!< An RAII Vulkan debug report manager which calls into 'GPU::DebugCallback'
         vk::raii::PhysicalDevice vkPhysicalDevice;
         u32 vkQueueFamilyIndex{};
+        bool timelineSemaphoreSupported{}; //!< If timeline semaphores (VK_KHR_timeline_semaphore) can be used on the device
+        bool bcnSupported{}; //!< If BCn textures can be used on the device, they're decoded into RGBA8 on the CPU otherwise
         vk::raii::Device vkDevice;
         std::mutex queueMutex; //!< Synchronizes access to the queue as it is externally synchronized
         vk::raii::Queue vkQueue; //!< A Vulkan Queue supporting graphics and compute operations
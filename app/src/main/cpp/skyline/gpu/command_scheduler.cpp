@@ -5,39 +5,62 @@
 #include "command_scheduler.h"
 
 namespace skyline::gpu {
-    CommandScheduler::CommandBufferSlot::CommandBufferSlot(vk::raii::Device &device, vk::CommandBuffer commandBuffer, vk::raii::CommandPool &pool)
+    CommandScheduler::CommandBufferSlot::CommandBufferSlot(vk::raii::Device &device, vk::CommandBuffer commandBuffer, vk::raii::CommandPool &pool, vk::Semaphore timelineSemaphore)
         : device(device),
           commandBuffer(device, commandBuffer, pool),
-          fence(device, vk::FenceCreateInfo{}),
-          cycle(std::make_shared<FenceCycle>(device, *fence)) {}
-
-    bool CommandScheduler::CommandBufferSlot::AllocateIfFree(CommandScheduler::CommandBufferSlot &slot) {
-        if (!slot.active.test_and_set(std::memory_order_acq_rel)) {
-            if (slot.cycle->Poll()) {
-                slot.commandBuffer.reset();
-                slot.cycle = std::make_shared<FenceCycle>(slot.device, *slot.fence);
-                return true;
-            } else {
-                slot.active.clear(std::memory_order_release);
-            }
-        }
-        return false;
+          fence(timelineSemaphore ? vk::raii::Fence(nullptr) : vk::raii::Fence(device, vk::FenceCreateInfo{})),
+          timelineSemaphore(timelineSemaphore),
+          cycle(CreateCycle()) {}
+
+    std::shared_ptr<FenceCycle> CommandScheduler::CommandBufferSlot::CreateCycle() {
+        if (timelineSemaphore)
+            return std::make_shared<FenceCycle>(device, timelineSemaphore);
+        return std::make_shared<FenceCycle>(device, *fence);
     }
 
-    CommandScheduler::CommandScheduler(GPU &pGpu) : gpu(pGpu), pool(std::ref(pGpu.vkDevice), vk::CommandPoolCreateInfo{
-        .flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-        .queueFamilyIndex = pGpu.vkQueueFamilyIndex,
-    }) {}
+    void CommandScheduler::CommandBufferSlot::Reset() {
+        commandBuffer.reset();
+        cycle = CreateCycle();
+    }
+
+    CommandScheduler::CommandScheduler(GPU &pGpu)
+        : gpu(pGpu),
+          timelineSemaphore([&]() {
+              if (!pGpu.timelineSemaphoreSupported)
+                  return vk::raii::Semaphore(nullptr);
+
+              vk::SemaphoreTypeCreateInfo semaphoreType{
+                  .semaphoreType = vk::SemaphoreType::eTimeline,
+                  .initialValue = 0,
+              };
+              return vk::raii::Semaphore(pGpu.vkDevice, vk::SemaphoreCreateInfo{
+                  .pNext = &semaphoreType,
+              });
+          }()),
+          pool(std::ref(pGpu.vkDevice), vk::CommandPoolCreateInfo{
+              .flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+              .queueFamilyIndex = pGpu.vkQueueFamilyIndex,
+          }) {}
 
     CommandScheduler::ActiveCommandBuffer CommandScheduler::AllocateCommandBuffer() {
-        auto slot{std::find_if(pool->buffers.begin(), pool->buffers.end(), CommandBufferSlot::AllocateIfFree)};
-        auto slotId{std::distance(pool->buffers.begin(), slot)};
-        if (slot != pool->buffers.end())
-            return ActiveCommandBuffer(*slot);
+        auto &threadPool{*pool};
+
+        // Submissions from a single thread complete in order, so only the oldest in-flight slots need to be polled
+        while (!threadPool.inflightSlots.empty() && threadPool.inflightSlots.front()->cycle->Poll()) {
+            threadPool.freeSlots.push_back(threadPool.inflightSlots.front());
+            threadPool.inflightSlots.pop_front();
+        }
+
+        if (!threadPool.freeSlots.empty()) {
+            auto slot{threadPool.freeSlots.back()};
+            threadPool.freeSlots.pop_back();
+            slot->Reset();
+            return ActiveCommandBuffer(threadPool, *slot);
+        }
 
         vk::CommandBuffer commandBuffer;
         vk::CommandBufferAllocateInfo commandBufferAllocateInfo{
-            .commandPool = *pool->vkCommandPool,
+            .commandPool = *threadPool.vkCommandPool,
             .level = vk::CommandBufferLevel::ePrimary,
             .commandBufferCount = 1,
         };
@@ -45,14 +68,84 @@ namespace skyline::gpu {
         auto result{(*gpu.vkDevice).allocateCommandBuffers(&commandBufferAllocateInfo, &commandBuffer, *gpu.vkDevice.getDispatcher())};
         if (result != vk::Result::eSuccess)
             vk::throwResultException(result, __builtin_FUNCTION());
-        return ActiveCommandBuffer(pool->buffers.emplace_back(gpu.vkDevice, commandBuffer, pool->vkCommandPool));
+        return ActiveCommandBuffer(threadPool, threadPool.buffers.emplace_back(gpu.vkDevice, commandBuffer, threadPool.vkCommandPool, *timelineSemaphore));
     }
 
-    void CommandScheduler::SubmitCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, vk::Fence fence) {
-        std::scoped_lock lock(gpu.queueMutex);
-        gpu.vkQueue.submit(vk::SubmitInfo{
-            .commandBufferCount = 1,
-            .pCommandBuffers = &*commandBuffer,
-        }, fence);
+    void CommandScheduler::SubmitPending() {
+        {
+            std::scoped_lock lock(pendingMutex);
+            submissionBatch.swap(pendingSubmissions);
+        }
+
+        if (*timelineSemaphore) {
+            // Every command buffer signals its own value on the timeline semaphore, this allows the entire batch to be submitted at once
+            vk::Semaphore semaphore{*timelineSemaphore};
+            submitInfos.resize(submissionBatch.size());
+            timelineSubmitInfos.resize(submissionBatch.size());
+            for (size_t index{}; index < submissionBatch.size(); index++) {
+                auto &submission{*submissionBatch[index]};
+                submission.timelineValue = ++timelineValue;
+                submission.slot.cycle->value.store(submission.timelineValue, std::memory_order_release);
+
+                timelineSubmitInfos[index] = vk::TimelineSemaphoreSubmitInfo{
+                    .signalSemaphoreValueCount = 1,
+                    .pSignalSemaphoreValues = &submission.timelineValue,
+                };
+                submitInfos[index] = vk::SubmitInfo{
+                    .pNext = &timelineSubmitInfos[index],
+                    .commandBufferCount = 1,
+                    .pCommandBuffers = &*submission.slot.commandBuffer,
+                    .signalSemaphoreCount = 1,
+                    .pSignalSemaphores = &semaphore,
+                };
+            }
+
+            try {
+                gpu.vkQueue.submit(submitInfos, {});
+            } catch (...) {
+                for (auto submission : submissionBatch)
+                    submission->exception = std::current_exception();
+            }
+            submits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // A vkQueueSubmit call can only signal a single fence, so every command buffer requires its own submit
+            for (auto submission : submissionBatch) {
+                try {
+                    gpu.vkQueue.submit(vk::SubmitInfo{
+                        .commandBufferCount = 1,
+                        .pCommandBuffers = &*submission->slot.commandBuffer,
+                    }, *submission->slot.fence);
+                } catch (...) {
+                    submission->exception = std::current_exception();
+                }
+            }
+            submits.fetch_add(submissionBatch.size(), std::memory_order_relaxed);
+        }
+
+        submittedCommandBuffers.fetch_add(submissionBatch.size(), std::memory_order_relaxed);
+        for (auto submission : submissionBatch)
+            submission->submitted = true;
+        submissionBatch.clear();
+    }
+
+    void CommandScheduler::SubmitCommandBuffer(ActiveCommandBuffer &commandBuffer) {
+        PendingSubmission submission{commandBuffer.slot};
+        {
+            std::scoped_lock lock(pendingMutex);
+            pendingSubmissions.push_back(&submission);
+        }
+
+        {
+            std::scoped_lock lock(gpu.queueMutex);
+            // If another thread held the queue lock while we were queued, it will have submitted our command buffer alongside its own
+            if (!submission.submitted) {
+                auto lockTime{util::GetTimeNs()};
+                SubmitPending();
+                queueLockHoldNs.fetch_add(static_cast<u64>(util::GetTimeNs() - lockTime), std::memory_order_relaxed);
+            }
+        }
+
+        if (submission.exception)
+            std::rethrow_exception(submission.exception);
     }
 }
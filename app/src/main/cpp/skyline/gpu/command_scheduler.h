@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <common/thread_local.h>
 #include "fence_cycle.h"
 
@@ -11,24 +12,53 @@ namespace skyline::gpu {
      * @brief The allocation and synchronized submission of command buffers to the host GPU is handled by this class
      */
     class CommandScheduler {
+      public:
+        /**
+         * @brief Counters for evaluating the cost of submissions to the GPU queue
+         */
+        struct Statistics {
+            u64 submits; //!< The amount of vkQueueSubmit calls made
+            u64 commandBuffers; //!< The amount of command buffers submitted, this is larger than the amount of submits when submissions are batched
+            u64 queueLockHoldNs; //!< The cumulative time that GPU::queueMutex was held for submitting command buffers in nanoseconds
+        };
+
       private:
         /**
-         * @brief A wrapper around a command buffer which tracks its state to avoid concurrent usage
+         * @brief A wrapper around a command buffer which tracks the completion of its latest submission
          */
         struct CommandBufferSlot {
-            std::atomic_flag active{true}; //!< If the command buffer is currently being recorded to
             const vk::raii::Device &device;
             vk::raii::CommandBuffer commandBuffer;
-            vk::raii::Fence fence; //!< A fence used for tracking all submits of a buffer
+            vk::raii::Fence fence; //!< A fence used for tracking all submits of a buffer, this is only used when timeline semaphores are unsupported
+            vk::Semaphore timelineSemaphore; //!< The timeline semaphore of the scheduler, this is null when fences are used
             std::shared_ptr<FenceCycle> cycle; //!< The latest cycle on the fence, all waits must be performed through this
 
-            CommandBufferSlot(vk::raii::Device &device, vk::CommandBuffer commandBuffer, vk::raii::CommandPool &pool);
+            CommandBufferSlot(vk::raii::Device &device, vk::CommandBuffer commandBuffer, vk::raii::CommandPool &pool, vk::Semaphore timelineSemaphore);
 
             /**
-             * @brief Attempts to allocate the buffer if it is free (Not being recorded/executing)
-             * @return If the allocation was successful or not
+             * @return A new cycle for the next submission of the command buffer
              */
-            static bool AllocateIfFree(CommandBufferSlot &slot);
+            std::shared_ptr<FenceCycle> CreateCycle();
+
+            /**
+             * @brief Resets the command buffer and starts a new cycle for it
+             * @note This must only be called after the prior cycle has been signalled
+             */
+            void Reset();
+        };
+
+        /**
+         * @brief A command pool designed to be thread-local to respect external synchronization for all command buffers and the associated pool
+         * @note If we utilized a single global pool there would need to be a mutex around command buffer recording which would incur significant costs
+         */
+        struct CommandPool {
+            vk::raii::CommandPool vkCommandPool;
+            std::list<CommandBufferSlot> buffers; //!< The storage for all slots allocated from this pool, slots are never freed so pointers to them are stable
+            std::vector<CommandBufferSlot *> freeSlots; //!< Slots which aren't being recorded to and whose last cycle has been signalled
+            std::deque<CommandBufferSlot *> inflightSlots; //!< Slots that were released after being submitted in the order of submission, they're moved to the free-list once their cycle is signalled
+
+            template<typename... Args>
+            constexpr CommandPool(Args &&... args) : vkCommandPool(std::forward<Args>(args)...) {}
         };
 
         /**
@@ -36,17 +66,18 @@ namespace skyline::gpu {
          */
         class ActiveCommandBuffer {
           private:
+            CommandPool &pool;
             CommandBufferSlot &slot;
 
+            friend CommandScheduler;
+
           public:
-            constexpr ActiveCommandBuffer(CommandBufferSlot &slot) : slot(slot) {}
+            constexpr ActiveCommandBuffer(CommandPool &pool, CommandBufferSlot &slot) : pool(pool), slot(slot) {}
 
-            ~ActiveCommandBuffer() {
-                slot.active.clear(std::memory_order_release);
-            }
+            ActiveCommandBuffer(const ActiveCommandBuffer &) = delete;
 
-            vk::Fence GetFence() {
-                return *slot.fence;
+            ~ActiveCommandBuffer() {
+                pool.inflightSlots.push_back(&slot);
             }
 
             std::shared_ptr<FenceCycle> GetFenceCycle() {
@@ -62,30 +93,45 @@ namespace skyline::gpu {
             }
         };
 
-        GPU &gpu;
-
         /**
-         * @brief A command pool designed to be thread-local to respect external synchronization for all command buffers and the associated pool
-         * @note If we utilized a single global pool there would need to be a mutex around command buffer recording which would incur significant costs
+         * @brief A command buffer which is waiting to be submitted to the GPU queue, it's owned by the thread which recorded it
          */
-        struct CommandPool {
-            vk::raii::CommandPool vkCommandPool;
-            std::list<CommandBufferSlot> buffers;
-
-            template<typename... Args>
-            constexpr CommandPool(Args &&... args) : vkCommandPool(std::forward<Args>(args)...) {}
+        struct PendingSubmission {
+            CommandBufferSlot &slot;
+            u64 timelineValue{}; //!< The value the timeline semaphore is signalled to on completion of this submission
+            bool submitted{}; //!< If the command buffer has been submitted to the queue, this is protected by GPU::queueMutex
+            std::exception_ptr exception; //!< An exception which occurred while submitting the command buffer, it's rethrown on the owning thread
         };
+
+        GPU &gpu;
+        vk::raii::Semaphore timelineSemaphore; //!< A timeline semaphore signalled with a monotonically increasing value for every submission, this is null when it's unsupported by the device
+        u64 timelineValue{}; //!< The last value assigned to a submission on the timeline semaphore, this is protected by GPU::queueMutex
         ThreadLocal<CommandPool> pool;
 
+        std::mutex pendingMutex; //!< Synchronizes access to the pending submissions
+        std::vector<PendingSubmission *> pendingSubmissions; //!< Submissions which have been queued by any thread but haven't been submitted yet
+        std::vector<PendingSubmission *> submissionBatch; //!< The batch of submissions currently being submitted, this is protected by GPU::queueMutex
+        std::vector<vk::SubmitInfo> submitInfos; //!< A reused buffer for the submit structures of a batch, this is protected by GPU::queueMutex
+        std::vector<vk::TimelineSemaphoreSubmitInfo> timelineSubmitInfos; //!< A reused buffer for the timeline semaphore values of a batch, this is protected by GPU::queueMutex
+
+        std::atomic<u64> submits{}, submittedCommandBuffers{}, queueLockHoldNs{};
+
         /**
-         * @brief Allocates an existing or new primary command buffer from the pool
+         * @brief Allocates a free or new primary command buffer from the pool
          */
         ActiveCommandBuffer AllocateCommandBuffer();
 
         /**
-         * @brief Submits a single command buffer to the GPU queue with an optional fence
+         * @brief Submits all pending submissions from any thread to the GPU queue in as few vkQueueSubmit calls as possible
+         * @note GPU::queueMutex **must** be locked prior to calling this
          */
-        void SubmitCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, vk::Fence fence = {});
+        void SubmitPending();
+
+        /**
+         * @brief Queues a command buffer for submission and returns after it has been submitted to the GPU queue
+         * @note Any submissions queued by other threads are coalesced into the same vkQueueSubmit call, this avoids every thread contending on the queue lock to submit a single command buffer
+         */
+        void SubmitCommandBuffer(ActiveCommandBuffer &commandBuffer);
 
       public:
         CommandScheduler(GPU &gpu);
@@ -102,7 +148,7 @@ namespace skyline::gpu {
                 });
                 recordFunction(*commandBuffer);
                 commandBuffer->end();
-                SubmitCommandBuffer(*commandBuffer, commandBuffer.GetFence());
+                SubmitCommandBuffer(commandBuffer);
                 return commandBuffer.GetFenceCycle();
             } catch (...) {
                 commandBuffer.GetFenceCycle()->Cancel();
@@ -122,12 +168,19 @@ namespace skyline::gpu {
                 });
                 recordFunction(*commandBuffer, commandBuffer.GetFenceCycle());
                 commandBuffer->end();
-                SubmitCommandBuffer(*commandBuffer, commandBuffer.GetFence());
+                SubmitCommandBuffer(commandBuffer);
                 return commandBuffer.GetFenceCycle();
             } catch (...) {
                 commandBuffer.GetFenceCycle()->Cancel();
                 std::rethrow_exception(std::current_exception());
             }
         }
+
+        /**
+         * @return A snapshot of the submission counters
+         */
+        Statistics GetStatistics() const {
+            return {submits.load(std::memory_order_relaxed), submittedCommandBuffers.load(std::memory_order_relaxed), queueLockHoldNs.load(std::memory_order_relaxed)};
+        }
     };
 }
@@ -9,6 +9,7 @@
 
 namespace skyline::gpu {
     struct FenceCycle;
+    class CommandScheduler;
 
     /**
      * @brief Any object whose lifetime can be attached to a fence cycle needs to inherit this class
@@ -20,7 +21,7 @@ namespace skyline::gpu {
     };
 
     /**
-     * @brief A wrapper around a Vulkan Fence which only tracks a single reset -> signal cycle with the ability to attach lifetimes of objects to it
+     * @brief A wrapper around a Vulkan Fence or a value of a timeline semaphore which only tracks a single reset -> signal cycle with the ability to attach lifetimes of objects to it
      * @note This provides the guarantee that the fence must be signalled prior to destruction when objects are to be destroyed
      * @note All waits to the fence **must** be done through the same instance of this, the state of the fence changing externally will lead to UB
      */
@@ -28,9 +29,14 @@ namespace skyline::gpu {
       private:
         std::atomic_flag signalled;
         const vk::raii::Device &device;
-        vk::Fence fence;
+        vk::Fence fence; //!< The fence signalled on completion, this is null if a timeline semaphore is used instead
+        vk::Semaphore semaphore; //!< The timeline semaphore which reaches the value on completion, this is null if a fence is used instead
+        static constexpr u64 UnsubmittedValue{std::numeric_limits<u64>::max()}; //!< The timeline value of a cycle which hasn't been submitted yet, the semaphore can never reach it so an unsubmitted cycle is never considered signalled
+        std::atomic<u64> value{UnsubmittedValue}; //!< The value of the timeline semaphore which signals this cycle, it's assigned by the CommandScheduler at submission
         std::shared_ptr<FenceCycleDependency> list;
 
+        friend CommandScheduler;
+
         /**
          * @brief Sequentially iterate through the shared_ptr linked list of dependencies and reset all pointers in a thread-safe atomic manner
          * @note We cannot simply nullify the base pointer of the list as a false dependency chain is maintained between the objects when retained exteranlly
@@ -44,11 +50,58 @@ namespace skyline::gpu {
             }
         }
 
+        /**
+         * @brief Waits on the underlying fence or timeline semaphore value with a timeout in nanoseconds
+         * @return If the wait was successful or timed out
+         */
+        bool WaitUnderlying(u64 timeout) {
+            if (semaphore) {
+                // The value is only known after submission, waiting on it prior would never complete so we wait for the cycle to be submitted first
+                u64 waitValue{value.load(std::memory_order_acquire)};
+                if (waitValue == UnsubmittedValue) {
+                    bool infinite{timeout == std::numeric_limits<u64>::max()};
+                    auto deadline{std::chrono::steady_clock::now() + std::chrono::nanoseconds(infinite ? 0 : static_cast<i64>(timeout))};
+                    while ((waitValue = value.load(std::memory_order_acquire)) == UnsubmittedValue) {
+                        if (!infinite && std::chrono::steady_clock::now() >= deadline)
+                            return false;
+                        std::this_thread::yield();
+                    }
+
+                    if (!infinite)
+                        timeout = static_cast<u64>(std::max<i64>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count(), 0));
+                }
+
+                vk::SemaphoreWaitInfo waitInfo{
+                    .semaphoreCount = 1,
+                    .pSemaphores = &semaphore,
+                    .pValues = &waitValue,
+                };
+                return device.waitSemaphoresKHR(waitInfo, timeout) == vk::Result::eSuccess;
+            }
+            return device.waitForFences(fence, false, timeout) == vk::Result::eSuccess;
+        }
+
+        /**
+         * @return If the underlying fence or timeline semaphore value is currently signalled
+         */
+        bool PollUnderlying() {
+            if (semaphore) {
+                u64 pollValue{value.load(std::memory_order_acquire)};
+                return pollValue != UnsubmittedValue && (*device).getSemaphoreCounterValueKHR(semaphore, *device.getDispatcher()) >= pollValue;
+            }
+            return (*device).getFenceStatus(fence, *device.getDispatcher()) == vk::Result::eSuccess;
+        }
+
       public:
         FenceCycle(const vk::raii::Device &device, vk::Fence fence) : signalled(false), device(device), fence(fence) {
             device.resetFences(fence);
         }
 
+        /**
+         * @note The semaphore value is only assigned at submission, prior to that the cycle is never signalled and a wait blocks until it has been submitted and completed
+         */
+        FenceCycle(const vk::raii::Device &device, vk::Semaphore semaphore) : signalled(false), device(device), semaphore(semaphore) {}
+
         ~FenceCycle() {
             Wait();
         }
@@ -67,7 +120,7 @@ namespace skyline::gpu {
         void Wait() {
             if (signalled.test(std::memory_order_consume))
                 return;
-            while (device.waitForFences(fence, false, std::numeric_limits<u64>::max()) != vk::Result::eSuccess);
+            while (!WaitUnderlying(std::numeric_limits<u64>::max()));
             if (!signalled.test_and_set(std::memory_order_release))
                 DestroyDependencies();
         }
@@ -79,7 +132,7 @@ namespace skyline::gpu {
         bool Wait(std::chrono::duration<u64, std::nano> timeout) {
             if (signalled.test(std::memory_order_consume))
                 return true;
-            if (device.waitForFences(fence, false, timeout.count()) == vk::Result::eSuccess) {
+            if (WaitUnderlying(timeout.count())) {
                 if (!signalled.test_and_set(std::memory_order_release))
                     DestroyDependencies();
                 return true;
@@ -94,8 +147,7 @@ namespace skyline::gpu {
         bool Poll() {
             if (signalled.test(std::memory_order_consume))
                 return true;
-            auto status{(*device).getFenceStatus(fence, *device.getDispatcher())};
-            if (status == vk::Result::eSuccess) {
+            if (PollUnderlying()) {
                 if (!signalled.test_and_set(std::memory_order_release))
                     DestroyDependencies();
                 return true;
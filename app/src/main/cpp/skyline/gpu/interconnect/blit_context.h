@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <gpu/texture/copy.h>
+#include <soc/gm20b/engines/fermi/types.h>
+#include "graphics_context.h"
+#include "surface_accessor.h"
+
+namespace skyline::gpu::interconnect {
+    namespace fermi2d = soc::gm20b::engine::fermi2d::type;
+
+    /**
+     * @brief Host-equivalent context for blits performed by the Fermi 2D engine on the guest
+     * @note This class is **NOT** thread-safe and should not be utilized by multiple threads concurrently
+     */
+    class BlitContext {
+      private:
+        GPU &gpu;
+        soc::gm20b::ChannelContext &channelCtx;
+        gpu::interconnect::CommandExecutor &executor;
+        std::vector<u8> srcLine; //!< A single line of pixels read from the source surface
+        std::vector<u8> dstLine; //!< A single line of pixels to be written to the destination surface
+
+        static BlockLinearLayout GetBlockLinearLayout(const fermi2d::Surface &surface, texture::Format format) {
+            return BlockLinearLayout{
+                .widthBytes = surface.width * format->bpb,
+                .height = surface.height,
+                .depth = std::max(surface.depth, 1U),
+                .blockHeight = 1U << surface.blockSize.heightLog2,
+                .blockDepth = 1U << surface.blockSize.depthLog2,
+            };
+        }
+
+        /**
+         * @return The size of the surface in guest memory in bytes
+         */
+        static size_t GetSurfaceSize(const fermi2d::Surface &surface, texture::Format format) {
+            if (surface.memoryLayout == fermi2d::Surface::MemoryLayout::Pitch)
+                return static_cast<size_t>(surface.pitch) * surface.height;
+            else
+                return GetBlockLinearLayout(surface, format).GetSize();
+        }
+
+        /**
+         * @return A guest texture describing the surface in the same way as the 3D engine would describe a render target with the same parameters, this allows matching against textures created from render targets
+         */
+        GuestTexture GetGuestTexture(fermi2d::Surface surface, texture::Format format) {
+            GuestTexture guest;
+            guest.format = format;
+            guest.type = texture::TextureType::e2D;
+            guest.layerCount = 1;
+
+            if (surface.memoryLayout == fermi2d::Surface::MemoryLayout::Pitch) {
+                // Linear render targets are sized by their pitch rather than their width
+                guest.dimensions = texture::Dimensions(surface.pitch / format->bpb, surface.height, 1);
+                guest.tileConfig = texture::TileConfig{.mode = texture::TileMode::Linear};
+            } else {
+                guest.dimensions = texture::Dimensions(surface.width, surface.height, 1);
+                guest.tileConfig = texture::TileConfig{
+                    .mode = texture::TileMode::Block,
+                    .blockHeight = static_cast<u8>(1U << surface.blockSize.heightLog2),
+                    .blockDepth = static_cast<u8>(1U << surface.blockSize.depthLog2),
+                };
+            }
+
+            channelCtx.asCtx->gmmu.TranslateRange(surface.address.Pack(), format->GetSize(guest.dimensions), [&](span<u8> mapping) {
+                guest.mappings.push_back(mapping);
+            });
+            return guest;
+        }
+
+        /**
+         * @return A CPU-accessible view of the surface, this accesses guest memory through the GMMU if the surface isn't contiguous in host memory (split across mappings, sparse or partially unmapped)
+         */
+        SurfaceAccessor GetSurfaceAccessor(fermi2d::Surface surface, texture::Format format) {
+            auto &gmmu{channelCtx.asCtx->gmmu};
+            u64 address{surface.address.Pack()};
+
+            return SurfaceAccessor{
+                .base = gmmu.TranslateContiguous(address, GetSurfaceSize(surface, format)),
+                .gmmu = gmmu,
+                .address = address,
+                .blockLinear = surface.memoryLayout == fermi2d::Surface::MemoryLayout::BlockLinear,
+                .layout = GetBlockLinearLayout(surface, format),
+                .pitch = surface.pitch,
+                .layer = surface.layer,
+            };
+        }
+
+        /**
+         * @brief Performs the blit on the host GPU with vkCmdCopyImage or vkCmdBlitImage
+         */
+        void BlitOnHost(const TextureView &srcView, const TextureView &dstView, std::array<vk::Offset3D, 2> srcOffsets, std::array<vk::Offset3D, 2> dstOffsets, bool copy, vk::Filter filter) {
+            auto srcTexture{srcView.backing}, dstTexture{dstView.backing};
+
+            // The source rectangle is clamped to the source texture as offsets outside of it are invalid in Vulkan, this matches the edge clamping of the CPU blit
+            for (auto &offset : srcOffsets) {
+                offset.x = std::clamp<i32>(offset.x, 0, static_cast<i32>(srcTexture->dimensions.width));
+                offset.y = std::clamp<i32>(offset.y, 0, static_cast<i32>(srcTexture->dimensions.height));
+            }
+            if (srcOffsets[0].x == srcOffsets[1].x || srcOffsets[0].y == srcOffsets[1].y)
+                return;
+
+            // Copies have a single extent for both images, the rectangle is shrunk to the part of it which is inside the source
+            vk::Extent3D copyExtent{
+                static_cast<u32>(std::min(dstOffsets[1].x - dstOffsets[0].x, srcOffsets[1].x - srcOffsets[0].x)),
+                static_cast<u32>(std::min(dstOffsets[1].y - dstOffsets[0].y, srcOffsets[1].y - srcOffsets[0].y)),
+                1,
+            };
+
+            std::unique_lock srcLock(*srcTexture);
+            std::unique_lock dstLock(*dstTexture, std::defer_lock);
+            if (dstTexture != srcTexture)
+                dstLock.lock();
+
+            // Images can only be transferred from/to in the general and transfer layouts
+            auto isTransferLayout{[](vk::ImageLayout layout, vk::ImageLayout transferLayout) {
+                return layout == vk::ImageLayout::eGeneral || layout == transferLayout;
+            }};
+            if (!isTransferLayout(srcTexture->layout, vk::ImageLayout::eTransferSrcOptimal))
+                srcTexture->TransitionLayout(vk::ImageLayout::eGeneral);
+            if (!isTransferLayout(dstTexture->layout, vk::ImageLayout::eTransferDstOptimal))
+                dstTexture->TransitionLayout(vk::ImageLayout::eGeneral);
+
+            std::array<TextureView, 2> views{srcView, dstView};
+            executor.AddOutsideRpCommand([srcTexture, dstTexture, srcLayout = srcTexture->layout, dstLayout = dstTexture->layout, srcOffsets, dstOffsets, copyExtent, copy, filter](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &) {
+                commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, vk::MemoryBarrier{
+                    .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+                    .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite,
+                }, {}, {});
+
+                vk::ImageSubresourceLayers srcSubresource{
+                    .aspectMask = srcTexture->format->vkAspect,
+                    .layerCount = 1,
+                }, dstSubresource{
+                    .aspectMask = dstTexture->format->vkAspect,
+                    .layerCount = 1,
+                };
+
+                if (copy)
+                    commandBuffer.copyImage(srcTexture->GetBacking(), srcLayout, dstTexture->GetBacking(), dstLayout, vk::ImageCopy{
+                        .srcSubresource = srcSubresource,
+                        .srcOffset = srcOffsets[0],
+                        .dstSubresource = dstSubresource,
+                        .dstOffset = dstOffsets[0],
+                        .extent = copyExtent,
+                    });
+                else
+                    commandBuffer.blitImage(srcTexture->GetBacking(), srcLayout, dstTexture->GetBacking(), dstLayout, vk::ImageBlit{
+                        .srcSubresource = srcSubresource,
+                        .srcOffsets = srcOffsets,
+                        .dstSubresource = dstSubresource,
+                        .dstOffsets = dstOffsets,
+                    }, filter);
+
+                commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, vk::MemoryBarrier{
+                    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                    .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+                }, {}, {});
+            }, views);
+        }
+
+        /**
+         * @brief Performs the blit on the CPU directly on guest memory with point sampling
+         */
+        void BlitOnGuest(const fermi2d::Surface &srcSurface, texture::Format srcFormat, const fermi2d::Surface &dstSurface, texture::Format dstFormat, float srcX, float srcY, u32 dstX, u32 dstY, u32 dstWidth, u32 dstHeight, float duDx, float dvDy) {
+            if (srcFormat->bpb != dstFormat->bpb) {
+                Logger::Warn("Format conversion in 2D blits on the CPU is unsupported: 0x{:X} -> 0x{:X}", static_cast<u32>(srcSurface.format), static_cast<u32>(dstSurface.format));
+                return;
+            }
+
+            // Any pending GPU work must be completed and written back to guest memory prior to it being accessed by the CPU
+            executor.Execute();
+
+            auto src{GetSurfaceAccessor(srcSurface, srcFormat)};
+            auto dst{GetSurfaceAccessor(dstSurface, dstFormat)};
+
+            u32 bpb{srcFormat->bpb};
+            dstLine.resize(static_cast<size_t>(dstWidth) * bpb);
+
+            // Unscaled blits can read the source line directly into the destination line
+            bool unscaledX{duDx == 1.0f && srcX == std::floor(srcX) && srcX >= 0 && static_cast<u32>(srcX) + dstWidth <= srcSurface.width};
+            if (!unscaledX)
+                srcLine.resize(static_cast<size_t>(srcSurface.width) * bpb);
+
+            for (u32 line{}; line < dstHeight; line++) {
+                auto sampleY{static_cast<i64>(std::floor(srcY + (static_cast<float>(line) + 0.5f) * dvDy))};
+                auto y{static_cast<u32>(std::clamp<i64>(sampleY, 0, static_cast<i64>(srcSurface.height) - 1))};
+
+                if (unscaledX) {
+                    src.ReadLine(y, static_cast<u32>(srcX) * bpb, dstLine);
+                } else {
+                    src.ReadLine(y, 0, srcLine);
+                    for (u32 pixel{}; pixel < dstWidth; pixel++) {
+                        auto sampleX{static_cast<i64>(std::floor(srcX + (static_cast<float>(pixel) + 0.5f) * duDx))};
+                        auto x{static_cast<u32>(std::clamp<i64>(sampleX, 0, static_cast<i64>(srcSurface.width) - 1))};
+                        std::memcpy(dstLine.data() + static_cast<size_t>(pixel) * bpb, srcLine.data() + static_cast<size_t>(x) * bpb, bpb);
+                    }
+                }
+
+                dst.WriteLine(dstY + line, dstX * bpb, dstLine);
+            }
+        }
+
+      public:
+        BlitContext(GPU &gpu, soc::gm20b::ChannelContext &channelCtx, gpu::interconnect::CommandExecutor &executor) : gpu(gpu), channelCtx(channelCtx), executor(executor) {}
+
+        /**
+         * @brief Blits a rectangle from the source surface to the destination surface, scaling it if the rectangles differ in size
+         * @param srcX The X coordinate of the source rectangle in pixels, the meaning of this is determined by the origin of the sample mode
+         * @param duDx The amount of source pixels stepped over for every destination pixel on the X axis
+         */
+        void Blit(const fermi2d::Surface &srcSurface, const fermi2d::Surface &dstSurface, float srcX, float srcY, u32 dstX, u32 dstY, u32 dstWidth, u32 dstHeight, float duDx, float dvDy, fermi2d::SampleMode sampleMode) {
+            TRACE_EVENT("gpu", "BlitContext::Blit");
+
+            auto srcFormat{GraphicsContext::GetColorFormat(srcSurface.format)}, dstFormat{GraphicsContext::GetColorFormat(dstSurface.format)};
+            if (!srcFormat || !dstFormat) {
+                Logger::Warn("Unsupported 2D blit surface format: 0x{:X} -> 0x{:X}", static_cast<u32>(srcSurface.format), static_cast<u32>(dstSurface.format));
+                return;
+            }
+
+            auto isLayerInSurface{[](const fermi2d::Surface &surface) {
+                return surface.memoryLayout == fermi2d::Surface::MemoryLayout::Pitch || surface.layer < std::max(surface.depth, 1U);
+            }};
+            if (!isLayerInSurface(srcSurface) || !isLayerInSurface(dstSurface)) {
+                Logger::Warn("2D blit surface layer exceeds its depth: {}/{} -> {}/{}", srcSurface.layer, srcSurface.depth, dstSurface.layer, dstSurface.depth);
+                return;
+            }
+
+            // Clip the destination rectangle to the destination surface
+            if (dstX >= dstSurface.width || dstY >= dstSurface.height)
+                return;
+            dstWidth = std::min(dstWidth, dstSurface.width - dstX);
+            dstHeight = std::min(dstHeight, dstSurface.height - dstY);
+            if (dstWidth == 0 || dstHeight == 0)
+                return;
+
+            // The source coordinates are converted to the top-left corner of the source rectangle, center origins refer to the sample point of the first pixel which is half a step into the rectangle
+            if (sampleMode.origin == fermi2d::SampleMode::Origin::Center) {
+                srcX -= duDx / 2;
+                srcY -= dvDy / 2;
+            }
+
+            auto srcGuest{GetGuestTexture(srcSurface, srcFormat)};
+            auto dstGuest{GetGuestTexture(dstSurface, dstFormat)};
+            if (!srcGuest.mappings.empty() && !dstGuest.mappings.empty()) {
+                auto srcView{gpu.texture.Find(srcGuest)};
+                auto dstView{srcView ? gpu.texture.Find(dstGuest) : std::nullopt};
+                if (srcView && dstView) {
+                    std::array<vk::Offset3D, 2> srcOffsets{
+                        vk::Offset3D{static_cast<i32>(std::round(srcX)), static_cast<i32>(std::round(srcY)), 0},
+                        vk::Offset3D{static_cast<i32>(std::round(srcX + static_cast<float>(dstWidth) * duDx)), static_cast<i32>(std::round(srcY + static_cast<float>(dstHeight) * dvDy)), 1},
+                    }, dstOffsets{
+                        vk::Offset3D{static_cast<i32>(dstX), static_cast<i32>(dstY), 0},
+                        vk::Offset3D{static_cast<i32>(dstX + dstWidth), static_cast<i32>(dstY + dstHeight), 1},
+                    };
+
+                    bool copy{duDx == 1.0f && dvDy == 1.0f && srcFormat == dstFormat && srcX == std::floor(srcX) && srcY == std::floor(srcY)};
+                    BlitOnHost(*srcView, *dstView, srcOffsets, dstOffsets, copy, sampleMode.filter == fermi2d::SampleMode::Filter::Bilinear ? vk::Filter::eLinear : vk::Filter::eNearest);
+                    return;
+                }
+            }
+
+            BlitOnGuest(srcSurface, srcFormat, dstSurface, dstFormat, srcX, srcY, dstX, dstY, dstWidth, dstHeight, duDx, dvDy);
+        }
+    };
+}
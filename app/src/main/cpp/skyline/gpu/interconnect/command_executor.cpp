@@ -65,6 +65,18 @@ namespace skyline::gpu::interconnect {
         }
     }
 
+    void CommandExecutor::AddOutsideRpCommand(const std::function<void(vk::raii::CommandBuffer &, const std::shared_ptr<FenceCycle> &, GPU &)> &function, span<const TextureView> textures) {
+        for (const auto &texture : textures)
+            syncTextures.emplace(texture.backing.get());
+
+        if (renderPass) {
+            nodes.emplace_back(std::in_place_type_t<node::RenderPassEndNode>());
+            renderPass = nullptr;
+        }
+
+        nodes.emplace_back(std::in_place_type_t<node::FunctionNode>(), function);
+    }
+
     void CommandExecutor::Execute() {
         if (!nodes.empty()) {
             TRACE_EVENT("gpu", "CommandExecutor::Execute");
@@ -39,6 +39,13 @@ namespace skyline::gpu::interconnect {
          */
         void AddClearColorSubpass(TextureView attachment, const vk::ClearColorValue& value);
 
+        /**
+         * @brief Adds a command that needs to be executed outside the scope of a render pass, such as a transfer between images
+         * @param textures All textures accessed by the command, these are synchronized with the guest alongside all other textures used in the command stream
+         * @note Any texture supplied to this **must** be locked by the calling thread, it should also undergo no persistent layout transitions till execution
+         */
+        void AddOutsideRpCommand(const std::function<void(vk::raii::CommandBuffer &, const std::shared_ptr<FenceCycle> &, GPU &)> &function, span<const TextureView> textures = {});
+
         /**
          * @brief Execute all the nodes and submit the resulting command buffer to the GPU
          */
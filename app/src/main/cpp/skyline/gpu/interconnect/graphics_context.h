@@ -59,6 +59,69 @@ namespace skyline::gpu::interconnect {
 
         /* Render Targets + Render Target Control */
 
+        /**
+         * @return The host format corresponding to the supplied color format, this is shared with the 2D engine which utilizes the same encoding for its surfaces
+         * @note An invalid format is returned for unsupported formats and ColorFormat::None
+         */
+        static texture::Format GetColorFormat(maxwell3d::RenderTarget::ColorFormat format) {
+            switch (format) {
+                case maxwell3d::RenderTarget::ColorFormat::None:
+                    return {};
+                case maxwell3d::RenderTarget::ColorFormat::R32B32G32A32Float:
+                    return format::R32B32G32A32Float;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Unorm:
+                    return format::R16G16B16A16Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Snorm:
+                    return format::R16G16B16A16Snorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Sint:
+                    return format::R16G16B16A16Sint;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Uint:
+                    return format::R16G16B16A16Uint;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Float:
+                    return format::R16G16B16A16Float;
+                case maxwell3d::RenderTarget::ColorFormat::A2B10G10R10Unorm:
+                    return format::A2B10G10R10Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R8G8B8A8Unorm:
+                    return format::R8G8B8A8Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::A8B8G8R8Srgb:
+                    return format::A8B8G8R8Srgb;
+                case maxwell3d::RenderTarget::ColorFormat::A8B8G8R8Snorm:
+                    return format::A8B8G8R8Snorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16Unorm:
+                    return format::R16G16Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16Snorm:
+                    return format::R16G16Snorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16Sint:
+                    return format::R16G16Sint;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16Uint:
+                    return format::R16G16Uint;
+                case maxwell3d::RenderTarget::ColorFormat::R16G16Float:
+                    return format::R16G16Float;
+                case maxwell3d::RenderTarget::ColorFormat::B10G11R11Float:
+                    return format::B10G11R11Float;
+                case maxwell3d::RenderTarget::ColorFormat::R32Float:
+                    return format::R32Float;
+                case maxwell3d::RenderTarget::ColorFormat::R8G8Unorm:
+                    return format::R8G8Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R8G8Snorm:
+                    return format::R8G8Snorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16Unorm:
+                    return format::R16Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R16Float:
+                    return format::R16Float;
+                case maxwell3d::RenderTarget::ColorFormat::R8Unorm:
+                    return format::R8Unorm;
+                case maxwell3d::RenderTarget::ColorFormat::R8Snorm:
+                    return format::R8Snorm;
+                case maxwell3d::RenderTarget::ColorFormat::R8Sint:
+                    return format::R8Sint;
+                case maxwell3d::RenderTarget::ColorFormat::R8Uint:
+                    return format::R8Uint;
+                default:
+                    return {};
+            }
+        }
+
         void SetRenderTargetAddressHigh(size_t index, u32 high) {
             auto &renderTarget{renderTargets.at(index)};
             renderTarget.gpuAddressHigh = high;
@@ -90,64 +153,9 @@ namespace skyline::gpu::interconnect {
 
         void SetRenderTargetFormat(size_t index, maxwell3d::RenderTarget::ColorFormat format) {
             auto &renderTarget{renderTargets.at(index)};
-            renderTarget.guest.format = [&]() -> texture::Format {
-                switch (format) {
-                    case maxwell3d::RenderTarget::ColorFormat::None:
-                        return {};
-                    case maxwell3d::RenderTarget::ColorFormat::R32B32G32A32Float:
-                        return format::R32B32G32A32Float;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Unorm:
-                        return format::R16G16B16A16Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Snorm:
-                        return format::R16G16B16A16Snorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Sint:
-                        return format::R16G16B16A16Sint;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Uint:
-                        return format::R16G16B16A16Uint;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16B16A16Float:
-                        return format::R16G16B16A16Float;
-                    case maxwell3d::RenderTarget::ColorFormat::A2B10G10R10Unorm:
-                        return format::A2B10G10R10Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R8G8B8A8Unorm:
-                        return format::R8G8B8A8Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::A8B8G8R8Srgb:
-                        return format::A8B8G8R8Srgb;
-                    case maxwell3d::RenderTarget::ColorFormat::A8B8G8R8Snorm:
-                        return format::A8B8G8R8Snorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16Unorm:
-                        return format::R16G16Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16Snorm:
-                        return format::R16G16Snorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16Sint:
-                        return format::R16G16Sint;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16Uint:
-                        return format::R16G16Uint;
-                    case maxwell3d::RenderTarget::ColorFormat::R16G16Float:
-                        return format::R16G16Float;
-                    case maxwell3d::RenderTarget::ColorFormat::B10G11R11Float:
-                        return format::B10G11R11Float;
-                    case maxwell3d::RenderTarget::ColorFormat::R32Float:
-                        return format::R32Float;
-                    case maxwell3d::RenderTarget::ColorFormat::R8G8Unorm:
-                        return format::R8G8Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R8G8Snorm:
-                        return format::R8G8Snorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16Unorm:
-                        return format::R16Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R16Float:
-                        return format::R16Float;
-                    case maxwell3d::RenderTarget::ColorFormat::R8Unorm:
-                        return format::R8Unorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R8Snorm:
-                        return format::R8Snorm;
-                    case maxwell3d::RenderTarget::ColorFormat::R8Sint:
-                        return format::R8Sint;
-                    case maxwell3d::RenderTarget::ColorFormat::R8Uint:
-                        return format::R8Uint;
-                    default:
-                        throw exception("Cannot translate the supplied RT format: 0x{:X}", static_cast<u32>(format));
-                }
-            }();
+            renderTarget.guest.format = GetColorFormat(format);
+            if (!renderTarget.guest.format && format != maxwell3d::RenderTarget::ColorFormat::None)
+                throw exception("Cannot translate the supplied RT format: 0x{:X}", static_cast<u32>(format));
 
             if (renderTarget.guest.tileConfig.mode == texture::TileMode::Linear && renderTarget.guest.format)
                 renderTarget.guest.dimensions.width = renderTarget.widthBytes / renderTarget.guest.format->bpb;
@@ -212,8 +220,9 @@ namespace skyline::gpu::interconnect {
 
             if (renderTarget.guest.mappings.empty()) {
                 auto size{std::max<u64>(renderTarget.guest.layerStride * (renderTarget.guest.layerCount - renderTarget.guest.baseArrayLayer), renderTarget.guest.format->GetSize(renderTarget.guest.dimensions))};
-                auto mappings{channelCtx.asCtx->gmmu.TranslateRange(renderTarget.gpuAddress, size)};
-                renderTarget.guest.mappings.assign(mappings.begin(), mappings.end());
+                channelCtx.asCtx->gmmu.TranslateRange(renderTarget.gpuAddress, size, [&](span<u8> mapping) {
+                    renderTarget.guest.mappings.push_back(mapping);
+                });
             }
 
             renderTarget.guest.type = static_cast<texture::TextureType>(renderTarget.guest.dimensions.GetType());
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <gpu/texture/block_linear.h>
+#include <soc/gm20b/gmmu.h>
+
+namespace skyline::gpu::interconnect {
+    /**
+     * @brief A CPU-accessible view of a surface in guest memory
+     * @note If the surface isn't contiguous in host memory, every line is accessed through the GMMU instead so only the lines and sectors that are actually touched are read or written
+     */
+    struct SurfaceAccessor {
+        u8 *base; //!< A host pointer to the entire surface, this is nullptr if the surface isn't contiguous in host memory
+        soc::gm20b::GMMU &gmmu;
+        u64 address; //!< The GPU VA of the surface
+        bool blockLinear;
+        BlockLinearLayout layout; //!< The layout of the surface if it's block-linear
+        u32 pitch; //!< The pitch of the surface if it's pitch-linear
+        u32 layer;
+
+        /**
+         * @brief Reads or writes a single line of a surface which isn't contiguous in host memory through the GMMU, block-linear lines are split into sector-sized accesses
+         */
+        template<bool Read>
+        void AccessLineGuest(u32 y, u32 xBytes, span<u8> buffer) const {
+            if (!blockLinear) {
+                u64 lineAddress{address + static_cast<u64>(y) * pitch + xBytes};
+                if constexpr (Read)
+                    gmmu.Read(buffer.data(), lineAddress, buffer.size());
+                else
+                    gmmu.Write(lineAddress, buffer.data(), buffer.size());
+                return;
+            }
+
+            ForEachBlockLinearSpan(layout, xBytes, y, layer, static_cast<u32>(buffer.size()), [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                if constexpr (Read)
+                    gmmu.Read(buffer.data() + lineOffset, address + surfaceOffset, size);
+                else
+                    gmmu.Write(address + surfaceOffset, buffer.data() + lineOffset, size);
+            });
+        }
+
+        void ReadLine(u32 y, u32 xBytes, span<u8> output) const {
+            if (!base)
+                AccessLineGuest<true>(y, xBytes, output);
+            else if (blockLinear)
+                CopyBlockLinearRegion<true>(layout, base, xBytes, y, layer, output.data(), static_cast<u32>(output.size()), static_cast<u32>(output.size()), 1);
+            else
+                std::memcpy(output.data(), base + static_cast<size_t>(y) * pitch + xBytes, output.size());
+        }
+
+        void WriteLine(u32 y, u32 xBytes, span<u8> input) const {
+            if (!base)
+                AccessLineGuest<false>(y, xBytes, input);
+            else if (blockLinear)
+                CopyBlockLinearRegion<false>(layout, base, xBytes, y, layer, input.data(), static_cast<u32>(input.size()), static_cast<u32>(input.size()), 1);
+            else
+                std::memcpy(base + static_cast<size_t>(y) * pitch + xBytes, input.data(), input.size());
+        }
+    };
+}
@@ -25,14 +25,27 @@ namespace skyline::gpu {
           gpu(gpu),
           acquireFence(gpu.vkDevice, vk::FenceCreateInfo{}),
           presentationTrack(static_cast<u64>(trace::TrackIds::Presentation), perfetto::ProcessTrack::Current()),
+          presentQueueDepth(state.settings->forceTripleBuffering ? 2 : 1),
+          presentQueueMailbox(state.settings->disableFrameThrottling),
           choreographerThread(&PresentationEngine::ChoreographerThread, this),
           vsyncEvent(std::make_shared<kernel::type::KEvent>(state, true)) {
         auto desc{presentationTrack.Serialize()};
         desc.set_name("Presentation");
         perfetto::TrackEvent::SetTrackDescriptor(presentationTrack, desc);
+
+        presentThread = std::thread(&PresentationEngine::PresentationThread, this);
     }
 
     PresentationEngine::~PresentationEngine() {
+        {
+            std::scoped_lock lock(mutex, presentQueueMutex);
+            presentStop = true;
+        }
+        presentQueueCondition.notify_all();
+        surfaceCondition.notify_all();
+        if (presentThread.joinable())
+            presentThread.join();
+
         auto env{state.jvm->GetEnv()};
         if (!env->IsSameObject(jSurface, nullptr))
             env->DeleteGlobalRef(jSurface);
@@ -191,6 +204,9 @@ namespace skyline::gpu {
             if (swapchainExtent && swapchainFormat)
                 UpdateSwapchain(swapchainFormat, swapchainExtent);
 
+            transformHint.store(GetAndroidTransform(vkSurfaceCapabilities.currentTransform), std::memory_order_relaxed);
+            transformHintValid.store(true, std::memory_order_release);
+
             if (window->common.magic != AndroidNativeWindowMagic)
                 throw exception("ANativeWindow* has unexpected magic: {} instead of {}", span(&window->common.magic, 1).as_string(true), span<const u8>(reinterpret_cast<const u8 *>(&AndroidNativeWindowMagic), sizeof(u32)).as_string(true));
             if (window->common.version != sizeof(ANativeWindow))
@@ -211,14 +227,57 @@ namespace skyline::gpu {
 
             surfaceCondition.notify_all();
         } else {
+            transformHintValid.store(false, std::memory_order_relaxed);
             vkSurface.reset();
             window = nullptr;
         }
     }
 
-    void PresentationEngine::Present(const std::shared_ptr<Texture> &texture, i64 timestamp, u64 swapInterval, AndroidRect crop, NativeWindowScalingMode scalingMode, NativeWindowTransform transform, u64 &frameId) {
+    void PresentationEngine::PresentationThread() {
+        pthread_setname_np(pthread_self(), "Skyline-Present");
+        try {
+            signal::SetSignalHandler({SIGINT, SIGILL, SIGTRAP, SIGBUS, SIGFPE, SIGSEGV}, signal::ExceptionalSignalHandler);
+
+            while (true) {
+                QueuedFrame frame;
+                {
+                    std::unique_lock lock(presentQueueMutex);
+                    presentQueueCondition.wait(lock, [this]() { return presentStop || !presentQueue.empty(); });
+                    if (presentStop)
+                        return;
+
+                    // The frame is popped prior to presenting it so a guest blocked on a full queue can proceed, it might be holding the lock on the texture
+                    frame = std::move(presentQueue.front());
+                    presentQueue.pop_front();
+                }
+                presentQueueCondition.notify_all();
+
+                PresentFrame(frame);
+            }
+        } catch (const signal::SignalException &e) {
+            Logger::Error("{}\nStack Trace:{}", e.what(), state.loader->GetStackTrace(e.frames));
+            if (state.process)
+                state.process->Kill(false);
+            else
+                std::rethrow_exception(std::current_exception());
+        } catch (const std::exception &e) {
+            Logger::Error(e.what());
+            if (state.process)
+                state.process->Kill(false);
+            else
+                std::rethrow_exception(std::current_exception());
+        }
+    }
+
+    void PresentationEngine::PresentFrame(const QueuedFrame &frame) {
+        auto [texture, timestamp, swapInterval, crop, scalingMode, transform, queueTime, onConsumed]{frame};
+
         std::unique_lock lock(mutex);
-        surfaceCondition.wait(lock, [this]() { return vkSurface.has_value(); });
+        surfaceCondition.wait(lock, [this]() { return vkSurface.has_value() || presentStop; });
+        if (presentStop)
+            return;
+
+        std::unique_lock textureLock(*texture);
 
         if (texture->format != swapchainFormat || texture->dimensions != swapchainExtent)
             UpdateSwapchain(texture->format, texture->dimensions);
@@ -258,6 +317,10 @@ namespace skyline::gpu {
             .levelCount = 1,
             .layerCount = 1,
         });
+        textureLock.unlock();
+
+        if (onConsumed)
+            onConsumed();
 
         if (timestamp) {
             // If the timestamp is specified, we need to convert it from the util::GetTimeNs base to the CLOCK_MONOTONIC one
@@ -286,6 +349,7 @@ namespace skyline::gpu {
         if (timestamp && (result = window->perform(window, NATIVE_WINDOW_SET_BUFFERS_TIMESTAMP, timestamp)))
             throw exception("Setting the buffer timestamp to {} failed with {}", timestamp, result);
 
+        u64 frameId;
         if ((result = window->perform(window, NATIVE_WINDOW_GET_NEXT_FRAME_ID, &frameId)))
             throw exception("Retrieving the next frame's ID failed with {}", result);
 
@@ -298,8 +362,11 @@ namespace skyline::gpu {
             }); // We don't care about suboptimal images as they are caused by not respecting the transform hint, we handle transformations externally
         }
 
+        i64 now{util::GetTimeNs()};
+        i64 presentLatency{now - queueTime};
+        averagePresentLatencyNs = averagePresentLatencyNs ? (averagePresentLatencyNs * 9 + presentLatency) / 10 : presentLatency;
+
         if (frameTimestamp) {
-            i64 now{util::GetTimeNs()};
             i64 sampleWeight{swapInterval ? constant::NsInSecond / (refreshCycleDuration * static_cast<i64>(swapInterval)) : 10}; //!< The weight of each sample in calculating the average, we arbitrarily average 10 samples for unlocked FPS
 
             auto weightedAverage{[](auto weight, auto previousAverage, auto current) {
@@ -316,15 +383,51 @@ namespace skyline::gpu {
 
             Fps = static_cast<jint>(std::round(static_cast<float>(constant::NsInSecond) / static_cast<float>(averageFrametimeNs)));
 
-            TRACE_EVENT_INSTANT("gpu", "Present", presentationTrack, "FrameTimeNs", now - frameTimestamp, "Fps", Fps);
+            auto schedulerStatistics{gpu.scheduler.GetStatistics()};
+            u64 dropped;
+            {
+                std::scoped_lock queueLock(presentQueueMutex);
+                dropped = std::exchange(droppedFrames, 0);
+            }
+
+            TRACE_EVENT_INSTANT("gpu", "Present", presentationTrack, "FrameId", frameId, "FrameTimeNs", now - frameTimestamp, "Fps", Fps, "LatencyNs", presentLatency, "AverageLatencyNs", averagePresentLatencyNs, "DroppedFrames", dropped, "Submits", schedulerStatistics.submits - frameSchedulerStatistics.submits, "CommandBuffers", schedulerStatistics.commandBuffers - frameSchedulerStatistics.commandBuffers, "QueueLockHoldNs", schedulerStatistics.queueLockHoldNs - frameSchedulerStatistics.queueLockHoldNs);
+            frameSchedulerStatistics = schedulerStatistics;
 
             frameTimestamp = now;
         } else {
-            frameTimestamp = util::GetTimeNs();
+            frameTimestamp = now;
+        }
+    }
+
+    void PresentationEngine::Present(const std::shared_ptr<Texture> &texture, i64 timestamp, u64 swapInterval, AndroidRect crop, NativeWindowScalingMode scalingMode, NativeWindowTransform transform) {
+        std::function<void()> onDropped;
+        {
+            std::unique_lock lock(presentQueueMutex);
+            if (presentQueue.size() >= presentQueueDepth) {
+                if (presentQueueMailbox) {
+                    // The oldest frame is replaced with the newest one as it'd be superseded by it on the display regardless
+                    onDropped = std::move(presentQueue.front().onConsumed);
+                    presentQueue.pop_front();
+                    droppedFrames++;
+                } else {
+                    presentQueueCondition.wait(lock, [this]() { return presentQueue.size() < presentQueueDepth || presentStop; });
+                    if (presentStop)
+                        return;
+                }
+            }
+
+            presentQueue.push_back(QueuedFrame{texture, timestamp, swapInterval, crop, scalingMode, transform, util::GetTimeNs(), std::move(onConsumed)});
         }
+        presentQueueCondition.notify_all();
+
+        if (onDropped)
+            onDropped();
     }
 
     NativeWindowTransform PresentationEngine::GetTransformHint() {
+        if (transformHintValid.load(std::memory_order_acquire))
+            return transformHint.load(std::memory_order_relaxed);
+
         std::unique_lock lock(mutex);
         surfaceCondition.wait(lock, [this]() { return vkSurface.has_value(); });
         return GetAndroidTransform(vkSurfaceCapabilities.currentTransform);
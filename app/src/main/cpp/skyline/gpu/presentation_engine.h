@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include <deque>
 #include <jni.h>
 #include <android/looper.h>
 #include <common/trace.h>
 #include <kernel/types/KEvent.h>
 #include <services/hosbinder/GraphicBufferProducer.h>
+#include "command_scheduler.h"
 #include "texture/texture.h"
 
 struct ANativeWindow;
@@ -45,6 +47,34 @@ namespace skyline::gpu {
         i64 averageFrametimeNs{}; //!< The average time between frames in nanoseconds
         i64 averageFrametimeDeviationNs{}; //!< The average deviation of frametimes in nanoseconds
         perfetto::Track presentationTrack; //!< Perfetto track used for presentation events
+        CommandScheduler::Statistics frameSchedulerStatistics{}; //!< A snapshot of the command scheduler counters at the last frame, used to derive per-frame submission counts
+        i64 averagePresentLatencyNs{}; //!< The average time between a frame being queued and it being presented in nanoseconds
+
+        /**
+         * @brief A frame which has been queued by the guest and is waiting to be presented by the presentation thread
+         */
+        struct QueuedFrame {
+            std::shared_ptr<Texture> texture;
+            i64 timestamp;
+            u64 swapInterval;
+            service::hosbinder::AndroidRect crop;
+            service::hosbinder::NativeWindowScalingMode scalingMode;
+            service::hosbinder::NativeWindowTransform transform;
+            i64 queueTime; //!< The time at which the frame was queued in nanoseconds, this is used to measure presentation latency
+            std::function<void()> onConsumed; //!< Invoked once the texture has been copied to the swapchain or the frame has been dropped, the texture may be reused by the guest after this
+        };
+
+        std::thread presentThread; //!< A thread which presents queued frames to the surface, this avoids host stalls from blocking the guest
+        std::mutex presentQueueMutex; //!< Synchronizes access to the present queue
+        std::condition_variable presentQueueCondition; //!< Signalled when a frame is pushed to or popped from the present queue
+        std::deque<QueuedFrame> presentQueue; //!< Frames which are waiting to be presented in the order they were queued
+        size_t presentQueueDepth; //!< The maximum amount of frames in the present queue
+        bool presentQueueMailbox; //!< If the oldest frame should be dropped when the queue is full (Mailbox) rather than blocking the guest until there's space (FIFO)
+        u64 droppedFrames{}; //!< The amount of frames that were replaced in the queue prior to being presented, this is protected by the present queue mutex
+        bool presentStop{}; //!< If the presentation thread should exit, this is protected by both 'mutex' and the present queue mutex
+
+        std::atomic<bool> transformHintValid{}; //!< If the cached transform hint corresponds to the current surface
+        std::atomic<service::hosbinder::NativeWindowTransform> transformHint{}; //!< The transform hint of the current surface, it's cached to avoid waiting on 'mutex' which is held during presentation
 
         std::thread choreographerThread; //!< A thread for signalling the V-Sync event and measure the refresh cycle duration using AChoreographer
         ALooper *choreographerLooper{};
@@ -67,6 +97,16 @@ namespace skyline::gpu {
          */
         void UpdateSwapchain(texture::Format format, texture::Dimensions extent);
 
+        /**
+         * @brief The entry point for the presentation thread, it presents frames from the present queue until the engine is destroyed
+         */
+        void PresentationThread();
+
+        /**
+         * @brief Acquires a swapchain image, copies the frame into it and presents it to the surface
+         */
+        void PresentFrame(const QueuedFrame &frame);
+
       public:
         std::shared_ptr<kernel::type::KEvent> vsyncEvent; //!< Signalled every time a frame is drawn
 
@@ -80,16 +120,17 @@ namespace skyline::gpu {
         void UpdateSurface(jobject newSurface);
 
         /**
-         * @brief Queue the supplied texture to be presented to the screen
+         * @brief Queue the supplied texture to be presented to the screen by the presentation thread
          * @param timestamp The earliest timestamp (relative to skyline::util::GetTickNs) at which the frame must be presented, it should be 0 when it doesn't matter
          * @param swapInterval The amount of display refreshes that must take place prior to presenting this image
          * @param crop A rectangle with bounds that the image will be cropped to
          * @param scalingMode The mode by which the image must be scaled up to the surface
          * @param transform A transformation that should be performed on the image
-         * @param frameId The ID of this frame for correlating it with presentation timing readouts
-         * @note The texture **must** be locked prior to calling this
+         * @param onConsumed A callback invoked once the contents of the texture have been copied to the swapchain or the frame has been dropped, this may be invoked on the calling thread prior to returning when another frame is dropped
+         * @note If the present queue is full, this will either replace the oldest queued frame or block till a frame has been presented depending on if frame throttling is disabled
+         * @note The texture is locked by the presentation thread when it's copied to the swapchain, its contents at that point are presented
          */
-        void Present(const std::shared_ptr<Texture> &texture, i64 timestamp, u64 swapInterval, service::hosbinder::AndroidRect crop, service::hosbinder::NativeWindowScalingMode scalingMode, service::hosbinder::NativeWindowTransform transform, u64 &frameId);
+        void Present(const std::shared_ptr<Texture> &texture, i64 timestamp, u64 swapInterval, service::hosbinder::AndroidRect crop, service::hosbinder::NativeWindowScalingMode scalingMode, service::hosbinder::NativeWindowTransform transform, std::function<void()> onConsumed = {});
 
         /**
          * @return A transform that the application should render with to elide costly transforms later
@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/trace.h>
+#include "format.h"
+#include "bc_decoder.h"
+
+namespace skyline::gpu::texture::bcn {
+    namespace {
+        constexpr u32 BlockWidth{4}; //!< The width of a BCn block in texels
+        constexpr u32 BlockHeight{4}; //!< The height of a BCn block in texels
+        constexpr u32 BlockTexels{BlockWidth * BlockHeight};
+
+        using Block = std::array<u32, BlockTexels>; //!< The RGBA8 texels of a decoded block in row-major order
+        using Channel = std::array<u8, BlockTexels>; //!< A single 8-bit channel of a decoded block in row-major order
+        using BlockDecoder = void (*)(const u8 *data, Block &block);
+
+        constexpr u32 PackRgba(u32 red, u32 green, u32 blue, u32 alpha) {
+            return red | (green << 8) | (blue << 16) | (alpha << 24);
+        }
+
+        template<typename Type>
+        Type LoadLe(const u8 *data) {
+            Type value;
+            std::memcpy(&value, data, sizeof(Type));
+            return value;
+        }
+
+        /**
+         * @return The division of the value by the divisor rounded to the nearest integer with ties away from zero
+         */
+        constexpr i32 DivideRound(i32 value, i32 divisor) {
+            return (value + (value >= 0 ? divisor / 2 : -divisor / 2)) / divisor;
+        }
+
+        /**
+         * @brief Decodes the BC1 color block shared by BC1, BC2 and BC3
+         * @param punchThrough If the block can select the 3-color mode with transparent black, this is only the case for BC1
+         */
+        void DecodeColor(const u8 *data, Block &block, bool punchThrough) {
+            u16 color0{LoadLe<u16>(data)}, color1{LoadLe<u16>(data + 2)};
+            u32 indices{LoadLe<u32>(data + 4)};
+
+            auto expand{[](u32 color) {
+                u32 red{(color >> 11) & 0x1F}, green{(color >> 5) & 0x3F}, blue{color & 0x1F};
+                return std::array<u32, 3>{(red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2)};
+            }};
+            auto rgb0{expand(color0)}, rgb1{expand(color1)};
+
+            std::array<u32, 4> palette{PackRgba(rgb0[0], rgb0[1], rgb0[2], 0xFF), PackRgba(rgb1[0], rgb1[1], rgb1[2], 0xFF)};
+            if (color0 > color1 || !punchThrough) {
+                palette[2] = PackRgba((2 * rgb0[0] + rgb1[0] + 1) / 3, (2 * rgb0[1] + rgb1[1] + 1) / 3, (2 * rgb0[2] + rgb1[2] + 1) / 3, 0xFF);
+                palette[3] = PackRgba((rgb0[0] + 2 * rgb1[0] + 1) / 3, (rgb0[1] + 2 * rgb1[1] + 1) / 3, (rgb0[2] + 2 * rgb1[2] + 1) / 3, 0xFF);
+            } else {
+                palette[2] = PackRgba((rgb0[0] + rgb1[0]) / 2, (rgb0[1] + rgb1[1]) / 2, (rgb0[2] + rgb1[2]) / 2, 0xFF);
+                palette[3] = 0; // Transparent black
+            }
+
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                block[texel] = palette[(indices >> (texel * 2)) & 0b11];
+        }
+
+        /**
+         * @brief Decodes a BC4 channel block which is also used for the alpha of BC3 and both channels of BC5
+         * @tparam Signed If the endpoints are signed (SNORM), the decoded values are two's complement bytes in that case
+         */
+        template<bool Signed>
+        Channel DecodeChannel(const u8 *data) {
+            i32 value0, value1, minimum, maximum;
+            if constexpr (Signed) {
+                // -128 and -127 both map to -1.0 in SNORM
+                value0 = std::max<i32>(static_cast<i8>(data[0]), -127);
+                value1 = std::max<i32>(static_cast<i8>(data[1]), -127);
+                minimum = -127;
+                maximum = 127;
+            } else {
+                value0 = data[0];
+                value1 = data[1];
+                minimum = 0;
+                maximum = 0xFF;
+            }
+
+            std::array<i32, 8> palette{value0, value1};
+            if (value0 > value1) {
+                for (i32 index{1}; index < 7; index++)
+                    palette[index + 1] = DivideRound((7 - index) * value0 + index * value1, 7);
+            } else {
+                for (i32 index{1}; index < 5; index++)
+                    palette[index + 1] = DivideRound((5 - index) * value0 + index * value1, 5);
+                palette[6] = minimum;
+                palette[7] = maximum;
+            }
+
+            u64 indices{LoadLe<u64>(data) >> 16}; // 16 3-bit indices follow the endpoints
+            Channel channel;
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                channel[texel] = static_cast<u8>(palette[(indices >> (texel * 3)) & 0b111]);
+            return channel;
+        }
+
+        void DecodeBc1(const u8 *data, Block &block) {
+            DecodeColor(data, block, true);
+        }
+
+        void DecodeBc2(const u8 *data, Block &block) {
+            DecodeColor(data + 8, block, false);
+
+            u64 alpha{LoadLe<u64>(data)}; // 16 explicit 4-bit alpha values
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                block[texel] = (block[texel] & 0xFFFFFF) | ((((alpha >> (texel * 4)) & 0xF) * 0x11) << 24);
+        }
+
+        void DecodeBc3(const u8 *data, Block &block) {
+            DecodeColor(data + 8, block, false);
+
+            auto alpha{DecodeChannel<false>(data)};
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                block[texel] = (block[texel] & 0xFFFFFF) | (static_cast<u32>(alpha[texel]) << 24);
+        }
+
+        template<bool Signed>
+        void DecodeBc4(const u8 *data, Block &block) {
+            constexpr u32 One{Signed ? 0x7F : 0xFF};
+            auto red{DecodeChannel<Signed>(data)};
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                block[texel] = PackRgba(red[texel], 0, 0, One);
+        }
+
+        template<bool Signed>
+        void DecodeBc5(const u8 *data, Block &block) {
+            constexpr u32 One{Signed ? 0x7F : 0xFF};
+            auto red{DecodeChannel<Signed>(data)}, green{DecodeChannel<Signed>(data + 8)};
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                block[texel] = PackRgba(red[texel], green[texel], 0, One);
+        }
+
+        /**
+         * @brief Reads fields of a 128-bit block in LSB-first order
+         */
+        class BitReader {
+          private:
+            u64 low, high;
+            u32 position{};
+
+          public:
+            BitReader(const u8 *data) : low(LoadLe<u64>(data)), high(LoadLe<u64>(data + 8)) {}
+
+            u32 Read(u32 count) {
+                if (!count)
+                    return 0;
+
+                u64 value;
+                if (position >= 64)
+                    value = high >> (position - 64);
+                else if (position + count <= 64)
+                    value = low >> position;
+                else
+                    value = (low >> position) | (high << (64 - position));
+
+                position += count;
+                return static_cast<u32>(value) & ((1U << count) - 1);
+            }
+        };
+
+        /**
+         * @brief The layout of a BC7 block for one of its 8 modes
+         * @url https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html#bptc_bc7
+         */
+        struct Bc7Mode {
+            u8 subsetCount;
+            u8 partitionBits;
+            u8 rotationBits;
+            u8 indexSelectionBits;
+            u8 colorBits; //!< The amount of bits in each color component of an endpoint excluding the P-bit
+            u8 alphaBits; //!< The amount of bits in the alpha component of an endpoint excluding the P-bit, endpoints are opaque if this is 0
+            u8 endpointPBits; //!< If each endpoint has a unique P-bit
+            u8 sharedPBits; //!< If both endpoints of a subset share a P-bit
+            u8 indexBits;
+            u8 secondaryIndexBits; //!< The amount of bits in each index of the second index set, the first set is used for all channels if this is 0
+        };
+
+        constexpr std::array<Bc7Mode, 8> Bc7Modes{{
+            {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+            {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+            {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+            {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+            {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+            {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+            {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+            {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+        }};
+
+        //!< The subset of each texel for the 2-subset partitions, one bit per texel
+        constexpr std::array<u16, 64> Bc7Partitions2{
+            0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+            0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+            0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+            0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+        };
+
+        //!< The subset of each texel for the 3-subset partitions, two bits per texel
+        constexpr std::array<u32, 64> Bc7Partitions3{
+            0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+            0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+            0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+            0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+            0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+            0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+            0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+            0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+        };
+
+        //!< The anchor texel of the second subset for the 2-subset partitions, the anchor of the first subset is always texel 0
+        constexpr std::array<u8, 64> Bc7Anchors2{
+            15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+            15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+            15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+            6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+        };
+
+        //!< The anchor texel of the second subset for the 3-subset partitions
+        constexpr std::array<u8, 64> Bc7Anchors3Second{
+            3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+            3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+            8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+            3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+        };
+
+        //!< The anchor texel of the third subset for the 3-subset partitions
+        constexpr std::array<u8, 64> Bc7Anchors3Third{
+            15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+            15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+            15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+            15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+        };
+
+        constexpr std::array<u8, 4> Bc7Weights2{0, 21, 43, 64};
+        constexpr std::array<u8, 8> Bc7Weights3{0, 9, 18, 27, 37, 46, 55, 64};
+        constexpr std::array<u8, 16> Bc7Weights4{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        constexpr u32 Bc7Interpolate(u32 endpoint0, u32 endpoint1, u32 bits, u32 index) {
+            u32 weight{bits == 2 ? Bc7Weights2[index] : (bits == 3 ? Bc7Weights3[index] : Bc7Weights4[index])};
+            return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+        }
+
+        void DecodeBc7(const u8 *data, Block &block) {
+            if (!data[0]) {
+                block.fill(0); // Reserved mode, this decodes to transparent black on all hardware
+                return;
+            }
+
+            u32 modeIndex{static_cast<u32>(std::countr_zero(data[0]))};
+            const auto &mode{Bc7Modes[modeIndex]};
+
+            BitReader reader{data};
+            reader.Read(modeIndex + 1);
+            u32 partition{reader.Read(mode.partitionBits)};
+            u32 rotation{reader.Read(mode.rotationBits)};
+            bool indexSelection{reader.Read(mode.indexSelectionBits) != 0};
+
+            u32 endpointCount{mode.subsetCount * 2U};
+            std::array<std::array<u32, 4>, 6> endpoints{}; //!< The RGBA components of every endpoint, endpoints [2n, 2n + 1] belong to subset n
+            for (u32 component{}; component < 3; component++)
+                for (u32 endpoint{}; endpoint < endpointCount; endpoint++)
+                    endpoints[endpoint][component] = reader.Read(mode.colorBits);
+            if (mode.alphaBits)
+                for (u32 endpoint{}; endpoint < endpointCount; endpoint++)
+                    endpoints[endpoint][3] = reader.Read(mode.alphaBits);
+
+            std::array<u32, 6> pBits{};
+            if (mode.endpointPBits)
+                for (u32 endpoint{}; endpoint < endpointCount; endpoint++)
+                    pBits[endpoint] = reader.Read(1);
+            else if (mode.sharedPBits)
+                for (u32 subset{}; subset < mode.subsetCount; subset++)
+                    pBits[subset * 2] = pBits[subset * 2 + 1] = reader.Read(1);
+            bool hasPBits{mode.endpointPBits || mode.sharedPBits};
+
+            // Endpoints are expanded to 8 bits by appending the P-bit and replicating the high bits into the low bits
+            auto expand{[&](u32 value, u32 bits, u32 pBit) {
+                if (hasPBits) {
+                    value = (value << 1) | pBit;
+                    bits++;
+                }
+                value <<= 8 - bits;
+                return value | (value >> bits);
+            }};
+            for (u32 endpoint{}; endpoint < endpointCount; endpoint++) {
+                for (u32 component{}; component < 3; component++)
+                    endpoints[endpoint][component] = expand(endpoints[endpoint][component], mode.colorBits, pBits[endpoint]);
+                endpoints[endpoint][3] = mode.alphaBits ? expand(endpoints[endpoint][3], mode.alphaBits, pBits[endpoint]) : 0xFF;
+            }
+
+            auto getSubset{[&](u32 texel) -> u32 {
+                if (mode.subsetCount == 2)
+                    return (Bc7Partitions2[partition] >> texel) & 0b1;
+                else if (mode.subsetCount == 3)
+                    return (Bc7Partitions3[partition] >> (texel * 2)) & 0b11;
+                return 0;
+            }};
+
+            // The MSB of the index of the anchor texel of every subset is implicitly 0 and isn't stored
+            auto isAnchor{[&](u32 texel) {
+                if (texel == 0)
+                    return true;
+                else if (mode.subsetCount == 2)
+                    return texel == Bc7Anchors2[partition];
+                else if (mode.subsetCount == 3)
+                    return texel == Bc7Anchors3Second[partition] || texel == Bc7Anchors3Third[partition];
+                return false;
+            }};
+
+            std::array<u8, BlockTexels> colorIndices, alphaIndices;
+            for (u32 texel{}; texel < BlockTexels; texel++)
+                colorIndices[texel] = static_cast<u8>(reader.Read(mode.indexBits - isAnchor(texel)));
+            if (mode.secondaryIndexBits)
+                for (u32 texel{}; texel < BlockTexels; texel++)
+                    alphaIndices[texel] = static_cast<u8>(reader.Read(mode.secondaryIndexBits - (texel == 0)));
+            else
+                alphaIndices = colorIndices;
+
+            u32 colorIndexBits{mode.indexBits}, alphaIndexBits{mode.secondaryIndexBits ? mode.secondaryIndexBits : mode.indexBits};
+            if (indexSelection) {
+                std::swap(colorIndices, alphaIndices);
+                std::swap(colorIndexBits, alphaIndexBits);
+            }
+
+            for (u32 texel{}; texel < BlockTexels; texel++) {
+                u32 subset{getSubset(texel)};
+                const auto &endpoint0{endpoints[subset * 2]}, &endpoint1{endpoints[subset * 2 + 1]};
+
+                std::array<u32, 4> rgba{
+                    Bc7Interpolate(endpoint0[0], endpoint1[0], colorIndexBits, colorIndices[texel]),
+                    Bc7Interpolate(endpoint0[1], endpoint1[1], colorIndexBits, colorIndices[texel]),
+                    Bc7Interpolate(endpoint0[2], endpoint1[2], colorIndexBits, colorIndices[texel]),
+                    Bc7Interpolate(endpoint0[3], endpoint1[3], alphaIndexBits, alphaIndices[texel]),
+                };
+                if (rotation)
+                    std::swap(rgba[3], rgba[rotation - 1]); // Rotation swaps the alpha channel with the red (1), green (2) or blue (3) channel
+
+                block[texel] = PackRgba(rgba[0], rgba[1], rgba[2], rgba[3]);
+            }
+        }
+
+        BlockDecoder GetBlockDecoder(Format format) {
+            switch (format->vkFormat) {
+                case vk::Format::eBc1RgbaUnormBlock:
+                case vk::Format::eBc1RgbaSrgbBlock:
+                    return DecodeBc1;
+                case vk::Format::eBc2UnormBlock:
+                case vk::Format::eBc2SrgbBlock:
+                    return DecodeBc2;
+                case vk::Format::eBc3UnormBlock:
+                case vk::Format::eBc3SrgbBlock:
+                    return DecodeBc3;
+                case vk::Format::eBc4UnormBlock:
+                    return DecodeBc4<false>;
+                case vk::Format::eBc4SnormBlock:
+                    return DecodeBc4<true>;
+                case vk::Format::eBc5UnormBlock:
+                    return DecodeBc5<false>;
+                case vk::Format::eBc5SnormBlock:
+                    return DecodeBc5<true>;
+                case vk::Format::eBc7UnormBlock:
+                case vk::Format::eBc7SrgbBlock:
+                    return DecodeBc7;
+                default:
+                    return nullptr;
+            }
+        }
+    }
+
+    bool IsDecodable(Format format) {
+        return GetBlockDecoder(format) != nullptr;
+    }
+
+    Format GetDecodedFormat(Format format) {
+        switch (format->vkFormat) {
+            case vk::Format::eBc1RgbaSrgbBlock:
+            case vk::Format::eBc2SrgbBlock:
+            case vk::Format::eBc3SrgbBlock:
+            case vk::Format::eBc7SrgbBlock:
+                return format::A8B8G8R8Srgb;
+            case vk::Format::eBc4SnormBlock:
+            case vk::Format::eBc5SnormBlock:
+                return format::A8B8G8R8Snorm;
+            case vk::Format::eBc1RgbaUnormBlock:
+            case vk::Format::eBc2UnormBlock:
+            case vk::Format::eBc3UnormBlock:
+            case vk::Format::eBc4UnormBlock:
+            case vk::Format::eBc5UnormBlock:
+            case vk::Format::eBc7UnormBlock:
+                return format::R8G8B8A8Unorm;
+            default:
+                throw exception("Cannot decode textures in format '{}' on the CPU", vk::to_string(format->vkFormat));
+        }
+    }
+
+    void Decode(Format format, const u8 *input, u8 *output, Dimensions dimensions) {
+        TRACE_EVENT("gpu", "bcn::Decode");
+
+        auto decodeBlock{GetBlockDecoder(format)};
+        if (!decodeBlock)
+            throw exception("Cannot decode textures in format '{}' on the CPU", vk::to_string(format->vkFormat));
+
+        u32 widthBlocks{util::AlignUp(dimensions.width, BlockWidth) / BlockWidth}, heightBlocks{util::AlignUp(dimensions.height, BlockHeight) / BlockHeight};
+        size_t outputPitch{static_cast<size_t>(dimensions.width) * sizeof(u32)};
+        size_t outputSliceSize{outputPitch * dimensions.height};
+
+        Block block;
+        for (u32 z{}; z < dimensions.depth; z++) {
+            u8 *outputSlice{output + z * outputSliceSize};
+            for (u32 blockY{}; blockY < heightBlocks; blockY++) {
+                u32 y{blockY * BlockHeight}, rows{std::min(BlockHeight, dimensions.height - y)};
+                for (u32 blockX{}; blockX < widthBlocks; blockX++) {
+                    decodeBlock(input, block);
+                    input += format->bpb;
+
+                    u32 x{blockX * BlockWidth}, columns{std::min(BlockWidth, dimensions.width - x)};
+                    for (u32 row{}; row < rows; row++)
+                        std::memcpy(outputSlice + (y + row) * outputPitch + x * sizeof(u32), block.data() + row * BlockWidth, columns * sizeof(u32));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include "texture.h"
+
+namespace skyline::gpu::texture::bcn {
+    /**
+     * @return If textures of the supplied format can be decoded on the CPU by Decode
+     */
+    bool IsDecodable(Format format);
+
+    /**
+     * @return The RGBA8 format that textures of the supplied BCn format are decoded into
+     * @note The format must be decodable as determined by IsDecodable
+     */
+    Format GetDecodedFormat(Format format);
+
+    /**
+     * @brief Decodes a tightly packed linear BCn texture into tightly packed RGBA8 texels
+     * @param input The compressed texture, each row of blocks immediately follows the previous one
+     * @param output A buffer of at least GetDecodedFormat(format)->GetSize(dimensions) bytes
+     * @note Blocks which extend past the dimensions of the texture are clipped to it
+     */
+    void Decode(Format format, const u8 *input, u8 *output, Dimensions dimensions);
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::gpu {
+    /**
+     * @brief The layout of a block-linear surface in bytes, this is format-agnostic as engines such as the DMA engine operate on raw bytes
+     */
+    struct BlockLinearLayout {
+        static constexpr u32 SectorWidth{16}; //!< The width of a sector in bytes
+        static constexpr u32 SectorHeight{2}; //!< The height of a sector in lines
+        static constexpr u32 GobWidth{64}; //!< The width of a GOB in bytes
+        static constexpr u32 GobHeight{8}; //!< The height of a GOB in lines
+        static constexpr u32 GobSize{GobWidth * GobHeight}; //!< The size of a GOB in bytes
+
+        u32 widthBytes; //!< The width of the surface in bytes
+        u32 height; //!< The height of the surface in lines
+        u32 depth; //!< The depth of the surface in slices
+        u32 blockHeight; //!< The height of a block in GOBs
+        u32 blockDepth; //!< The depth of a block in GOBs
+
+        constexpr u32 WidthBlocks() const {
+            return util::AlignUp(widthBytes, GobWidth) / GobWidth;
+        }
+
+        constexpr u32 HeightBlocks() const {
+            return util::AlignUp(height, GobHeight * blockHeight) / (GobHeight * blockHeight);
+        }
+
+        constexpr u32 BlockSize() const {
+            return GobSize * blockHeight * blockDepth;
+        }
+
+        /**
+         * @return The size of the entire surface in bytes including all padding
+         */
+        constexpr size_t GetSize() const {
+            return static_cast<size_t>(WidthBlocks()) * HeightBlocks() * (util::AlignUp(depth, blockDepth) / blockDepth) * BlockSize();
+        }
+
+        /**
+         * @return The offset of the start of the sector containing the supplied byte in the surface, the byte is at an offset of `x % SectorWidth` from it
+         */
+        constexpr size_t GetSectorOffset(u32 x, u32 y, u32 z) const {
+            size_t blockIndex{(static_cast<size_t>(z / blockDepth) * HeightBlocks() + (y / (GobHeight * blockHeight))) * WidthBlocks() + (x / GobWidth)};
+            u32 gobIndex{(z % blockDepth) * blockHeight + ((y / GobHeight) % blockHeight)};
+
+            // Morton-Swizzle of the sector within the GOB, see CopyBlockLinearToLinear for the inverse of this
+            u32 gobX{x % GobWidth}, gobY{y % GobHeight};
+            u32 sector{((gobX / 32) << 4) | ((gobY / 4) << 3) | (((gobY / 2) % 2) << 2) | (((gobX / 16) % 2) << 1) | (gobY % 2)};
+
+            return blockIndex * BlockSize() + gobIndex * GobSize + sector * SectorWidth;
+        }
+    };
+
+    /**
+     * @brief Calls the supplied function for every sector-sized contiguous span of a single line of a block-linear region
+     * @param originX The X offset of the line in the block-linear surface in bytes
+     * @param function A function taking the offset of the span in the surface, its offset within the line and its size
+     * @note This is used to access surfaces which aren't contiguous in host memory through the GMMU without touching any bytes outside the region
+     */
+    template<typename Function>
+    void ForEachBlockLinearSpan(const BlockLinearLayout &layout, u32 originX, u32 y, u32 z, u32 lineBytes, Function function) {
+        constexpr u32 SectorWidth{BlockLinearLayout::SectorWidth};
+
+        for (u32 x{originX}, end{originX + lineBytes}; x < end;) {
+            u32 sectorX{x % SectorWidth};
+            u32 spanSize{std::min(SectorWidth - sectorX, end - x)};
+            function(layout.GetSectorOffset(x, y, z) + sectorX, x - originX, spanSize);
+            x += spanSize;
+        }
+    }
+
+    /**
+     * @brief Copies a rectangular region between a block-linear surface and a pitch-linear buffer, each line is split into sector-sized contiguous copies
+     * @tparam BlockLinearToPitch If the copy is from the block-linear surface to the pitch buffer rather than the inverse
+     * @param originX The X offset of the region in the block-linear surface in bytes
+     */
+    template<bool BlockLinearToPitch>
+    void CopyBlockLinearRegion(const BlockLinearLayout &layout, u8 *blockLinear, u32 originX, u32 originY, u32 z, u8 *pitch, u32 pitchBytes, u32 lineBytes, u32 lineCount) {
+        for (u32 line{}; line < lineCount; line++) {
+            u8 *pitchLine{pitch + static_cast<size_t>(line) * pitchBytes};
+            ForEachBlockLinearSpan(layout, originX, originY + line, z, lineBytes, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                if constexpr (BlockLinearToPitch)
+                    std::memcpy(pitchLine + lineOffset, blockLinear + surfaceOffset, size);
+                else
+                    std::memcpy(blockLinear + surfaceOffset, pitchLine + lineOffset, size);
+            });
+        }
+    }
+}
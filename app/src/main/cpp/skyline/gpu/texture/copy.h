@@ -4,12 +4,13 @@
 #pragma once
 
 #include "texture.h"
+#include "block_linear.h"
 
 namespace skyline::gpu {
     /**
      * @brief Copies the contents of a blocklinear guest texture to a linear output buffer
      */
-    void CopyBlockLinearToLinear(GuestTexture &guest, u8 *guestInput, u8 *linearOutput) {
+    inline void CopyBlockLinearToLinear(GuestTexture &guest, u8 *guestInput, u8 *linearOutput) {
         // Reference on Block-linear tiling: https://gist.github.com/PixelyIon/d9c35050af0ef5690566ca9f0965bc32
         constexpr u8 SectorWidth{16}; // The width of a sector in bytes
         constexpr u8 SectorHeight{2}; // The height of a sector in lines
@@ -18,9 +19,9 @@ namespace skyline::gpu {
 
         u32 blockHeight{guest.tileConfig.blockHeight}; //!< The height of the blocks in GOBs
         u32 robHeight{GobHeight * blockHeight}; //!< The height of a single ROB (Row of Blocks) in lines
-        u32 surfaceHeight{guest.dimensions.height / guest.format->blockHeight}; //!< The height of the surface in lines
+        u32 surfaceHeight{guest.format->GetHeightBlocks(guest.dimensions.height)}; //!< The height of the surface in lines, a line of a compressed format is a row of blocks
         u32 surfaceHeightRobs{util::AlignUp(surfaceHeight, robHeight) / robHeight}; //!< The height of the surface in ROBs (Row Of Blocks)
-        u32 robWidthBytes{util::AlignUp((guest.dimensions.width / guest.format->blockWidth) * guest.format->bpb, GobWidth)}; //!< The width of a ROB in bytes
+        u32 robWidthBytes{util::AlignUp(guest.format->GetWidthBlocks(guest.dimensions.width) * guest.format->bpb, GobWidth)}; //!< The width of a ROB in bytes
         u32 robWidthBlocks{robWidthBytes / GobWidth}; //!< The width of a ROB in blocks (and GOBs because block width == 1 on the Tegra X1)
         u32 robBytes{robWidthBytes * robHeight}; //!< The size of a ROB in bytes
         u32 gobYOffset{robWidthBytes * GobHeight}; //!< The offset of the next Y-axis GOB from the current one in linear space
@@ -55,7 +56,7 @@ namespace skyline::gpu {
     /**
      * @brief Copies the contents of a blocklinear guest texture to a linear output buffer
      */
-    void CopyLinearToBlockLinear(GuestTexture &guest, u8 *linearInput, u8 *guestOutput) {
+    inline void CopyLinearToBlockLinear(GuestTexture &guest, u8 *linearInput, u8 *guestOutput) {
         // Reference on Block-linear tiling: https://gist.github.com/PixelyIon/d9c35050af0ef5690566ca9f0965bc32
         constexpr u8 SectorWidth{16}; // The width of a sector in bytes
         constexpr u8 SectorHeight{2}; // The height of a sector in lines
@@ -64,9 +65,9 @@ namespace skyline::gpu {
 
         u32 blockHeight{guest.tileConfig.blockHeight}; //!< The height of the blocks in GOBs
         u32 robHeight{GobHeight * blockHeight}; //!< The height of a single ROB (Row of Blocks) in lines
-        u32 surfaceHeight{guest.dimensions.height / guest.format->blockHeight}; //!< The height of the surface in lines
+        u32 surfaceHeight{guest.format->GetHeightBlocks(guest.dimensions.height)}; //!< The height of the surface in lines, a line of a compressed format is a row of blocks
         u32 surfaceHeightRobs{util::AlignUp(surfaceHeight, robHeight) / robHeight}; //!< The height of the surface in ROBs (Row Of Blocks)
-        u32 robWidthBytes{util::AlignUp((guest.dimensions.width / guest.format->blockWidth) * guest.format->bpb, GobWidth)}; //!< The width of a ROB in bytes
+        u32 robWidthBytes{util::AlignUp(guest.format->GetWidthBlocks(guest.dimensions.width) * guest.format->bpb, GobWidth)}; //!< The width of a ROB in bytes
         u32 robWidthBlocks{robWidthBytes / GobWidth}; //!< The width of a ROB in blocks (and GOBs because block width == 1 on the Tegra X1)
         u32 robBytes{robWidthBytes * robHeight}; //!< The size of a ROB in bytes
         u32 gobYOffset{robWidthBytes * GobHeight}; //!< The offset of the next Y-axis GOB from the current one in linear space
@@ -101,14 +102,16 @@ namespace skyline::gpu {
     /**
      * @brief Copies the contents of a pitch-linear guest texture to a linear output buffer
      */
-    void CopyPitchLinearToLinear(GuestTexture &guest, u8 *guestInput, u8 *linearOutput) {
-        auto sizeLine{guest.format->GetSize(guest.dimensions.width, 1)}; //!< The size of a single line of pixel data
-        auto sizeStride{guest.format->GetSize(guest.tileConfig.pitch, 1)}; //!< The size of a single stride of pixel data
+    inline void CopyPitchLinearToLinear(GuestTexture &guest, u8 *guestInput, u8 *linearOutput) {
+        // Lines of compressed formats are rows of blocks, they span multiple lines of pixels
+        auto sizeLine{guest.format->GetSize(guest.dimensions.width, guest.format->blockHeight)}; //!< The size of a single line of pixel data
+        auto sizeStride{guest.format->GetSize(guest.tileConfig.pitch, guest.format->blockHeight)}; //!< The size of a single stride of pixel data
+        auto lineCount{guest.format->GetHeightBlocks(guest.dimensions.height)};
 
         auto inputLine{guestInput};
         auto outputLine{linearOutput};
 
-        for (u32 line{}; line < guest.dimensions.height; line++) {
+        for (u32 line{}; line < lineCount; line++) {
             std::memcpy(outputLine, inputLine, sizeLine);
             inputLine += sizeStride;
             outputLine += sizeLine;
@@ -118,14 +121,16 @@ namespace skyline::gpu {
     /**
      * @brief Copies the contents of a linear buffer to a pitch-linear guest texture
      */
-    void CopyLinearToPitchLinear(GuestTexture &guest, u8 *linearInput, u8 *guestOutput) {
-        auto sizeLine{guest.format->GetSize(guest.dimensions.width, 1)}; //!< The size of a single line of pixel data
-        auto sizeStride{guest.format->GetSize(guest.tileConfig.pitch, 1)}; //!< The size of a single stride of pixel data
+    inline void CopyLinearToPitchLinear(GuestTexture &guest, u8 *linearInput, u8 *guestOutput) {
+        // Lines of compressed formats are rows of blocks, they span multiple lines of pixels
+        auto sizeLine{guest.format->GetSize(guest.dimensions.width, guest.format->blockHeight)}; //!< The size of a single line of pixel data
+        auto sizeStride{guest.format->GetSize(guest.tileConfig.pitch, guest.format->blockHeight)}; //!< The size of a single stride of pixel data
+        auto lineCount{guest.format->GetHeightBlocks(guest.dimensions.height)};
 
         auto inputLine{linearInput};
         auto outputLine{guestOutput};
 
-        for (u32 line{}; line < guest.dimensions.height; line++) {
+        for (u32 line{}; line < lineCount; line++) {
             std::memcpy(outputLine, inputLine, sizeLine);
             inputLine += sizeLine;
             outputLine += sizeStride;
@@ -41,6 +41,22 @@ namespace skyline::gpu::format {
     constexpr Format R16G16B16A16Uint{sizeof(u16) * 4, vkf::eR16G16B16A16Uint};
     constexpr Format R16G16B16A16Float{sizeof(u16) * 4, vkf::eR16G16B16A16Sfloat};
 
+    // Block-compressed formats, these are decoded on the CPU if the host doesn't support sampling them (see bcn::Decode)
+    constexpr Format BC1Unorm{sizeof(u64), vkf::eBc1RgbaUnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC1Srgb{sizeof(u64), vkf::eBc1RgbaSrgbBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC2Unorm{sizeof(u64) * 2, vkf::eBc2UnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC2Srgb{sizeof(u64) * 2, vkf::eBc2SrgbBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC3Unorm{sizeof(u64) * 2, vkf::eBc3UnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC3Srgb{sizeof(u64) * 2, vkf::eBc3SrgbBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC4Unorm{sizeof(u64), vkf::eBc4UnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC4Snorm{sizeof(u64), vkf::eBc4SnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC5Unorm{sizeof(u64) * 2, vkf::eBc5UnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC5Snorm{sizeof(u64) * 2, vkf::eBc5SnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC6HUfloat{sizeof(u64) * 2, vkf::eBc6HUfloatBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC6HSfloat{sizeof(u64) * 2, vkf::eBc6HSfloatBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC7Unorm{sizeof(u64) * 2, vkf::eBc7UnormBlock, .blockHeight = 4, .blockWidth = 4};
+    constexpr Format BC7Srgb{sizeof(u64) * 2, vkf::eBc7SrgbBlock, .blockHeight = 4, .blockWidth = 4};
+
     /**
      * @brief Converts a Vulkan format to a Skyline format
      */
@@ -96,6 +112,34 @@ namespace skyline::gpu::format {
                 return R16G16B16A16Uint;
             case vk::Format::eR16G16B16A16Sfloat:
                 return R16G16B16A16Float;
+            case vk::Format::eBc1RgbaUnormBlock:
+                return BC1Unorm;
+            case vk::Format::eBc1RgbaSrgbBlock:
+                return BC1Srgb;
+            case vk::Format::eBc2UnormBlock:
+                return BC2Unorm;
+            case vk::Format::eBc2SrgbBlock:
+                return BC2Srgb;
+            case vk::Format::eBc3UnormBlock:
+                return BC3Unorm;
+            case vk::Format::eBc3SrgbBlock:
+                return BC3Srgb;
+            case vk::Format::eBc4UnormBlock:
+                return BC4Unorm;
+            case vk::Format::eBc4SnormBlock:
+                return BC4Snorm;
+            case vk::Format::eBc5UnormBlock:
+                return BC5Unorm;
+            case vk::Format::eBc5SnormBlock:
+                return BC5Snorm;
+            case vk::Format::eBc6HUfloatBlock:
+                return BC6HUfloat;
+            case vk::Format::eBc6HSfloatBlock:
+                return BC6HSfloat;
+            case vk::Format::eBc7UnormBlock:
+                return BC7Unorm;
+            case vk::Format::eBc7SrgbBlock:
+                return BC7Srgb;
             default:
                 throw exception("Vulkan format not supported: '{}'", vk::to_string(format));
         }
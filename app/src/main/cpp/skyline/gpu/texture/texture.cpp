@@ -6,6 +6,7 @@
 #include <kernel/types/KProcess.h>
 #include "texture.h"
 #include "copy.h"
+#include "bc_decoder.h"
 
 namespace skyline::gpu {
     std::shared_ptr<memory::StagingBuffer> Texture::SynchronizeHostImpl(const std::shared_ptr<FenceCycle> &pCycle) {
@@ -39,12 +40,24 @@ namespace skyline::gpu {
             }
         }()};
 
+        // Compressed textures which the host can't sample are deswizzled into an intermediate buffer and decoded from it
+        bool decode{guest->format != format};
+        std::vector<u8> compressedBuffer;
+        u8 *linearData{bufferData};
+        if (decode) {
+            compressedBuffer.resize(guest->format->GetSize(dimensions));
+            linearData = compressedBuffer.data();
+        }
+
         if (guest->tileConfig.mode == texture::TileMode::Block)
-            CopyBlockLinearToLinear(*guest, pointer, bufferData);
+            CopyBlockLinearToLinear(*guest, pointer, linearData);
         else if (guest->tileConfig.mode == texture::TileMode::Pitch)
-            CopyPitchLinearToLinear(*guest, pointer, bufferData);
+            CopyPitchLinearToLinear(*guest, pointer, linearData);
         else if (guest->tileConfig.mode == texture::TileMode::Linear)
-            std::memcpy(bufferData, pointer, size);
+            std::memcpy(linearData, pointer, guest->format->GetSize(dimensions));
+
+        if (decode)
+            texture::bcn::Decode(guest->format, linearData, bufferData, dimensions);
 
         if (stagingBuffer && cycle.lock() != pCycle)
             WaitOnFence();
@@ -116,6 +129,11 @@ namespace skyline::gpu {
     }
 
     void Texture::CopyToGuest(u8 *hostBuffer) {
+        if (guest->format != format) {
+            Logger::Warn("Host -> Guest synchronization of textures decoded from '{}' isn't supported", vk::to_string(guest->format->vkFormat));
+            return;
+        }
+
         auto guestOutput{guest->mappings[0].data()};
         auto size{format->GetSize(dimensions)};
 
@@ -163,7 +181,7 @@ namespace skyline::gpu {
         : gpu(pGpu),
           guest(std::move(pGuest)),
           dimensions(guest->dimensions),
-          format(guest->format),
+          format((guest->format->IsCompressed() && !gpu.bcnSupported && texture::bcn::IsDecodable(guest->format)) ? texture::bcn::GetDecodedFormat(guest->format) : guest->format),
           layout(vk::ImageLayout::eUndefined),
           tiling((guest->tileConfig.mode == texture::TileMode::Block) ? vk::ImageTiling::eOptimal : vk::ImageTiling::eLinear),
           mipLevels(1),
@@ -171,13 +189,13 @@ namespace skyline::gpu {
           sampleCount(vk::SampleCountFlagBits::e1) {
         vk::ImageCreateInfo imageCreateInfo{
             .imageType = guest->dimensions.GetType(),
-            .format = *guest->format,
+            .format = *format,
             .extent = guest->dimensions,
             .mipLevels = 1,
             .arrayLayers = guest->layerCount,
             .samples = vk::SampleCountFlagBits::e1,
             .tiling = tiling,
-            .usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst,
+            .usage = (format->IsCompressed() ? vk::ImageUsageFlagBits::eSampled : vk::ImageUsageFlagBits::eColorAttachment) | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst, // Compressed formats can't be rendered to
             .sharingMode = vk::SharingMode::eExclusive,
             .queueFamilyIndexCount = 1,
             .pQueueFamilyIndices = &gpu.vkQueueFamilyIndex,
@@ -475,7 +493,7 @@ namespace skyline::gpu {
         vk::ImageViewCreateInfo createInfo{
             .image = backing->GetBacking(),
             .viewType = viewType,
-            .format = format ? *format : *backing->format,
+            .format = (format && format->IsCompatible(*backing->format)) ? *format : *backing->format, // Views of compressed textures that were decoded on the CPU must use the decoded format
             .components = mapping,
             .subresourceRange = range,
         };
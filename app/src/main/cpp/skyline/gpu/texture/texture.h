@@ -115,14 +115,29 @@ namespace skyline::gpu {
                 return (blockHeight != 1) || (blockWidth != 1);
             }
 
+            /**
+             * @return The amount of blocks that are required to cover the supplied width in pixels
+             */
+            constexpr u32 GetWidthBlocks(u32 width) const {
+                return (width + blockWidth - 1) / blockWidth;
+            }
+
+            /**
+             * @return The amount of blocks that are required to cover the supplied height in pixels
+             */
+            constexpr u32 GetHeightBlocks(u32 height) const {
+                return (height + blockHeight - 1) / blockHeight;
+            }
+
             /**
              * @param width The width of the texture in pixels
              * @param height The height of the texture in pixels
              * @param depth The depth of the texture in layers
              * @return The size of the texture in bytes
+             * @note Partial blocks at the edges of the texture are counted as whole blocks as they're stored in their entirety
              */
             constexpr size_t GetSize(u32 width, u32 height, u32 depth = 1) const {
-                return (((width / blockWidth) * (height / blockHeight)) * bpb) * depth;
+                return ((static_cast<size_t>(GetWidthBlocks(width)) * GetHeightBlocks(height)) * bpb) * depth;
             }
 
             constexpr size_t GetSize(Dimensions dimensions) const {
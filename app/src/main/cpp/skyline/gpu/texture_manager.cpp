@@ -6,7 +6,7 @@
 namespace skyline::gpu {
     TextureManager::TextureManager(GPU &gpu) : gpu(gpu) {}
 
-    TextureView TextureManager::FindOrCreate(const GuestTexture &guestTexture) {
+    std::optional<TextureView> TextureManager::Lookup(const GuestTexture &guestTexture) {
         auto guestMapping{guestTexture.mappings.front()};
 
         // Iterate over all textures that overlap with the first mapping of the guest texture and compare the mappings:
@@ -21,9 +21,7 @@ namespace skyline::gpu {
         // 4.2) If they aren't, we delete them from the map
         // 5) Create a new texture and insert it in the map then return it
 
-        std::scoped_lock lock(mutex);
-        std::shared_ptr<Texture> match{};
-        auto mappingEnd{std::upper_bound(textures.begin(), textures.end(), guestMapping)}, hostMapping{mappingEnd};
+        auto hostMapping{std::upper_bound(textures.begin(), textures.end(), guestMapping)};
         while (hostMapping != textures.begin() && (--hostMapping)->end() > guestMapping.begin()) {
             auto &hostMappings{hostMapping->texture->guest->mappings};
             if (!hostMapping->contains(guestMapping))
@@ -65,7 +63,22 @@ namespace skyline::gpu {
             } */
         }
 
+        return std::nullopt;
+    }
+
+    std::optional<TextureView> TextureManager::Find(const GuestTexture &guestTexture) {
+        std::scoped_lock lock(mutex);
+        return Lookup(guestTexture);
+    }
+
+    TextureView TextureManager::FindOrCreate(const GuestTexture &guestTexture) {
+        std::scoped_lock lock(mutex);
+        if (auto view{Lookup(guestTexture)})
+            return *view;
+
         // Create a texture as we cannot find one that matches
+        auto guestMapping{guestTexture.mappings.front()};
+        auto mappingEnd{std::upper_bound(textures.begin(), textures.end(), guestMapping)};
         auto texture{std::make_shared<Texture>(gpu, guestTexture)};
         auto it{texture->guest->mappings.begin()};
         textures.emplace(mappingEnd, TextureMapping{texture, it, guestMapping});
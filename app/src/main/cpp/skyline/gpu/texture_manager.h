@@ -30,6 +30,12 @@ namespace skyline::gpu {
         std::mutex mutex; //!< Synchronizes access to the texture mappings
         std::vector<TextureMapping> textures; //!< A sorted vector of all texture mappings
 
+        /**
+         * @return A view into a pre-existing Texture which matches the specified criteria
+         * @note The mutex must be locked prior to calling this
+         */
+        std::optional<TextureView> Lookup(const GuestTexture &guestTexture);
+
       public:
         TextureManager(GPU &gpu);
 
@@ -37,5 +43,10 @@ namespace skyline::gpu {
          * @return A pre-existing or newly created Texture object which matches the specified criteria
          */
         TextureView FindOrCreate(const GuestTexture &guestTexture);
+
+        /**
+         * @return A pre-existing Texture which matches the specified criteria or std::nullopt if the guest texture isn't resident on the host
+         */
+        std::optional<TextureView> Find(const GuestTexture &guestTexture);
     };
 }
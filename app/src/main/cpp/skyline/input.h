@@ -8,6 +8,7 @@
 #include "input/shared_mem.h"
 #include "input/npad.h"
 #include "input/touch.h"
+#include "input/sampler.h"
 
 namespace skyline::input {
     /**
@@ -23,12 +24,14 @@ namespace skyline::input {
 
         NpadManager npad;
         TouchManager touch;
+        InputSampler sampler; //!< Publishes host input to HID Shared Memory, this must be destroyed prior to any of the devices it samples
 
         Input(const DeviceState &state)
             : state(state),
               kHid(std::make_shared<kernel::type::KSharedMemory>(state, sizeof(HidSharedMemory))),
               hid(reinterpret_cast<HidSharedMemory *>(kHid->host.ptr)),
               npad(state, hid),
-              touch(state, hid) {}
+              touch(state, hid),
+              sampler(npad, touch, std::chrono::nanoseconds{std::chrono::seconds{1}} / std::max(state.settings->inputSamplingRate, 1U)) {}
     };
 }
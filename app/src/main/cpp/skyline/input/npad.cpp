@@ -106,4 +106,15 @@ namespace skyline::input {
                 controller.device = nullptr;
         }
     }
+
+    i64 NpadManager::UpdateSharedMemory() {
+        std::lock_guard guard(mutex);
+        if (!activated)
+            return 0;
+
+        i64 latency{};
+        for (auto &npad : npads)
+            latency = std::max(latency, npad.UpdateSharedMemory());
+        return latency;
+    }
 }
@@ -83,5 +83,11 @@ namespace skyline::input {
          * @brief Disables any activate mappings from guest controllers -> players till Activate has been called
          */
         void Deactivate();
+
+        /**
+         * @brief Publishes the latest host input of all connected NPads to HID Shared Memory
+         * @return The largest latency between host input and its publication of any NPad in nanoseconds, this is 0 if there was no pending input
+         */
+        i64 UpdateSharedMemory();
     };
 }
@@ -31,6 +31,11 @@ namespace skyline::input {
 
         section = {};
         controllerInfo = nullptr;
+        controllerState = {};
+        defaultState = {};
+        controllerLatched = {};
+        defaultLatched = {};
+        pendingInputTime = 0;
 
         connectionState = {.connected = true};
 
@@ -159,6 +164,11 @@ namespace skyline::input {
 
         section = {};
         globalTimestamp = 0;
+        controllerState = {};
+        defaultState = {};
+        controllerLatched = {};
+        defaultLatched = {};
+        pendingInputTime = 0;
 
         index = -1;
         partnerIndex = -1;
@@ -208,16 +218,23 @@ namespace skyline::input {
         return entry;
     }
 
+    void NpadDevice::LatchInput() {
+        controllerLatched.raw |= controllerState.buttons.raw;
+        defaultLatched.raw |= defaultState.buttons.raw;
+
+        if (!pendingInputTime)
+            pendingInputTime = util::GetTimeNs();
+    }
+
     void NpadDevice::SetButtonState(NpadButton mask, bool pressed) {
+        std::lock_guard guard(manager.mutex);
         if (!connectionState.connected)
             return;
 
-        auto &entry{GetNextEntry(*controllerInfo)};
-
         if (pressed)
-            entry.buttons.raw |= mask.raw;
+            controllerState.buttons.raw |= mask.raw;
         else
-            entry.buttons.raw &= ~mask.raw;
+            controllerState.buttons.raw &= ~mask.raw;
 
         if (manager.orientation == NpadJoyOrientation::Horizontal && (type == NpadControllerType::JoyconLeft || type == NpadControllerType::JoyconRight)) {
             NpadButton orientedMask{};
@@ -252,111 +269,130 @@ namespace skyline::input {
             mask = orientedMask;
         }
 
-        auto &defaultEntry{GetNextEntry(section.defaultController)};
         if (pressed)
-            defaultEntry.buttons.raw |= mask.raw;
+            defaultState.buttons.raw |= mask.raw;
         else
-            defaultEntry.buttons.raw &= ~mask.raw;
+            defaultState.buttons.raw &= ~mask.raw;
 
-        globalTimestamp++;
+        LatchInput();
     }
 
     void NpadDevice::SetAxisValue(NpadAxisId axis, i32 value) {
+        std::lock_guard guard(manager.mutex);
         if (!connectionState.connected)
             return;
 
-        auto &controllerEntry{GetNextEntry(*controllerInfo)};
-        auto &defaultEntry{GetNextEntry(section.defaultController)};
-
         constexpr i16 threshold{std::numeric_limits<i16>::max() / 2}; // A 50% deadzone for the stick buttons
 
         if (manager.orientation == NpadJoyOrientation::Vertical || (type != NpadControllerType::JoyconLeft && type != NpadControllerType::JoyconRight)) {
             switch (axis) {
                 case NpadAxisId::LX:
-                    controllerEntry.leftX = value;
-                    defaultEntry.leftX = value;
+                    controllerState.leftX = value;
+                    defaultState.leftX = value;
 
-                    controllerEntry.buttons.leftStickLeft = controllerEntry.leftX <= -threshold;
-                    defaultEntry.buttons.leftStickLeft = controllerEntry.buttons.leftStickLeft;
+                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                    defaultState.buttons.leftStickLeft = controllerState.buttons.leftStickLeft;
 
-                    controllerEntry.buttons.leftStickRight = controllerEntry.leftX >= threshold;
-                    defaultEntry.buttons.leftStickRight = controllerEntry.buttons.leftStickRight;
+                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
+                    defaultState.buttons.leftStickRight = controllerState.buttons.leftStickRight;
                     break;
                 case NpadAxisId::LY:
-                    controllerEntry.leftY = value;
-                    defaultEntry.leftY = value;
+                    controllerState.leftY = value;
+                    defaultState.leftY = value;
 
-                    defaultEntry.buttons.leftStickUp = controllerEntry.buttons.leftStickUp;
-                    controllerEntry.buttons.leftStickUp = controllerEntry.leftY >= threshold;
+                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+                    defaultState.buttons.leftStickUp = controllerState.buttons.leftStickUp;
 
-                    controllerEntry.buttons.leftStickDown = controllerEntry.leftY <= -threshold;
-                    defaultEntry.buttons.leftStickDown = controllerEntry.buttons.leftStickDown;
+                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
+                    defaultState.buttons.leftStickDown = controllerState.buttons.leftStickDown;
                     break;
                 case NpadAxisId::RX:
-                    controllerEntry.rightX = value;
-                    defaultEntry.rightX = value;
+                    controllerState.rightX = value;
+                    defaultState.rightX = value;
 
-                    controllerEntry.buttons.rightStickLeft = controllerEntry.rightX <= -threshold;
-                    defaultEntry.buttons.rightStickLeft = controllerEntry.buttons.rightStickLeft;
+                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                    defaultState.buttons.rightStickLeft = controllerState.buttons.rightStickLeft;
 
-                    controllerEntry.buttons.rightStickRight = controllerEntry.rightX >= threshold;
-                    defaultEntry.buttons.rightStickRight = controllerEntry.buttons.rightStickRight;
+                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
+                    defaultState.buttons.rightStickRight = controllerState.buttons.rightStickRight;
                     break;
                 case NpadAxisId::RY:
-                    controllerEntry.rightY = value;
-                    defaultEntry.rightY = value;
+                    controllerState.rightY = value;
+                    defaultState.rightY = value;
 
-                    controllerEntry.buttons.rightStickUp = controllerEntry.rightY >= threshold;
-                    defaultEntry.buttons.rightStickUp = controllerEntry.buttons.rightStickUp;
+                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                    defaultState.buttons.rightStickUp = controllerState.buttons.rightStickUp;
 
-                    controllerEntry.buttons.rightStickDown = controllerEntry.rightY <= -threshold;
-                    defaultEntry.buttons.rightStickDown = controllerEntry.buttons.rightStickDown;
+                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
+                    defaultState.buttons.rightStickDown = controllerState.buttons.rightStickDown;
                     break;
             }
         } else {
             switch (axis) {
                 case NpadAxisId::LX:
-                    controllerEntry.leftY = value;
-                    controllerEntry.buttons.leftStickUp = controllerEntry.leftY >= threshold;
-                    controllerEntry.buttons.leftStickDown = controllerEntry.leftY <= -threshold;
+                    controllerState.leftY = value;
+                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
 
-                    defaultEntry.leftX = value;
-                    defaultEntry.buttons.leftStickLeft = defaultEntry.leftX <= -threshold;
-                    defaultEntry.buttons.leftStickRight = defaultEntry.leftX >= threshold;
+                    defaultState.leftX = value;
+                    defaultState.buttons.leftStickLeft = defaultState.leftX <= -threshold;
+                    defaultState.buttons.leftStickRight = defaultState.leftX >= threshold;
                     break;
                 case NpadAxisId::LY:
-                    controllerEntry.leftX = -value;
-                    controllerEntry.buttons.leftStickLeft = controllerEntry.leftX <= -threshold;
-                    controllerEntry.buttons.leftStickRight = controllerEntry.leftX >= threshold;
+                    controllerState.leftX = -value;
+                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
 
-                    defaultEntry.leftY = value;
-                    defaultEntry.buttons.leftStickUp = defaultEntry.leftY >= threshold;
-                    defaultEntry.buttons.leftStickDown = defaultEntry.leftY <= -threshold;
+                    defaultState.leftY = value;
+                    defaultState.buttons.leftStickUp = defaultState.leftY >= threshold;
+                    defaultState.buttons.leftStickDown = defaultState.leftY <= -threshold;
                     break;
                 case NpadAxisId::RX:
-                    controllerEntry.rightY = value;
-                    controllerEntry.buttons.rightStickUp = controllerEntry.rightY >= threshold;
-                    controllerEntry.buttons.rightStickDown = controllerEntry.rightY <= -threshold;
+                    controllerState.rightY = value;
+                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
 
-                    defaultEntry.rightX = value;
-                    defaultEntry.buttons.rightStickLeft = defaultEntry.rightX <= -threshold;
-                    defaultEntry.buttons.rightStickRight = defaultEntry.rightX >= threshold;
+                    defaultState.rightX = value;
+                    defaultState.buttons.rightStickLeft = defaultState.rightX <= -threshold;
+                    defaultState.buttons.rightStickRight = defaultState.rightX >= threshold;
                     break;
                 case NpadAxisId::RY:
-                    controllerEntry.rightX = -value;
-                    controllerEntry.buttons.rightStickLeft = controllerEntry.rightX <= -threshold;
-                    controllerEntry.buttons.rightStickRight = controllerEntry.rightX >= threshold;
+                    controllerState.rightX = -value;
+                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
 
-                    defaultEntry.rightY = value;
-                    defaultEntry.buttons.rightStickUp = defaultEntry.rightY >= threshold;
-                    defaultEntry.buttons.rightStickDown = defaultEntry.rightY <= -threshold;
+                    defaultState.rightY = value;
+                    defaultState.buttons.rightStickUp = defaultState.rightY >= threshold;
+                    defaultState.buttons.rightStickDown = defaultState.rightY <= -threshold;
                     break;
             }
         }
 
+        LatchInput();
+    }
+
+    i64 NpadDevice::UpdateSharedMemory() {
+        if (!connectionState.connected)
+            return 0;
+
+        // Buttons that were pressed and released since the last tick are published as pressed for this tick, they'll be released on the next one
+        auto publish{[](NpadControllerState &entry, const NpadControllerState &state, NpadButton &latched) {
+            entry.buttons.raw = state.buttons.raw | std::exchange(latched, {}).raw;
+            entry.leftX = state.leftX;
+            entry.leftY = state.leftY;
+            entry.rightX = state.rightX;
+            entry.rightY = state.rightY;
+        }};
+        publish(GetNextEntry(*controllerInfo), controllerState, controllerLatched);
+        publish(GetNextEntry(section.defaultController), defaultState, defaultLatched);
         globalTimestamp++;
+
+        if (!pendingInputTime)
+            return 0;
+        return util::GetTimeNs() - std::exchange(pendingInputTime, 0);
     }
 
+
     constexpr jlong MsInSecond{1000}; //!< The amount of milliseconds in a single second of time
     constexpr jint AmplitudeMax{std::numeric_limits<u8>::max()}; //!< The maximum amplitude for Android Vibration APIs
 
@@ -116,6 +116,16 @@ namespace skyline::input {
         NpadSection &section; //!< The section in HID shared memory for this controller
         NpadControllerInfo *controllerInfo{}; //!< The NpadControllerInfo for this controller's type
         u64 globalTimestamp{}; //!< An incrementing timestamp that's common across all sections
+        NpadControllerState controllerState{}; //!< The latest host input for this controller's type, it's published to HID Shared Memory on the next sampling tick
+        NpadControllerState defaultState{}; //!< The latest host input for the default controller, see controllerState
+        NpadButton controllerLatched{}; //!< All buttons of controllerState that have been pressed since the last sampling tick, this ensures a press and release between two ticks isn't lost
+        NpadButton defaultLatched{}; //!< All buttons of defaultState that have been pressed since the last sampling tick, see controllerLatched
+        i64 pendingInputTime{}; //!< The time of the earliest host input that hasn't been published yet in nanoseconds, this is 0 if there's no pending input
+
+        /**
+         * @brief Latches all currently pressed buttons and marks the state as pending publication
+         */
+        void LatchInput();
 
         /**
          * @brief Updates the headers and creates a new entry in HID Shared Memory
@@ -164,6 +174,7 @@ namespace skyline::input {
          * @brief Changes the state of buttons to the specified state
          * @param mask A bit-field mask of all the buttons to change
          * @param pressed If the buttons were pressed or released
+         * @note The change is only visible to the guest after the next call to UpdateSharedMemory
          */
         void SetButtonState(NpadButton mask, bool pressed);
 
@@ -171,9 +182,17 @@ namespace skyline::input {
          * @brief Sets the value of an axis to the specified value
          * @param axis The axis to set the value of
          * @param value The value to set
+         * @note The change is only visible to the guest after the next call to UpdateSharedMemory
          */
         void SetAxisValue(NpadAxisId axis, i32 value);
 
+        /**
+         * @brief Publishes the latest host input as a new entry in HID Shared Memory, this is done once per sampling tick regardless of any input having changed
+         * @return The time between the earliest unpublished host input and its publication in nanoseconds, this is 0 if there was no pending input
+         * @note The manager's mutex must be locked prior to calling this
+         */
+        i64 UpdateSharedMemory();
+
         /**
          * @brief Sets the vibration for both the Joy-Cons to the specified vibration values
          */
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/trace.h>
+#include "sampler.h"
+
+namespace skyline::input {
+    InputSampler::InputSampler(NpadManager &npad, TouchManager &touch, std::chrono::nanoseconds period) : npad(npad), touch(touch), period(period), thread(&InputSampler::Run, this) {}
+
+    InputSampler::~InputSampler() {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        stopCondition.notify_all();
+        thread.join();
+    }
+
+    void InputSampler::Run() {
+        pthread_setname_np(pthread_self(), "Sampler");
+
+        auto nextTick{std::chrono::steady_clock::now()};
+        std::unique_lock lock(mutex);
+        while (!stopCondition.wait_until(lock, nextTick, [this] { return stop; })) {
+            lock.unlock();
+            {
+                TRACE_EVENT("input", "InputSampler::Tick");
+
+                i64 latency{std::max(npad.UpdateSharedMemory(), touch.UpdateSharedMemory())};
+                if (latency) {
+                    // An exponential moving average with a weight of 1/8 for the latest sample
+                    i64 average{averageLatency.load(std::memory_order_relaxed)};
+                    averageLatency.store(average ? average + (latency - average) / 8 : latency, std::memory_order_relaxed);
+                }
+            }
+            lock.lock();
+
+            // Ticks that were missed (such as due to the thread being descheduled) are dropped rather than being published in a burst
+            nextTick += period;
+            auto now{std::chrono::steady_clock::now()};
+            if (nextTick < now)
+                nextTick = now + period;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include "npad.h"
+#include "touch.h"
+
+namespace skyline::input {
+    /**
+     * @brief The InputSampler publishes host input to HID Shared Memory at a fixed rate, akin to the periodic sampling done by HID on the Switch
+     * @note Host input is coalesced into the latest state of every device between ticks with presses being latched until the next tick, exactly one entry is written per device per tick
+     */
+    class InputSampler {
+      private:
+        NpadManager &npad;
+        TouchManager &touch;
+        std::chrono::nanoseconds period; //!< The duration between consecutive sampling ticks
+        std::atomic<i64> averageLatency{}; //!< A moving average of the latency between host input and its publication in nanoseconds
+        std::mutex mutex; //!< Synchronizes the stop flag with the sampler thread
+        std::condition_variable stopCondition;
+        bool stop{};
+        std::thread thread;
+
+        void Run();
+
+      public:
+        static constexpr std::chrono::nanoseconds DefaultPeriod{std::chrono::milliseconds(5)}; //!< HID samples controllers at 200Hz
+
+        InputSampler(NpadManager &npad, TouchManager &touch, std::chrono::nanoseconds period = DefaultPeriod);
+
+        ~InputSampler();
+
+        /**
+         * @return A moving average of the time between host input being supplied and it being visible to the guest
+         */
+        std::chrono::nanoseconds GetAverageLatency() {
+            return std::chrono::nanoseconds{averageLatency.load(std::memory_order_relaxed)};
+        }
+    };
+}
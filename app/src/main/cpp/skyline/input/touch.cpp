@@ -9,24 +9,41 @@ namespace skyline::input {
     }
 
     void TouchManager::Activate() {
-        if (!activated) {
-            activated = true;
-            SetState({});
-        }
+        std::lock_guard guard(mutex);
+        activated = true;
     }
 
-    void TouchManager::SetState(const span<TouchScreenPoint> &points) {
+    void TouchManager::SetState(const span<TouchScreenPoint> &pPoints) {
+        std::lock_guard guard(mutex);
         if (!activated)
             return;
 
+        if (pPoints.empty() && pointCount && pendingInputTime) {
+            releasePending = true;
+            return;
+        }
+
+        releasePending = false;
+        pointCount = std::min(pPoints.size(), MaxPoints);
+        std::copy_n(pPoints.begin(), pointCount, points.begin());
+
+        if (!pendingInputTime)
+            pendingInputTime = util::GetTimeNs();
+    }
+
+    i64 TouchManager::UpdateSharedMemory() {
+        std::lock_guard guard(mutex);
+        if (!activated)
+            return 0;
+
         const auto &lastEntry{section.entries[section.header.currentEntry]};
         auto entryIndex{(section.header.currentEntry != constant::HidEntryCount - 1) ? section.header.currentEntry + 1 : 0};
         auto &entry{section.entries[entryIndex]};
         entry.globalTimestamp = lastEntry.globalTimestamp + 1;
         entry.localTimestamp = lastEntry.localTimestamp + 1;
-        entry.touchCount = points.size();
+        entry.touchCount = pointCount;
 
-        for (size_t i{}; i < points.size(); i++) {
+        for (size_t i{}; i < pointCount; i++) {
             const auto &host{points[i]};
             auto &guest{entry.data[i]};
             guest.index = static_cast<u32>(i);
@@ -41,5 +58,17 @@ namespace skyline::input {
         section.header.entryCount = std::min(static_cast<u8>(section.header.entryCount + 1), constant::HidEntryCount);
         section.header.maxEntry = section.header.entryCount;
         section.header.currentEntry = entryIndex;
+
+        if (!pendingInputTime)
+            return 0;
+
+        auto now{util::GetTimeNs()};
+        auto latency{now - std::exchange(pendingInputTime, 0)};
+        if (releasePending) {
+            releasePending = false;
+            pointCount = 0;
+            pendingInputTime = now;
+        }
+        return latency;
     }
 }
@@ -25,9 +25,16 @@ namespace skyline::input {
      */
     class TouchManager {
       private:
+        static constexpr size_t MaxPoints{std::tuple_size_v<decltype(TouchScreenState::data)>};
+
         const DeviceState &state;
+        std::mutex mutex; //!< Synchronizes the latest host input between the host input thread and the sampler
         bool activated{};
         TouchScreenSection &section;
+        std::array<TouchScreenPoint, MaxPoints> points{}; //!< The latest touch points from host input, they're published to HID Shared Memory on the next sampling tick
+        size_t pointCount{};
+        bool releasePending{}; //!< If all points were released before the latest points were published, the release is deferred to the tick after them so a short tap isn't lost
+        i64 pendingInputTime{}; //!< The time of the earliest host input that hasn't been published yet in nanoseconds, this is 0 if there's no pending input
 
       public:
         /**
@@ -37,6 +44,15 @@ namespace skyline::input {
 
         void Activate();
 
+        /**
+         * @note The points are only visible to the guest after the next call to UpdateSharedMemory, any points beyond the amount supported by HID are dropped
+         */
         void SetState(const span<TouchScreenPoint> &points);
+
+        /**
+         * @brief Publishes the latest touch points as a new entry in HID Shared Memory
+         * @return The time between the earliest unpublished host input and its publication in nanoseconds, this is 0 if there was no pending input
+         */
+        i64 UpdateSharedMemory();
     };
 }
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/signal.h>
+#include "types/KThread.h"
+#include "host_thread_pool.h"
+
+namespace skyline::kernel {
+    HostThreadPool::HostThreadPool(size_t workerCount) {
+        std::lock_guard lock(mutex);
+        workers.reserve(workerCount);
+        for (size_t index{}; index < workerCount; index++)
+            workers.emplace_back(&HostThreadPool::Worker, this);
+    }
+
+    HostThreadPool::~HostThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+
+        for (auto &worker : workers)
+            if (worker.joinable())
+                worker.join();
+    }
+
+    void HostThreadPool::Worker() {
+        pthread_setname_np(pthread_self(), WorkerName);
+        type::KThread::InstallSignalHandlers(); // The handlers are installed once per worker rather than for every guest thread it runs
+
+        std::unique_lock lock(mutex);
+        while (true) {
+            idleWorkers++;
+            condition.wait(lock, [this] { return stop || !pending.empty(); });
+            idleWorkers--;
+            if (pending.empty())
+                return;
+
+            auto thread{std::move(pending.front())};
+            pending.pop_front();
+            lock.unlock();
+
+            // A guest thread that was killed could have left SIGINT blocked and pending on this host thread, it's discarded so it doesn't kill the next guest thread
+            sigset_t interruptSet{};
+            sigaddset(&interruptSet, SIGINT);
+            constexpr timespec NoTimeout{};
+            while (sigtimedwait(&interruptSet, nullptr, &NoTimeout) == SIGINT);
+            signal::UnblockSignal({SIGINT});
+
+            Scheduler::YieldPending = false; // Any yield that was pending was meant for the previous guest thread
+            Logger::UpdateTag(fmt::format("HOS-{}", thread->id)); // Only the log tag is updated as renaming the host thread requires a syscall
+            thread->StartThread();
+            Logger::UpdateTag(WorkerName);
+
+            DeviceState::thread = nullptr;
+            DeviceState::ctx = nullptr;
+            thread = nullptr;
+
+            lock.lock();
+        }
+    }
+
+    void HostThreadPool::Run(std::shared_ptr<type::KThread> thread) {
+        std::lock_guard lock(mutex);
+        pending.push_back(std::move(thread));
+        if (pending.size() > idleWorkers)
+            workers.emplace_back(&HostThreadPool::Worker, this); // The new worker will pick up the thread as soon as it's started
+        else
+            condition.notify_one();
+    }
+}
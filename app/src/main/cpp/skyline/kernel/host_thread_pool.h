@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include <common.h>
+
+namespace skyline::kernel {
+    /**
+     * @brief A pool of host threads which guest threads are run on, this avoids creating a host thread and installing its signal handlers for every guest thread that is started
+     * @note Host threads are returned to the pool when the guest thread they were running exits, they're only destroyed alongside the pool
+     */
+    class HostThreadPool {
+      private:
+        static constexpr const char *WorkerName{"GuestPool"}; //!< The name of the host thread of all workers
+
+        std::mutex mutex; //!< Synchronizes all operations on the pending queue and the workers
+        std::condition_variable condition; //!< Signalled when a guest thread is queued or when the pool is being destroyed
+        std::deque<std::shared_ptr<type::KThread>> pending; //!< A queue of guest threads which are yet to be picked up by a worker
+        std::vector<std::thread> workers;
+        size_t idleWorkers{}; //!< The amount of workers which are waiting for a guest thread to run
+        bool stop{};
+
+        /**
+         * @brief The entry point of a worker, it runs guest threads from the pending queue until the pool is destroyed
+         */
+        void Worker();
+
+      public:
+        static constexpr size_t PrewarmedWorkerCount{8}; //!< The amount of workers created upfront, this covers the threads most titles create during startup
+
+        HostThreadPool(size_t workerCount = PrewarmedWorkerCount);
+
+        /**
+         * @note All guest threads must have exited prior to this as it joins all workers
+         */
+        ~HostThreadPool();
+
+        /**
+         * @brief Runs the supplied guest thread on an idle worker, a new worker is created if there are none
+         */
+        void Run(std::shared_ptr<type::KThread> thread);
+    };
+}
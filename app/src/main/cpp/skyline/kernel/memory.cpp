@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <common/settings.h>
 #include "memory.h"
 #include "types/KProcess.h"
 
@@ -131,6 +132,17 @@ namespace skyline::kernel {
         if (size > code.size)
             throw exception("Code region ({}) is smaller than mapped code size ({})", code.size, size);
 
+        if (state.settings->hugePages) {
+            // All regions are aligned to RegionAlignment which is a multiple of the huge page size, large guest heaps otherwise incur a lot of TLB pressure as guest code runs on host page tables
+            static_assert(RegionAlignment % HugePageSize == 0);
+            for (const auto &region : {code, alias, heap}) {
+                if (!AdviseHugePages(span(reinterpret_cast<u8 *>(region.address), region.size))) {
+                    Logger::Warn("Cannot back guest memory with huge pages: {}", strerror(errno)); // The kernel may not support THP, this isn't fatal
+                    break;
+                }
+            }
+        }
+
         Logger::Debug("Region Map:\nVMM Base: 0x{:X}\nCode Region: 0x{:X} - 0x{:X} (Size: 0x{:X})\nAlias Region: 0x{:X} - 0x{:X} (Size: 0x{:X})\nHeap Region: 0x{:X} - 0x{:X} (Size: 0x{:X})\nStack Region: 0x{:X} - 0x{:X} (Size: 0x{:X})\nTLS/IO Region: 0x{:X} - 0x{:X} (Size: 0x{:X})", base.address, code.address, code.address + code.size, code.size, alias.address, alias.address + alias.size, alias.size, heap.address, heap
             .address + heap.size, heap.size, stack.address, stack.address + stack.size, stack.size, tlsIo.address, tlsIo.address + tlsIo.size, tlsIo.size);
     }
@@ -198,6 +210,49 @@ namespace skyline::kernel {
         return std::nullopt;
     }
 
+    std::vector<ChunkDescriptor> MemoryManager::GetChunks() {
+        std::shared_lock lock(mutex);
+        return chunks;
+    }
+
+    bool MemoryManager::AdviseHugePages(span<u8> memory) {
+        // Any parts of the range which later have their protection changed are split into regular pages by the kernel, so reprotecting a range never needs to be aligned to huge pages
+        return madvise(memory.data(), memory.size(), MADV_HUGEPAGE) == 0;
+    }
+
+    void MemoryManager::FreeMemory(span<u8> memory) {
+        // The guest address space is a private anonymous mapping, so MADV_DONTNEED drops the pages and any access after this faults in zeroed pages
+        if (!memory.empty() && madvise(memory.data(), memory.size(), MADV_DONTNEED) < 0)
+            throw exception("An error occurred while freeing memory: {} with 0x{:X} @ 0x{:X}", strerror(errno), memory.size(), memory.data());
+    }
+
+    size_t MemoryManager::GetResidentSize(span<u8> memory) {
+        constexpr size_t BatchPageCount{0x1000}; //!< The amount of pages queried by a single mincore call
+        std::array<unsigned char, BatchPageCount> residency;
+
+        size_t residentSize{};
+        for (size_t offset{}; offset < memory.size(); offset += BatchPageCount * PAGE_SIZE) {
+            size_t batchSize{std::min(memory.size() - offset, BatchPageCount * PAGE_SIZE)};
+            if (mincore(memory.data() + offset, batchSize, residency.data()) < 0)
+                throw exception("An error occurred while querying memory residency: {} with 0x{:X} @ 0x{:X}", strerror(errno), batchSize, memory.data() + offset);
+
+            size_t pageCount{util::AlignUp(batchSize, PAGE_SIZE) / PAGE_SIZE};
+            for (size_t page{}; page < pageCount; page++)
+                if (residency[page] & 1)
+                    residentSize += PAGE_SIZE;
+        }
+        return residentSize;
+    }
+
+    size_t MemoryManager::GetResidentHeapSize() {
+        std::shared_lock lock(mutex);
+        size_t size{};
+        for (const auto &chunk : chunks)
+            if (chunk.state == memory::states::Heap)
+                size += GetResidentSize(span(chunk.ptr, chunk.size));
+        return size;
+    }
+
     size_t MemoryManager::GetUserMemoryUsage() {
         std::shared_lock lock(mutex);
         size_t size{};
@@ -218,6 +218,8 @@ namespace skyline {
             std::vector<ChunkDescriptor> chunks;
 
           public:
+            static constexpr size_t HugePageSize{1ULL << 21}; //!< The size of a transparent huge page on the host (2MiB with 4KiB pages)
+
             memory::Region addressSpace{}; //!< The entire address space
             memory::Region base{}; //!< The application-accessible address space
             memory::Region code{};
@@ -243,6 +245,33 @@ namespace skyline {
 
             std::optional<ChunkDescriptor> Get(void *ptr);
 
+            /**
+             * @return A copy of all chunks in the address space sorted by their address
+             */
+            std::vector<ChunkDescriptor> GetChunks();
+
+            /**
+             * @brief Advises the kernel to back the supplied range of guest memory with transparent huge pages wherever it's aligned to HugePageSize
+             * @return If the advice was accepted, this is false if the kernel doesn't support THP
+             */
+            static bool AdviseHugePages(span<u8> memory);
+
+            /**
+             * @brief Releases the host pages backing the supplied page-aligned range of guest memory
+             * @note The range will be zero-filled on its next access as HOS expects of any newly mapped memory
+             */
+            static void FreeMemory(span<u8> memory);
+
+            /**
+             * @return The amount of bytes in the supplied page-aligned range of guest memory which are resident in host memory
+             */
+            static size_t GetResidentSize(span<u8> memory);
+
+            /**
+             * @return The cumulative size of all heap (Physical Memory + Process Heap) memory mappings that is resident in host memory in bytes
+             */
+            size_t GetResidentHeapSize();
+
             /**
              * @return The cumulative size of all heap (Physical Memory + Process Heap) memory mappings, the code region and the main thread stack in bytes
              */
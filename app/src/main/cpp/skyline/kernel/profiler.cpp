@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cxxabi.h>
+#include <fstream>
+#include <common/signal.h>
+#include <common/trace.h>
+#include <loader/loader.h>
+#include "types/KProcess.h"
+#include "profiler.h"
+
+namespace skyline::kernel {
+    void Profiler::ThreadBuffer::Push(u64 pc) {
+        size_t write{writeIndex.load(std::memory_order_relaxed)};
+        if (write - readIndex.load(std::memory_order_acquire) == Size) {
+            droppedSamples.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        samples[write & (Size - 1)] = pc;
+        writeIndex.store(write + 1, std::memory_order_release);
+    }
+
+    Profiler::Profiler(const DeviceState &state, std::string path, std::chrono::nanoseconds interval) : state(state), path(std::move(path)), interval(interval), thread(&Profiler::Run, this) {
+        Logger::Info("Profiling guest code to {}", this->path);
+    }
+
+    Profiler::~Profiler() {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        stopCondition.notify_all();
+        thread.join();
+
+        // All guest threads have exited at this point, so all buffers have been released and can be freed
+        ReleaseExitedBuffers();
+
+        Write();
+    }
+
+    void Profiler::SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls) {
+        auto &thread{DeviceState::thread};
+        auto buffer{thread ? thread->profilerBuffer.load(std::memory_order_acquire) : nullptr};
+        if (buffer)
+            buffer->Push(*tls ? ctx->uc_mcontext.pc : 0); // The TLS is only set while the thread is running guest code
+    }
+
+    void Profiler::ReleaseThreadBuffer(type::KThread &thread) {
+        if (auto buffer{thread.profilerBuffer.exchange(nullptr, std::memory_order_acq_rel)})
+            buffer->released.store(true, std::memory_order_release);
+    }
+
+    void Profiler::Run() {
+        pthread_setname_np(pthread_self(), "Profiler");
+
+        auto nextTick{std::chrono::steady_clock::now()};
+        std::unique_lock lock(mutex);
+        while (!stopCondition.wait_until(lock, nextTick += interval, [this] { return stop; })) {
+            lock.unlock();
+            {
+                TRACE_EVENT("kernel", "Profiler::Sample");
+
+                // Buffers are released before new ones are registered, as a thread which exited could be restarted or another thread could be allocated at the same address
+                ReleaseExitedBuffers();
+
+                // Only threads which are scheduled on a core are sampled as the rest aren't running any guest code
+                for (const auto &runningThread : state.scheduler->GetRunningThreads()) {
+                    auto &buffer{buffers[runningThread.get()]};
+                    if (!buffer) {
+                        std::lock_guard statusLock(runningThread->statusMutex);
+                        if (!runningThread->running)
+                            continue; // The thread has exited, it'd never release a buffer that's registered now
+                        buffer = std::make_unique<ThreadBuffer>();
+                        runningThread->profilerBuffer.store(buffer.get(), std::memory_order_release);
+                    }
+                    runningThread->SendSignal(ProfilerSignal);
+                }
+
+                for (auto &[sampledThread, buffer] : buffers)
+                    Drain(*buffer);
+            }
+            lock.lock();
+
+            // Ticks that were missed are dropped rather than being sampled in a burst
+            auto now{std::chrono::steady_clock::now()};
+            if (nextTick < now)
+                nextTick = now;
+        }
+    }
+
+    void Profiler::Drain(ThreadBuffer &buffer) {
+        size_t read{buffer.readIndex.load(std::memory_order_relaxed)}, write{buffer.writeIndex.load(std::memory_order_acquire)};
+        for (; read != write; read++)
+            samples[buffer.samples[read & (ThreadBuffer::Size - 1)]]++;
+        buffer.readIndex.store(read, std::memory_order_release);
+    }
+
+    void Profiler::ReleaseExitedBuffers() {
+        std::erase_if(buffers, [this](const auto &entry) {
+            auto &buffer{*entry.second};
+            if (!buffer.released.load(std::memory_order_acquire))
+                return false;
+
+            Drain(buffer);
+            droppedSamples += buffer.droppedSamples.load(std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    void Profiler::Write() {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            Logger::Warn("Cannot open guest profile file: {}", path);
+            return;
+        }
+
+        auto symbolize{[&](u64 address) {
+            if (!address)
+                return std::string{"[Host]"};
+
+            std::string name;
+            auto symbol{state.loader->ResolveSymbol(reinterpret_cast<void *>(address))};
+            if (symbol.name) {
+                int status{};
+                std::unique_ptr<char, decltype(&std::free)> demangled{abi::__cxa_demangle(symbol.name, nullptr, nullptr, &status), std::free};
+                name = (status == 0) ? demangled.get() : symbol.name;
+            } else if (!symbol.executableName.empty()) {
+                name = fmt::format("{}!0x{:X}", symbol.executableName, address);
+            } else {
+                name = fmt::format("0x{:X}", address);
+            }
+            std::replace(name.begin(), name.end(), ';', ':'); // Semicolons are used to delimit frames in folded stacks
+            return name;
+        }};
+
+        // Samples of different PCs inside the same function are merged into a single entry
+        std::map<std::string, u64> functions;
+        u64 sampleCount{};
+        for (const auto &[pc, count] : samples) {
+            functions[symbolize(pc)] += count;
+            sampleCount += count;
+        }
+
+        for (const auto &[function, count] : functions)
+            file << function << ' ' << count << '\n';
+
+        Logger::Info("Wrote {} guest profile samples to {} ({} dropped)", sampleCount, path, droppedSamples);
+    }
+}
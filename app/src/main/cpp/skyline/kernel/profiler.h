@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include <common.h>
+
+namespace skyline::kernel {
+    /**
+     * @brief A sampling profiler for guest code, it periodically interrupts all running guest threads to record their PC
+     * @note The samples are symbolized and written out as folded stacks of a single frame when the profiler is destroyed, these can be consumed by flamegraph.pl or any other tool that accepts them
+     */
+    class Profiler {
+      public:
+        inline static int ProfilerSignal{SIGRTMIN + 2}; //!< The signal used to interrupt guest threads to sample them
+        static constexpr std::chrono::nanoseconds DefaultInterval{std::chrono::milliseconds(1)};
+
+        /**
+         * @brief A lock-free single-producer single-consumer ring buffer of samples for a single thread
+         * @note Samples are produced by the signal handler on the thread and consumed by the profiler thread
+         * @note A sample is the raw guest PC of the thread, a sample of 0 denotes the thread being in host code
+         */
+        struct ThreadBuffer {
+            static constexpr size_t Size{1 << 12}; //!< The amount of samples in the buffer, this must be a power of two
+            std::array<u64, Size> samples;
+            std::atomic<size_t> writeIndex{}; //!< The index of the next sample to be written, this is never wrapped around
+            std::atomic<size_t> readIndex{}; //!< The index of the next sample to be read, this is never wrapped around
+            std::atomic<u32> droppedSamples{}; //!< The amount of samples that have been dropped due to the buffer being full
+            std::atomic_bool released{}; //!< If the thread has exited and won't push any more samples, the buffer can be freed after it has been drained
+
+            /**
+             * @brief Pushes a sample into the buffer or drops it if there isn't enough space for it
+             * @note This must only be called from the thread that the buffer belongs to, it's async-signal-safe
+             */
+            void Push(u64 pc);
+        };
+
+      private:
+        const DeviceState &state;
+        std::string path; //!< The path of the file the folded stacks are written to
+        std::chrono::nanoseconds interval; //!< The duration between sampling all running threads
+        std::unordered_map<type::KThread *, std::unique_ptr<ThreadBuffer>> buffers; //!< The buffers of all threads that are being sampled, these are only accessed by the profiler thread
+        std::unordered_map<u64, u64> samples; //!< The amount of samples of every unique PC
+        u64 droppedSamples{}; //!< The amount of samples dropped by the buffers of threads that have exited
+        std::mutex mutex; //!< Synchronizes the stop flag with the profiler thread
+        std::condition_variable stopCondition;
+        bool stop{};
+        std::thread thread;
+
+        void Run();
+
+        /**
+         * @brief Consumes all samples in the supplied buffer and aggregates them by their PC
+         */
+        void Drain(ThreadBuffer &buffer);
+
+        /**
+         * @brief Drains and frees the buffers of all threads that have exited since the last call
+         */
+        void ReleaseExitedBuffers();
+
+        /**
+         * @brief Symbolizes all aggregated PCs and writes them out as folded stacks
+         */
+        void Write();
+
+      public:
+        /**
+         * @param path The path of the file to write the folded stacks to, any existing file is overwritten
+         */
+        Profiler(const DeviceState &state, std::string path, std::chrono::nanoseconds interval = DefaultInterval);
+
+        /**
+         * @note This must only be called after all guest threads have exited as their signal handlers may still be writing into the buffers otherwise
+         */
+        ~Profiler();
+
+        /**
+         * @brief Records the raw PC of the interrupted thread into its buffer, resolving it is deferred to the profiler thread as guest memory can't be inspected in an async-signal-safe manner
+         */
+        static void SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls);
+
+        /**
+         * @brief Marks the buffer of the supplied thread as released, the profiler thread frees it after consuming its remaining samples
+         * @note This must be called with the thread's status mutex locked on it exiting, so the profiler cannot register a new buffer for the exited thread
+         */
+        static void ReleaseThreadBuffer(type::KThread &thread);
+    };
+}
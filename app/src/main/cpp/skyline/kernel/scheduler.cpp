@@ -10,14 +10,33 @@
 namespace skyline::kernel {
     Scheduler::CoreContext::CoreContext(u8 id, i8 preemptionPriority) : id(id), preemptionPriority(preemptionPriority) {}
 
-    Scheduler::Scheduler(const DeviceState &state) : state(state) {}
+    Scheduler::Scheduler(const DeviceState &state) : state(state) {
+        for (auto &core : cores)
+            preemptionThreads.at(core.id) = std::thread(&Scheduler::PreemptionThread, this, std::ref(core));
+    }
+
+    Scheduler::~Scheduler() {
+        preemptionStop = true;
+        for (auto &core : cores) {
+            std::lock_guard lock(core.preemptionMutex);
+            core.preemptionCondition.notify_all();
+        }
+
+        for (auto &thread : preemptionThreads)
+            if (thread.joinable())
+                thread.join();
+    }
 
     void Scheduler::SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls) {
         if (*tls) {
-            TRACE_EVENT_END("guest");
             const auto &state{*reinterpret_cast<nce::ThreadContext *>(*tls)->state};
-            if (signal == PreemptionSignal)
+            if (signal == PreemptionSignal) {
+                if (!state.thread->isPreempted || std::chrono::steady_clock::now() < state.thread->preemptionDeadline)
+                    return; // The timeslice was disarmed or rearmed after the preemption thread sent the signal, it's stale and should be ignored
                 state.thread->isPreempted = false;
+            }
+
+            TRACE_EVENT_END("guest");
             state.scheduler->Rotate(false);
             YieldPending = false;
             state.scheduler->WaitSchedule();
@@ -27,7 +46,7 @@ namespace skyline::kernel {
         }
     }
 
-    Scheduler::CoreContext &Scheduler::GetOptimalCoreForThread(const std::shared_ptr<type::KThread> &thread) {
+    Scheduler::CoreContext &Scheduler::GetOptimalCoreForThread(type::KThread *thread) {
         auto *currentCore{&cores.at(thread->coreId)};
 
         if (!currentCore->queue.empty() && thread->affinityMask.count() != 1) {
@@ -82,7 +101,7 @@ namespace skyline::kernel {
         return *currentCore;
     }
 
-    void Scheduler::InsertThread(const std::shared_ptr<type::KThread> &thread) {
+    void Scheduler::InsertThread(type::KThread *thread) {
         auto &core{cores.at(thread->coreId)};
         std::unique_lock lock(core.mutex);
         auto nextThread{std::upper_bound(core.queue.begin(), core.queue.end(), thread->priority.load(), type::KThread::IsHigherPriority)};
@@ -96,7 +115,7 @@ namespace skyline::kernel {
                 core.queue.splice(std::upper_bound(core.queue.begin(), core.queue.end(), front->priority.load(), type::KThread::IsHigherPriority), core.queue, core.queue.begin());
                 core.queue.push_front(thread);
 
-                if (state.thread != front) {
+                if (state.thread.get() != front) {
                     // If the calling thread isn't at the front, we need to send it an OS signal to yield
                     if (!front->pendingYield) {
                         // We only want to yield the thread if it hasn't already been sent a signal to yield in the past
@@ -112,14 +131,14 @@ namespace skyline::kernel {
             } else {
                 core.queue.push_front(thread);
             }
-            if (thread != state.thread)
+            if (thread != state.thread.get())
                 thread->scheduleCondition.notify_one(); // We only want to trigger the conditional variable if the current thread isn't inserting itself
         } else {
             core.queue.insert(nextThread, thread);
         }
     }
 
-    void Scheduler::MigrateToCore(const std::shared_ptr<type::KThread> &thread, CoreContext *&currentCore, CoreContext *targetCore, std::unique_lock<std::mutex> &lock) {
+    void Scheduler::MigrateToCore(type::KThread *thread, CoreContext *&currentCore, CoreContext *targetCore, std::unique_lock<std::mutex> &lock) {
         // We need to check if the thread was in its resident core's queue
         // If it was, we need to remove it from the queue
         auto it{std::find(currentCore->queue.begin(), currentCore->queue.end(), thread)};
@@ -140,8 +159,60 @@ namespace skyline::kernel {
         lock = std::unique_lock(targetCore->mutex);
     }
 
+    void Scheduler::PreemptionThread(CoreContext &core) {
+        pthread_setname_np(pthread_self(), fmt::format("Preempt-{}", core.id).c_str());
+
+        std::unique_lock lock(core.preemptionMutex);
+        auto reportTime{std::chrono::steady_clock::now() + PreemptionStatisticsInterval};
+        while (!preemptionStop) {
+            auto now{std::chrono::steady_clock::now()};
+            if (core.preemptionThread && now >= core.preemptionDeadline) {
+                // The signal is sent while holding the preemption mutex so the timeslice cannot be disarmed before the signal has been queued
+                TRACE_EVENT("scheduler", "Preempt");
+                std::exchange(core.preemptionThread, nullptr)->SendSignal(PreemptionSignal);
+                core.preemptionSyscalls++;
+            }
+
+            if (now >= reportTime) {
+                if (core.timesliceUpdates)
+                    Logger::Debug("C{} Preemption: {} syscalls/s ({} syscalls/s with per-thread timers)", core.id, core.preemptionSyscalls, core.timesliceUpdates);
+                core.timesliceUpdates = 0;
+                core.preemptionSyscalls = 0;
+                reportTime = now + PreemptionStatisticsInterval;
+            }
+
+            // We only wake up for the deadline of the armed timeslice, a timeslice that is armed later doesn't require waking this thread as it'll be rechecked on waking up
+            core.preemptionWakeTime = core.preemptionThread ? std::min(core.preemptionDeadline, reportTime) : reportTime;
+            core.preemptionCondition.wait_until(lock, core.preemptionWakeTime);
+            core.preemptionSyscalls++;
+        }
+    }
+
+    void Scheduler::ArmPreemption(CoreContext &core, type::KThread *thread) {
+        std::lock_guard lock(core.preemptionMutex);
+        core.preemptionThread = thread;
+        core.preemptionDeadline = std::chrono::steady_clock::now() + PreemptiveTimeslice;
+        thread->preemptionDeadline = core.preemptionDeadline;
+        thread->isPreempted = true;
+        core.timesliceUpdates++;
+
+        if (core.preemptionDeadline < core.preemptionWakeTime)
+            core.preemptionCondition.notify_one(); // We only need to wake the preemption thread if it would otherwise wake up after the deadline
+    }
+
+    void Scheduler::DisarmPreemption(CoreContext &core, type::KThread *thread) {
+        if (!thread->isPreempted)
+            return;
+
+        std::lock_guard lock(core.preemptionMutex);
+        if (core.preemptionThread == thread)
+            core.preemptionThread = nullptr; // The preemption thread will notice the timeslice was disarmed when it wakes up, there's no need to wake it
+        thread->isPreempted = false;
+        core.timesliceUpdates++;
+    }
+
     void Scheduler::WaitSchedule(bool loadBalance) {
-        auto &thread{state.thread};
+        auto thread{state.thread.get()};
         CoreContext *core{&cores.at(thread->coreId)};
         std::unique_lock lock(core->mutex);
 
@@ -162,7 +233,7 @@ namespace skyline::kernel {
             while (!thread->scheduleCondition.wait_for(lock, loadBalanceThreshold, wakeFunction)) {
                 lock.unlock(); // We cannot call GetOptimalCoreForThread without relinquishing the core mutex
                 std::lock_guard migrationLock(thread->coreMigrationMutex);
-                auto newCore{&GetOptimalCoreForThread(state.thread)};
+                auto newCore{&GetOptimalCoreForThread(thread)};
                 lock.lock();
                 if (core != newCore)
                     MigrateToCore(thread, core, newCore, lock);
@@ -174,14 +245,14 @@ namespace skyline::kernel {
         }
 
         if (thread->priority == core->preemptionPriority)
-            // If the thread needs to be preempted then arm its preemption timer
-            thread->ArmPreemptionTimer(PreemptiveTimeslice);
+            // If the thread needs to be preempted then arm its timeslice
+            ArmPreemption(*core, thread);
 
         thread->timesliceStart = util::GetTimeTicks();
     }
 
     bool Scheduler::TimedWaitSchedule(std::chrono::nanoseconds timeout) {
-        auto &thread{state.thread};
+        auto thread{state.thread.get()};
         auto *core{&cores.at(thread->coreId)};
 
         TRACE_EVENT("scheduler", "TimedWaitSchedule");
@@ -194,7 +265,7 @@ namespace skyline::kernel {
             return !core->queue.empty() && core->queue.front() == thread;
         })) {
             if (thread->priority == core->preemptionPriority)
-                thread->ArmPreemptionTimer(PreemptiveTimeslice);
+                ArmPreemption(*core, thread);
 
             thread->timesliceStart = util::GetTimeTicks();
 
@@ -205,7 +276,7 @@ namespace skyline::kernel {
     }
 
     void Scheduler::Rotate(bool cooperative) {
-        auto &thread{state.thread};
+        auto thread{state.thread.get()};
         auto &core{cores.at(thread->coreId)};
 
         std::unique_lock lock(core.mutex);
@@ -225,13 +296,13 @@ namespace skyline::kernel {
 
         thread->averageTimeslice = (thread->averageTimeslice / 4) + (3 * (util::GetTimeTicks() - thread->timesliceStart / 4));
 
-        thread->DisarmPreemptionTimer(); // If a preemptive thread did a cooperative yield then we need to disarm the preemptive timer
+        DisarmPreemption(core, thread); // If a preemptive thread did a cooperative yield then we need to disarm its timeslice
         thread->pendingYield = false;
         thread->forceYield = false;
     }
 
     void Scheduler::RemoveThread() {
-        auto &thread{state.thread};
+        auto thread{state.thread.get()};
         auto &core{cores.at(thread->coreId)};
         {
             std::unique_lock lock(core.mutex);
@@ -249,13 +320,13 @@ namespace skyline::kernel {
             }
         }
 
-        thread->DisarmPreemptionTimer();
+        DisarmPreemption(core, thread);
         thread->pendingYield = false;
         thread->forceYield = false;
         YieldPending = false;
     }
 
-    void Scheduler::UpdatePriority(const std::shared_ptr<type::KThread> &thread) {
+    void Scheduler::UpdatePriority(type::KThread *thread) {
         std::lock_guard migrationLock(thread->coreMigrationMutex);
         auto *core{&cores.at(thread->coreId)};
         std::unique_lock coreLock(core->mutex);
@@ -271,11 +342,11 @@ namespace skyline::kernel {
                     thread->pendingYield = true;
                 }
             } else if (!thread->isPreempted && thread->priority == core->preemptionPriority) {
-                // If the thread needs to be preempted due to its new priority then arm its preemption timer
-                thread->ArmPreemptionTimer(PreemptiveTimeslice);
+                // If the thread needs to be preempted due to its new priority then arm its timeslice
+                ArmPreemption(*core, thread);
             } else if (thread->isPreempted && thread->priority != core->preemptionPriority) {
-                // If the thread no longer needs to be preempted due to its new priority then disarm its preemption timer
-                thread->DisarmPreemptionTimer();
+                // If the thread no longer needs to be preempted due to its new priority then disarm its timeslice
+                DisarmPreemption(*core, thread);
             }
         } else if (thread->priority < (*std::prev(currentIt))->priority || (nextIt != core->queue.end() && thread->priority > (*nextIt)->priority)) {
             // If the thread is in the queue and it's position is affected by the priority change then need to remove and re-insert the thread
@@ -295,7 +366,7 @@ namespace skyline::kernel {
         }
     }
 
-    void Scheduler::UpdateCore(const std::shared_ptr<type::KThread> &thread) {
+    void Scheduler::UpdateCore(type::KThread *thread) {
         auto *core{&cores.at(thread->coreId)};
         std::lock_guard coreLock(core->mutex);
         if (core->queue.front() == thread)
@@ -304,8 +375,18 @@ namespace skyline::kernel {
             thread->scheduleCondition.notify_one();
     }
 
+    std::vector<std::shared_ptr<type::KThread>> Scheduler::GetRunningThreads() {
+        std::vector<std::shared_ptr<type::KThread>> threads;
+        for (auto &core : cores) {
+            std::lock_guard lock(core.mutex);
+            if (!core.queue.empty())
+                threads.push_back(core.queue.front()->shared_from_this());
+        }
+        return threads;
+    }
+
     void Scheduler::ParkThread() {
-        auto &thread{state.thread};
+        auto thread{state.thread.get()};
         std::lock_guard migrationLock(thread->coreMigrationMutex);
         RemoveThread();
 
@@ -327,7 +408,7 @@ namespace skyline::kernel {
     void Scheduler::WakeParkedThread() {
         std::unique_lock parkedLock(parkedMutex);
         if (!parkedQueue.empty()) {
-            auto &thread{state.thread};
+            auto thread{state.thread.get()};
             auto &core{cores.at(thread->coreId)};
             std::unique_lock coreLock(core.mutex);
             auto nextThread{core.queue.size() > 1 ? *std::next(core.queue.begin()) : nullptr};
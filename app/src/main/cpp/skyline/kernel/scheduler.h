@@ -47,31 +47,61 @@ namespace skyline {
                 u8 id;
                 i8 preemptionPriority; //!< The priority at which this core becomes preemptive as opposed to cooperative
                 std::mutex mutex; //!< Synchronizes all operations on the queue
-                std::list<std::shared_ptr<type::KThread>> queue; //!< A queue of threads which are running or to be run on this core
+                std::list<type::KThread *> queue; //!< A queue of threads which are running or to be run on this core, these are borrowed references as all threads are owned by their process
+
+                std::mutex preemptionMutex; //!< Synchronizes the preemption state of the core with its preemption thread
+                std::condition_variable preemptionCondition; //!< Signalled when a timeslice expires prior to the preemption thread's wake time or when the scheduler is being destroyed
+                type::KThread *preemptionThread{}; //!< The running thread which should be preempted at the deadline, this is nullptr if no timeslice is armed
+                std::chrono::steady_clock::time_point preemptionDeadline; //!< The time at which the timeslice of the preemption thread expires
+                std::chrono::steady_clock::time_point preemptionWakeTime; //!< The time at which the preemption thread will wake up next
+                u32 timesliceUpdates{}; //!< The amount of times a timeslice has been armed or disarmed since the last statistics report, each of these was a timer_settime syscall with per-thread timers
+                u32 preemptionSyscalls{}; //!< The amount of syscalls required to preempt threads since the last statistics report, this includes wakeups of the preemption thread and the signals it sends
 
                 CoreContext(u8 id, i8 preemptionPriority);
             };
 
             std::array<CoreContext, constant::CoreCount> cores{CoreContext(0, 59), CoreContext(1, 59), CoreContext(2, 59), CoreContext(3, 63)};
 
+            std::atomic_bool preemptionStop{}; //!< If the preemption threads should exit
+            std::array<std::thread, constant::CoreCount> preemptionThreads; //!< A thread per core which sends a preemption signal to the running thread when its timeslice expires
+
             std::mutex parkedMutex; //!< Synchronizes all operations on the queue of parked threads
-            std::list<std::shared_ptr<type::KThread>> parkedQueue; //!< A queue of threads which are parked and waiting on core migration
+            std::list<type::KThread *> parkedQueue; //!< A queue of threads which are parked and waiting on core migration, these are borrowed references as all threads are owned by their process
 
             /**
              * @brief Migrate a thread from its resident core to its ideal core
              * @note 'KThread::coreMigrationMutex' **must** be locked by the calling thread prior to calling this
              * @note This is used to handle non-cooperative core affinity mask changes where the resident core is not in its new affinity mask
              */
-            void MigrateToCore(const std::shared_ptr<type::KThread> &thread, CoreContext *&currentCore, CoreContext *targetCore, std::unique_lock<std::mutex> &lock);
+            void MigrateToCore(type::KThread *thread, CoreContext *&currentCore, CoreContext *targetCore, std::unique_lock<std::mutex> &lock);
+
+            /**
+             * @brief The entry point of a core's preemption thread, it tracks the deadline of the armed timeslice in userspace and only signals the running thread when it actually expires
+             * @note Arming and disarming a timeslice doesn't require any syscalls as long as the new deadline is after the time the thread will wake up at
+             */
+            void PreemptionThread(CoreContext &core);
+
+            /**
+             * @brief Arms the timeslice of the supplied thread which is running on the supplied core, it'll be preempted after PreemptiveTimeslice
+             */
+            void ArmPreemption(CoreContext &core, type::KThread *thread);
+
+            /**
+             * @brief Disarms the timeslice of the supplied thread on the supplied core, if it was armed
+             */
+            void DisarmPreemption(CoreContext &core, type::KThread *thread);
 
           public:
             static constexpr std::chrono::milliseconds PreemptiveTimeslice{10}; //!< The duration of time a preemptive thread can run before yielding
+            static constexpr std::chrono::seconds PreemptionStatisticsInterval{1}; //!< The interval at which the preemption statistics of every core are logged
             inline static int YieldSignal{SIGRTMIN}; //!< The signal used to cause a non-cooperative yield in running threads
             inline static int PreemptionSignal{SIGRTMIN + 1}; //!< The signal used to cause a preemptive yield in running threads
             inline static thread_local bool YieldPending{}; //!< A flag denoting if a yield is pending on this thread, it's checked prior to entering guest code as signals cannot interrupt host code
 
             Scheduler(const DeviceState &state);
 
+            ~Scheduler();
+
             /**
              * @brief A signal handler designed to cause a non-cooperative yield for preemption and higher priority threads being inserted
              */
@@ -83,12 +113,12 @@ namespace skyline {
              * @note No core mutexes should be held by the calling thread, that will cause a recursive lock and lead to a deadlock
              * @return A reference to the CoreContext of the optimal core
              */
-            CoreContext &GetOptimalCoreForThread(const std::shared_ptr<type::KThread> &thread);
+            CoreContext &GetOptimalCoreForThread(type::KThread *thread);
 
             /**
              * @brief Inserts the specified thread into the scheduler queue at the appropriate location based on its priority
              */
-            void InsertThread(const std::shared_ptr<type::KThread> &thread);
+            void InsertThread(type::KThread *thread);
 
             /**
              * @brief Wait for the calling thread to be scheduled on its resident core
@@ -118,13 +148,18 @@ namespace skyline {
             /**
              * @brief Updates the placement of the supplied thread in its resident core's queue according to its current priority
              */
-            void UpdatePriority(const std::shared_ptr<type::KThread> &thread);
+            void UpdatePriority(type::KThread *thread);
 
             /**
              * @brief Updates the core that the supplied thread is resident to according to its new affinity mask and ideal core
              * @note This supports changing the core of a thread which is currently running
              */
-            void UpdateCore(const std::shared_ptr<type::KThread> &thread);
+            void UpdateCore(type::KThread *thread);
+
+            /**
+             * @return All threads which are currently scheduled to run on a core
+             */
+            std::vector<std::shared_ptr<type::KThread>> GetRunningThreads();
 
             /**
              * @brief Parks the calling thread after removing it from its resident core's queue and inserts it on the core it's been awoken on
@@ -154,7 +189,7 @@ namespace skyline {
             }
 
             ~SchedulerScopedLock() {
-                state.scheduler->InsertThread(state.thread);
+                state.scheduler->InsertThread(state.thread.get());
                 state.scheduler->WaitSchedule();
             }
         };
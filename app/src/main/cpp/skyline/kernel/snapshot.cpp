@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <lz4.h>
+#include <common/trace.h>
+#include "types/KProcess.h"
+#include "snapshot.h"
+
+namespace skyline::kernel {
+    SnapshotEncoder::SnapshotEncoder() {
+        pagemapFd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (pagemapFd < 0)
+            Logger::Warn("Cannot open the pagemap, all pages will be read for snapshots: {}", strerror(errno));
+    }
+
+    SnapshotEncoder::~SnapshotEncoder() {
+        if (pagemapFd >= 0)
+            close(pagemapFd);
+    }
+
+    /**
+     * @return A hash of the contents of a single page
+     */
+    static u64 HashPage(const u8 *page) {
+        return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char *>(page), PAGE_SIZE));
+    }
+
+    snapshot::Header SnapshotEncoder::Encode(const std::string &path, span<const ChunkDescriptor> chunks, span<const snapshot::ThreadRecord> threads, span<const snapshot::HandleRecord> handles) {
+        TRACE_EVENT("kernel", "SnapshotEncoder::Encode");
+
+        static const std::array<u8, PAGE_SIZE> ZeroPage{};
+        static const u64 ZeroPageHash{HashPage(ZeroPage.data())};
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw exception("Cannot open snapshot file: {}", path);
+
+        snapshot::Header header{
+            .magic = snapshot::Magic,
+            .version = snapshot::Version,
+            .index = index,
+            .pageSize = PAGE_SIZE,
+            .chunkCount = chunks.size(),
+            .threadCount = threads.size(),
+            .handleCount = handles.size(),
+        };
+        file.write(reinterpret_cast<const char *>(&header), sizeof(snapshot::Header)); // The header is rewritten with the amount of pages after all of them have been written
+
+        for (const auto &chunk : chunks) {
+            snapshot::ChunkRecord record{
+                .address = reinterpret_cast<u64>(chunk.ptr),
+                .size = chunk.size,
+                .state = chunk.state.value,
+                .attributes = chunk.attributes.value,
+                .permission = chunk.permission.raw,
+            };
+            file.write(reinterpret_cast<const char *>(&record), sizeof(snapshot::ChunkRecord));
+        }
+
+        file.write(reinterpret_cast<const char *>(threads.data()), static_cast<std::streamsize>(threads.size_bytes()));
+        file.write(reinterpret_cast<const char *>(handles.data()), static_cast<std::streamsize>(handles.size_bytes()));
+
+        std::unordered_map<u8 *, u64> hashes;
+        hashes.reserve(pageHashes.size());
+
+        std::vector<u8> buffer(BatchPageCount * PAGE_SIZE);
+        std::vector<char> compressed(static_cast<size_t>(LZ4_compressBound(PAGE_SIZE)));
+        std::array<u64, BatchPageCount> pagemapEntries;
+        std::array<unsigned char, BatchPageCount> residency;
+        std::array<iovec, BatchPageCount> localVectors, remoteVectors;
+        std::array<const u8 *, BatchPageCount> pages; //!< The contents of every page in the batch
+        size_t compressedSize{};
+
+        auto writePage{[&](u8 *address, const u8 *contents) {
+            int size{LZ4_compress_default(reinterpret_cast<const char *>(contents), compressed.data(), PAGE_SIZE, static_cast<int>(compressed.size()))};
+            bool isCompressed{size > 0 && size < PAGE_SIZE};
+            snapshot::PageRecord record{
+                .address = reinterpret_cast<u64>(address),
+                .compressedSize = isCompressed ? static_cast<u32>(size) : static_cast<u32>(PAGE_SIZE),
+            };
+            file.write(reinterpret_cast<const char *>(&record), sizeof(snapshot::PageRecord));
+            file.write(isCompressed ? compressed.data() : reinterpret_cast<const char *>(contents), record.compressedSize);
+            compressedSize += record.compressedSize;
+            header.pageCount++;
+        }};
+
+        constexpr u64 PagemapPresent{1ULL << 63}, PagemapSwapped{1ULL << 62};
+
+        for (const auto &chunk : chunks) {
+            if (!chunk.permission.r || chunk.state == memory::states::Unmapped)
+                continue;
+
+            for (size_t offset{}; offset < chunk.size; offset += BatchPageCount * PAGE_SIZE) {
+                u8 *batch{chunk.ptr + offset};
+                size_t pageCount{std::min(chunk.size - offset, BatchPageCount * PAGE_SIZE) / PAGE_SIZE};
+
+                // Pages which are neither present nor swapped out in the pagemap have never been written to or were freed, they're zero-filled and reading them would needlessly fault them in
+                // The pagemap is required as mincore reports anonymous pages swapped out to zram as non-resident, mincore is still checked as it reports shared memory pages that are resident in the page cache but haven't been faulted into this mapping yet
+                size_t pagemapSize{pageCount * sizeof(u64)};
+                bool pagemapValid{pagemapFd >= 0 && pread(pagemapFd, pagemapEntries.data(), pagemapSize, static_cast<off_t>(reinterpret_cast<u64>(batch) / PAGE_SIZE * sizeof(u64))) == static_cast<ssize_t>(pagemapSize)};
+                if (pagemapValid && mincore(batch, pageCount * PAGE_SIZE, residency.data()) < 0)
+                    continue; // The chunk was unmapped after the chunks were copied, it'll be accounted for in the next snapshot
+
+                // Guest memory is read with process_vm_readv as its protection could be changed concurrently, a fault results in a short read rather than a signal
+                size_t vectorCount{};
+                for (size_t page{}; page < pageCount; page++) {
+                    pages[page] = ZeroPage.data();
+                    if (!pagemapValid || pagemapEntries[page] & (PagemapPresent | PagemapSwapped) || residency[page] & 1) {
+                        localVectors[vectorCount] = {buffer.data() + vectorCount * PAGE_SIZE, PAGE_SIZE};
+                        remoteVectors[vectorCount] = {batch + page * PAGE_SIZE, PAGE_SIZE};
+                        pages[page] = buffer.data() + vectorCount * PAGE_SIZE;
+                        vectorCount++;
+                    }
+                }
+
+                ssize_t readSize{vectorCount ? process_vm_readv(getpid(), localVectors.data(), vectorCount, remoteVectors.data(), vectorCount, 0) : 0};
+                u8 *readEnd{buffer.data() + std::max<ssize_t>(readSize, 0)};
+
+                for (size_t page{}; page < pageCount; page++) {
+                    u8 *address{batch + page * PAGE_SIZE};
+                    const u8 *contents{pages[page]};
+                    auto previous{pageHashes.find(address)};
+                    if (contents != ZeroPage.data() && contents + PAGE_SIZE > readEnd) {
+                        // The page couldn't be read, it's treated as unchanged
+                        if (previous != pageHashes.end())
+                            hashes.emplace(address, previous->second);
+                        continue;
+                    }
+
+                    u64 hash{contents == ZeroPage.data() ? ZeroPageHash : HashPage(contents)};
+                    if (hash != ZeroPageHash)
+                        hashes.emplace(address, hash);
+
+                    if (hash != (previous != pageHashes.end() ? previous->second : ZeroPageHash))
+                        writePage(address, contents);
+                }
+            }
+        }
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(snapshot::Header));
+        if (!file)
+            throw exception("Cannot write snapshot file: {}", path);
+
+        Logger::Info("Wrote guest snapshot #{} to {}: {} changed pages ({} KiB compressed)", index, path, header.pageCount, compressedSize / 1024);
+
+        pageHashes = std::move(hashes);
+        index++;
+        return header;
+    }
+
+    SnapshotWriter::SnapshotWriter(const DeviceState &state, std::string pDirectory, std::chrono::nanoseconds interval) : state(state), directory(std::move(pDirectory)), interval(interval) {
+        if (mkdir(directory.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH) && errno != EEXIST)
+            throw exception("Cannot create the snapshot directory: {} ({})", directory, strerror(errno));
+
+        thread = std::thread(&SnapshotWriter::Run, this);
+        Logger::Info("Writing guest snapshots to {}", directory);
+    }
+
+    SnapshotWriter::~SnapshotWriter() {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        stopCondition.notify_all();
+        thread.join();
+    }
+
+    void SnapshotWriter::Run() {
+        pthread_setname_np(pthread_self(), "Snapshot");
+
+        std::unique_lock lock(mutex);
+        while (!stopCondition.wait_for(lock, interval, [this] { return stop; })) {
+            lock.unlock();
+            try {
+                Write();
+            } catch (const std::exception &e) {
+                Logger::Warn("Failed to write guest snapshot: {}", e.what());
+            }
+            lock.lock();
+        }
+    }
+
+    void SnapshotWriter::Write() {
+        TRACE_EVENT("kernel", "SnapshotWriter::Write");
+
+        auto chunks{state.process->memory.GetChunks()};
+
+        std::vector<snapshot::ThreadRecord> threads;
+        for (const auto &thread : state.process->GetThreads()) {
+            auto &record{threads.emplace_back(snapshot::ThreadRecord{
+                .id = thread->id,
+                .handle = thread->handle,
+                .priority = thread->priority.load(),
+                .coreId = thread->coreId,
+                .tpidrroEl0 = reinterpret_cast<u64>(thread->ctx.tpidrroEl0),
+            })};
+
+            // A running thread writes its context on every SVC so it's only copied from threads which aren't running, the status mutex prevents them from being started during the copy
+            std::lock_guard lock(thread->statusMutex);
+            if (!thread->running) {
+                record.hasContext = true;
+                record.tpidrEl0 = reinterpret_cast<u64>(thread->ctx.tpidrEl0);
+                record.gpr = thread->ctx.gpr;
+                record.fpr = thread->ctx.fpr;
+            }
+        }
+
+        std::vector<snapshot::HandleRecord> handles;
+        for (const auto &[handle, type] : state.process->GetHandleTypes())
+            handles.push_back(snapshot::HandleRecord{handle, static_cast<u32>(type)});
+
+        encoder.Encode(fmt::format("{}snapshot-{}.sksnap", directory, encoder.GetIndex()), chunks, threads, handles);
+    }
+
+    SnapshotReader::SnapshotReader(const std::string &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw exception("Cannot open snapshot file: {}", path);
+
+        auto remaining{static_cast<u64>(file.tellg())};
+        file.seekg(0);
+
+        auto read{[&](void *output, u64 size) {
+            if (size > remaining)
+                throw exception("Snapshot is truncated: 0x{:X} bytes are required but only 0x{:X} are left", size, remaining);
+            file.read(reinterpret_cast<char *>(output), static_cast<std::streamsize>(size));
+            if (!file)
+                throw exception("Cannot read snapshot file: {}", path);
+            remaining -= size;
+        }};
+
+        // The counts are checked against the size of the file prior to allocating storage for the records, a corrupted count would otherwise result in a huge allocation
+        auto readRecords{[&]<typename Record>(std::vector<Record> &records, u64 count) {
+            if (count > remaining / sizeof(Record))
+                throw exception("Snapshot is truncated: {} records of 0x{:X} bytes don't fit into the remaining 0x{:X} bytes", count, sizeof(Record), remaining);
+            records.resize(count);
+            read(records.data(), count * sizeof(Record));
+        }};
+
+        read(&header, sizeof(snapshot::Header));
+        if (header.magic != snapshot::Magic)
+            throw exception("Invalid snapshot magic: 0x{:08X}", header.magic);
+        if (header.version != snapshot::Version)
+            throw exception("Unsupported snapshot version: {}", header.version);
+        if (!std::has_single_bit(header.pageSize))
+            throw exception("Invalid snapshot page size: 0x{:X}", header.pageSize);
+
+        readRecords(chunks, header.chunkCount);
+        readRecords(threads, header.threadCount);
+        readRecords(handles, header.handleCount);
+
+        u64 chunkEnd{};
+        for (const auto &chunk : chunks) {
+            if (chunk.address < chunkEnd || chunk.address + chunk.size < chunk.address || !util::IsAligned(chunk.address, header.pageSize) || !util::IsAligned(chunk.size, header.pageSize))
+                throw exception("Invalid snapshot chunk: 0x{:X} - 0x{:X}", chunk.address, chunk.address + chunk.size);
+            chunkEnd = chunk.address + chunk.size;
+        }
+
+        if (header.pageCount > remaining / sizeof(snapshot::PageRecord))
+            throw exception("Snapshot is truncated: {} pages don't fit into the remaining 0x{:X} bytes", header.pageCount, remaining);
+        pages.reserve(header.pageCount);
+
+        std::vector<char> compressed(header.pageSize);
+        auto chunk{chunks.begin()};
+        u64 pageEnd{};
+        for (u64 page{}; page < header.pageCount; page++) {
+            snapshot::PageRecord record;
+            read(&record, sizeof(snapshot::PageRecord));
+
+            if (record.address < pageEnd || !util::IsAligned(record.address, header.pageSize))
+                throw exception("Snapshot page #{} at 0x{:X} is misaligned or out of order", page, record.address);
+            pageEnd = record.address + header.pageSize;
+
+            while (chunk != chunks.end() && chunk->address + chunk->size <= record.address)
+                chunk++;
+            if (chunk == chunks.end() || chunk->address > record.address || !memory::Permission{chunk->permission}.r || chunk->state == memory::states::Unmapped.value)
+                throw exception("Snapshot page #{} at 0x{:X} isn't inside a readable chunk", page, record.address);
+
+            if (!record.compressedSize || record.compressedSize > header.pageSize)
+                throw exception("Snapshot page #{} at 0x{:X} has an invalid compressed size: 0x{:X}", page, record.address, record.compressedSize);
+
+            Page &output{pages.emplace_back(Page{record.address, std::vector<u8>(header.pageSize)})};
+            if (record.compressedSize == header.pageSize) {
+                read(output.contents.data(), header.pageSize);
+            } else {
+                read(compressed.data(), record.compressedSize);
+                int size{LZ4_decompress_safe(compressed.data(), reinterpret_cast<char *>(output.contents.data()), static_cast<int>(record.compressedSize), static_cast<int>(header.pageSize))};
+                if (size != static_cast<int>(header.pageSize))
+                    throw exception("Snapshot page #{} at 0x{:X} couldn't be decompressed: {}", page, record.address, size);
+            }
+        }
+
+        if (remaining)
+            throw exception("Snapshot has 0x{:X} bytes of trailing data", remaining);
+    }
+
+    void SnapshotReader::Apply(span<u8> memory, u64 address) const {
+        u64 end{address + memory.size()};
+        auto zero{[&](u64 start, u64 stop) {
+            start = std::clamp(start, address, end);
+            stop = std::clamp(stop, address, end);
+            if (start < stop)
+                std::memset(memory.data() + (start - address), 0, stop - start);
+        }};
+
+        // The first snapshot only contains pages with non-zero contents while later ones only contain pages that changed since the previous one
+        if (header.index == 0)
+            std::memset(memory.data(), 0, memory.size());
+
+        u64 readableEnd{address};
+        for (const auto &chunk : chunks) {
+            if (!memory::Permission{chunk.permission}.r || chunk.state == memory::states::Unmapped.value)
+                continue;
+            zero(readableEnd, chunk.address);
+            readableEnd = std::max(readableEnd, chunk.address + chunk.size);
+        }
+        zero(readableEnd, end);
+
+        for (const auto &page : pages) {
+            if (page.address < address || page.address + header.pageSize > end)
+                throw exception("Snapshot page at 0x{:X} is outside the restored range: 0x{:X} - 0x{:X}", page.address, address, end);
+            std::memcpy(memory.data() + (page.address - address), page.contents.data(), header.pageSize);
+        }
+    }
+
+    void SnapshotReader::Restore(span<const std::string> paths, span<u8> memory, u64 address) {
+        for (u32 index{}; index < paths.size(); index++) {
+            SnapshotReader reader(paths[index]);
+            if (reader.header.index != index)
+                throw exception("Snapshot {} has index {} rather than {}, snapshots must be restored in order starting from the first one", paths[index], reader.header.index, index);
+            reader.Apply(memory, address);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include <common.h>
+#include <nce/guest.h>
+#include "memory.h"
+
+namespace skyline::kernel {
+    /**
+     * @brief The format of guest snapshot files (.sksnap), every file starts with a header followed by all chunk, thread, handle and page records in that order
+     * @note The guest memory at a snapshot is reconstructed by applying the pages of every snapshot up to it in order, pages outside of readable chunks in any snapshot are to be zeroed prior to applying the ones after it
+     */
+    namespace snapshot {
+        constexpr u32 Magic{util::MakeMagic<u32>("SKSS")};
+        constexpr u32 Version{2};
+
+        struct Header {
+            u32 magic;
+            u32 version;
+            u32 index; //!< The index of the snapshot in the session, the first snapshot contains all pages with non-zero contents
+            u32 pageSize;
+            u64 chunkCount;
+            u64 threadCount;
+            u64 handleCount;
+            u64 pageCount;
+        };
+
+        struct ChunkRecord {
+            u64 address;
+            u64 size;
+            u32 state;
+            u32 attributes;
+            u8 permission;
+            u8 _pad_[7];
+        };
+
+        struct ThreadRecord {
+            u64 id;
+            KHandle handle;
+            i8 priority;
+            u8 coreId;
+            bool hasContext; //!< If tpidrEl0, gpr and fpr hold the context of the thread, this is false for threads that were running as their context is concurrently written by them
+            u8 _pad_;
+            u64 tpidrroEl0;
+            u64 tpidrEl0;
+            nce::GpRegisters gpr;
+            nce::FpRegisters fpr;
+        };
+
+        struct HandleRecord {
+            KHandle handle;
+            u32 type; //!< The KType of the object
+        };
+
+        /**
+         * @brief A record of a single page, it's followed by the contents of the page which are LZ4 compressed unless the compressed size is the page size
+         * @note Pages are written in ascending order of their address and are always inside a readable chunk of the same snapshot
+         */
+        struct PageRecord {
+            u64 address;
+            u32 compressedSize;
+            u32 _pad_;
+        };
+    }
+
+    /**
+     * @brief Encodes a sequence of incremental snapshots of memory in the current process into snapshot files
+     * @note Only pages which have changed since the previous snapshot are written, this is determined by comparing a hash of their contents with the one from the previous snapshot
+     * @note This doesn't depend on the guest process, the chunks supplied to it can be any memory in the current process
+     */
+    class SnapshotEncoder {
+      private:
+        static constexpr size_t BatchPageCount{1024}; //!< The amount of pages read by a single process_vm_readv call, this is IOV_MAX
+
+        u32 index{}; //!< The index of the next snapshot
+        std::unordered_map<u8 *, u64> pageHashes; //!< The hash of every page with non-zero contents in the previous snapshot, any page which isn't in this is assumed to be zero-filled
+        int pagemapFd{-1}; //!< A file descriptor to /proc/self/pagemap, all pages are read if it couldn't be opened
+
+      public:
+        SnapshotEncoder();
+
+        ~SnapshotEncoder();
+
+        /**
+         * @return The index of the next snapshot
+         */
+        u32 GetIndex() const {
+            return index;
+        }
+
+        /**
+         * @brief Writes the next snapshot to the supplied path, the contents of all readable chunks are read from memory
+         * @return The header of the written snapshot
+         */
+        snapshot::Header Encode(const std::string &path, span<const ChunkDescriptor> chunks, span<const snapshot::ThreadRecord> threads, span<const snapshot::HandleRecord> handles);
+    };
+
+    /**
+     * @brief Periodically writes incremental snapshots of the guest state to disk on a background thread, they're used to inspect the state of a session long after it was started
+     * @note Guest threads aren't paused while a snapshot is being taken, memory is read page-by-page so a snapshot isn't atomic and only the contexts of threads which aren't running are recorded
+     */
+    class SnapshotWriter {
+      public:
+        static constexpr std::chrono::nanoseconds DefaultInterval{std::chrono::seconds(60)};
+
+      private:
+        const DeviceState &state;
+        std::string directory; //!< The directory snapshots are written into, it must end with a slash
+        std::chrono::nanoseconds interval; //!< The duration between two snapshots
+        SnapshotEncoder encoder;
+        std::mutex mutex; //!< Synchronizes the stop flag with the snapshot thread
+        std::condition_variable stopCondition;
+        bool stop{};
+        std::thread thread;
+
+        void Run();
+
+        /**
+         * @brief Writes a snapshot of the current guest state to the next snapshot file
+         */
+        void Write();
+
+      public:
+        /**
+         * @param directory The directory to write snapshots into, it's created if it doesn't exist and existing snapshots in it are overwritten
+         */
+        SnapshotWriter(const DeviceState &state, std::string directory, std::chrono::nanoseconds interval = DefaultInterval);
+
+        ~SnapshotWriter();
+    };
+
+    /**
+     * @brief Reads a snapshot file and validates its structure, this is used to inspect snapshots offline after they've been pulled from a device
+     * @note Every page is decompressed on load, an exception is thrown if any part of the file is malformed
+     */
+    class SnapshotReader {
+      public:
+        struct Page {
+            u64 address;
+            std::vector<u8> contents; //!< The decompressed contents of the page, this is always the page size of the snapshot
+        };
+
+        snapshot::Header header;
+        std::vector<snapshot::ChunkRecord> chunks;
+        std::vector<snapshot::ThreadRecord> threads;
+        std::vector<snapshot::HandleRecord> handles;
+        std::vector<Page> pages;
+
+        SnapshotReader(const std::string &path);
+
+        /**
+         * @brief Applies this snapshot onto memory holding the guest memory at the previous snapshot, it holds the guest memory at this snapshot afterwards
+         * @param memory The memory to apply the snapshot onto, it corresponds to the guest address range starting at the supplied address
+         * @note All parts of the range which aren't inside a readable chunk of this snapshot are zeroed, the entire range is zeroed prior to applying the first snapshot
+         */
+        void Apply(span<u8> memory, u64 address) const;
+
+        /**
+         * @brief Reconstructs the guest memory at a snapshot by applying every snapshot up to it in order
+         * @param paths The paths of the snapshot files from the first snapshot of the session up to the one being restored
+         * @param memory The memory to restore into, it corresponds to the guest address range starting at the supplied address
+         */
+        static void Restore(span<const std::string> paths, span<u8> memory, u64 address);
+    };
+}
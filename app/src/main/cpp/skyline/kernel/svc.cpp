@@ -366,7 +366,7 @@ namespace skyline::kernel::svc {
                     newPriority = thread->priority.load();
                     newPriority = std::min(newPriority, priority);
                 } while (newPriority != priority && thread->priority.compare_exchange_strong(newPriority, priority));
-                state.scheduler->UpdatePriority(thread);
+                state.scheduler->UpdatePriority(thread.get());
                 thread->UpdatePriorityInheritance();
             }
             state.ctx->gpr.w0 = Result{};
@@ -434,12 +434,12 @@ namespace skyline::kernel::svc {
                 if (thread == state.thread) {
                     state.scheduler->RemoveThread();
                     thread->coreId = static_cast<u8>(idealCore);
-                    state.scheduler->InsertThread(state.thread);
+                    state.scheduler->InsertThread(state.thread.get());
                     state.scheduler->WaitSchedule();
                 } else if (!thread->running) {
                     thread->coreId = static_cast<u8>(idealCore);
                 } else {
-                    state.scheduler->UpdateCore(thread);
+                    state.scheduler->UpdateCore(thread.get());
                 }
             }
 
@@ -675,7 +675,7 @@ namespace skyline::kernel::svc {
 
         auto priority{state.thread->priority.load()};
         for (const auto &object : objectTable)
-            object->syncObjectWaiters.insert(std::upper_bound(object->syncObjectWaiters.begin(), object->syncObjectWaiters.end(), priority, type::KThread::IsHigherPriority), state.thread);
+            object->syncObjectWaiters.insert(std::upper_bound(object->syncObjectWaiters.begin(), object->syncObjectWaiters.end(), priority, type::KThread::IsHigherPriority), state.thread.get());
 
         state.thread->isCancellable = true;
         state.thread->wakeObject = nullptr;
@@ -697,7 +697,7 @@ namespace skyline::kernel::svc {
             if (object.get() == wakeObject)
                 wakeIndex = index;
 
-            auto it{std::find(object->syncObjectWaiters.begin(), object->syncObjectWaiters.end(), state.thread)};
+            auto it{std::find(object->syncObjectWaiters.begin(), object->syncObjectWaiters.end(), state.thread.get())};
             if (it != object->syncObjectWaiters.end())
                 object->syncObjectWaiters.erase(it);
             else
@@ -718,7 +718,7 @@ namespace skyline::kernel::svc {
             Logger::Debug("Wait has timed out");
             state.ctx->gpr.w0 = result::TimedOut;
             lock.unlock();
-            state.scheduler->InsertThread(state.thread);
+            state.scheduler->InsertThread(state.thread.get());
             state.scheduler->WaitSchedule();
         }
     }
@@ -730,7 +730,7 @@ namespace skyline::kernel::svc {
             thread->cancelSync = true;
             if (thread->isCancellable) {
                 thread->isCancellable = false;
-                state.scheduler->InsertThread(thread);
+                state.scheduler->InsertThread(thread.get());
             }
             state.ctx->gpr.w0 = Result{};
         } catch (const std::out_of_range &) {
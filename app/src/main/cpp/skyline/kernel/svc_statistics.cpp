@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "svc.h"
+#include "svc_statistics.h"
+
+namespace skyline::kernel::svc {
+    static_assert(SvcStatistics::SvcCount == SvcTable.size());
+
+    std::vector<SvcStatistics::Summary> SvcStatistics::Aggregate() {
+        std::vector<Summary> summaries;
+        for (u16 id{}; id < SvcCount; id++) {
+            Summary summary{
+                .id = id,
+                .name = SvcTable[id].name,
+            };
+            for (auto &core : counters) {
+                auto &counter{core[id]};
+                summary.count += counter.count.load(std::memory_order_relaxed);
+                summary.totalTime += counter.totalTime.load(std::memory_order_relaxed);
+                for (size_t bucket{}; bucket < HistogramBucketCount; bucket++)
+                    summary.histogram[bucket] += counter.histogram[bucket].load(std::memory_order_relaxed);
+            }
+
+            if (summary.count)
+                summaries.push_back(summary);
+        }
+        return summaries;
+    }
+
+    std::string SvcStatistics::Dump() {
+        auto summaries{Aggregate()};
+        std::sort(summaries.begin(), summaries.end(), [](const Summary &a, const Summary &b) { return a.totalTime > b.totalTime; });
+
+        std::string dump;
+        for (const auto &summary : summaries) {
+            dump += fmt::format("{} (0x{:02X}): {} calls, {:.3f}ms total, {:.3f}us average\n", summary.name ? summary.name : "Unknown", summary.id, summary.count, static_cast<double>(summary.totalTime) / constant::NsInMillisecond, static_cast<double>(summary.totalTime) / summary.count / constant::NsInMicrosecond);
+
+            dump += "  Latency:";
+            for (size_t bucket{}; bucket < HistogramBucketCount; bucket++)
+                if (summary.histogram[bucket])
+                    dump += (bucket == HistogramBucketCount - 1) ? fmt::format(" >={}ns: {}", 1ULL << (bucket - 1), summary.histogram[bucket]) : fmt::format(" <{}ns: {}", 1ULL << bucket, summary.histogram[bucket]);
+            dump += '\n';
+        }
+        return dump;
+    }
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+#include "scheduler.h"
+
+namespace skyline::kernel::svc {
+    /**
+     * @brief Lightweight counters of the amount of calls and their latency for every SVC, these are sharded by the core the calling thread is resident on
+     * @note The counters are only aggregated on demand, recording a call is a few uncontended relaxed atomic additions
+     */
+    class SvcStatistics {
+      public:
+        static constexpr size_t SvcCount{0x80}; //!< The amount of SVCs in the SVC table
+        static constexpr size_t HistogramBucketCount{32}; //!< The amount of buckets in the latency histogram, bucket N holds calls that took less than 2^N nanoseconds while the last bucket holds all calls that took longer
+
+        struct Summary {
+            u16 id;
+            const char *name;
+            u64 count;
+            u64 totalTime; //!< The cumulative time spent in the SVC in nanoseconds
+            std::array<u64, HistogramBucketCount> histogram;
+        };
+
+      private:
+        struct alignas(64) Counter { // Counters are padded to a cache line to prevent false sharing between cores
+            std::atomic<u64> count;
+            std::atomic<u64> totalTime;
+            std::array<std::atomic<u64>, HistogramBucketCount> histogram;
+        };
+
+        std::array<std::array<Counter, SvcCount>, constant::CoreCount> counters{};
+
+      public:
+        /**
+         * @brief Records a single call to an SVC on the supplied core
+         * @param duration The duration of the call in nanoseconds
+         */
+        void Record(u8 coreId, u16 svcId, i64 duration) {
+            auto &counter{counters[std::min<u8>(coreId, constant::CoreCount - 1)][svcId]}; // A parked thread doesn't have a valid core, it's accounted to the last core
+            u64 time{static_cast<u64>(std::max<i64>(duration, 0))};
+            counter.count.fetch_add(1, std::memory_order_relaxed);
+            counter.totalTime.fetch_add(time, std::memory_order_relaxed);
+            counter.histogram[std::min<size_t>(std::bit_width(time), HistogramBucketCount - 1)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @return A summary of every SVC that has been called at least once, the counters of all cores are summed together
+         */
+        std::vector<Summary> Aggregate();
+
+        /**
+         * @return A human-readable table of all summaries from Aggregate
+         */
+        std::string Dump();
+    };
+}
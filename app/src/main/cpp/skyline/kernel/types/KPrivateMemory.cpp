@@ -35,6 +35,11 @@ namespace skyline::kernel::type {
             throw exception("An occurred while resizing private memory: {}", strerror(errno));
 
         if (nSize < size) {
+            // The entire released range must be inaccessible to the guest even if this splits a huge page, the split only costs TLB efficiency for the remainder of it
+            if (mprotect(ptr + nSize, size - nSize, PROT_NONE) < 0)
+                throw exception("An occurred while resizing private memory: {}", strerror(errno));
+            state.process->memory.FreeMemory(span(ptr + nSize, size - nSize));
+
             state.process->memory.InsertChunk(ChunkDescriptor{
                 .ptr = ptr + nSize,
                 .size = size - nSize,
@@ -63,6 +68,13 @@ namespace skyline::kernel::type {
 
         if (mprotect(nPtr, nSize, PROT_NONE) < 0)
             throw exception("An occurred while remapping private memory: {}", strerror(errno));
+
+        // Only the contents of the overlapping region are retained, the rest of the prior mapping can be released
+        auto end{ptr + size}, nEnd{nPtr + nSize};
+        if (nPtr > ptr)
+            state.process->memory.FreeMemory(span(ptr, std::min(nPtr, end)));
+        if (nEnd < end)
+            state.process->memory.FreeMemory(span(std::max(nEnd, ptr), end));
     }
 
     void KPrivateMemory::UpdatePermission(u8 *pPtr, size_t pSize, memory::Permission pPermission) {
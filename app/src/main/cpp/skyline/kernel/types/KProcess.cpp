@@ -135,10 +135,10 @@ namespace skyline::kernel::type {
                 return result::InvalidCurrentMemory;
 
             auto &waiters{owner->waiters};
-            isHighestPriority = waiters.insert(std::upper_bound(waiters.begin(), waiters.end(), state.thread->priority.load(), KThread::IsHigherPriority), state.thread) == waiters.begin();
+            isHighestPriority = waiters.insert(std::upper_bound(waiters.begin(), waiters.end(), state.thread->priority.load(), KThread::IsHigherPriority), state.thread.get()) == waiters.begin();
             state.scheduler->RemoveThread();
 
-            state.thread->waitThread = owner;
+            state.thread->waitThread = owner.get();
             state.thread->waitKey = mutex;
             state.thread->waitTag = tag;
         }
@@ -157,15 +157,15 @@ namespace skyline::kernel::type {
 
         std::lock_guard lock(state.thread->waiterMutex);
         auto &waiters{state.thread->waiters};
-        auto nextOwnerIt{std::find_if(waiters.begin(), waiters.end(), [mutex](const std::shared_ptr<KThread> &thread) { return thread->waitKey == mutex; })};
+        auto nextOwnerIt{std::find_if(waiters.begin(), waiters.end(), [mutex](const KThread *thread) { return thread->waitKey == mutex; })};
         if (nextOwnerIt != waiters.end()) {
             auto nextOwner{*nextOwnerIt};
             std::lock_guard nextLock(nextOwner->waiterMutex);
-            nextOwner->waitThread = std::shared_ptr<KThread>{nullptr};
+            nextOwner->waitThread = nullptr;
             nextOwner->waitKey = nullptr;
 
             // Move all threads waiting on this key to the next owner's waiter list
-            std::shared_ptr<KThread> nextWaiter{};
+            KThread *nextWaiter{};
             for (auto it{waiters.erase(nextOwnerIt)}, nextIt{std::next(it)}; it != waiters.end(); it = nextIt++) {
                 auto thread{*it};
                 if (thread->waitKey == mutex) {
@@ -184,7 +184,7 @@ namespace skyline::kernel::type {
                     basePriority = state.thread->basePriority.load();
                     newPriority = std::min(basePriority, highestPriorityThread->priority.load());
                 } while (basePriority != newPriority && state.thread->priority.compare_exchange_strong(basePriority, newPriority));
-                state.scheduler->UpdatePriority(state.thread);
+                state.scheduler->UpdatePriority(state.thread.get());
             } else {
                 i8 priority, basePriority;
                 do {
@@ -192,7 +192,7 @@ namespace skyline::kernel::type {
                     priority = state.thread->priority.load();
                 } while (priority != basePriority && !state.thread->priority.compare_exchange_strong(priority, basePriority));
                 if (priority != basePriority)
-                    state.scheduler->UpdatePriority(state.thread);
+                    state.scheduler->UpdatePriority(state.thread.get());
             }
 
             if (nextWaiter) {
@@ -215,13 +215,51 @@ namespace skyline::kernel::type {
         }
     }
 
+    KProcess::SyncWaiterBucket &KProcess::GetSyncWaiterBucket(void *address) {
+        // Fibonacci hashing is used to spread out the addresses of primitives which are adjacent in memory across buckets
+        constexpr u8 HashShift{64 - std::countr_zero(SyncWaiterBucketCount)};
+        return syncWaiters[(reinterpret_cast<u64>(address) * 0x9E3779B97F4A7C15) >> HashShift];
+    }
+
+    void KProcess::InsertSyncWaiterLocked(SyncWaiterBucket &bucket, void *address, KThread *thread) {
+        // We search backwards from the tail as waiters are most commonly inserted with the same priority as the waiters prior to them
+        i8 priority{thread->priority.load()};
+        KThread *previous{bucket.tail};
+        while (previous && previous->priority > priority)
+            previous = previous->syncWaitPrevious;
+
+        KThread *next{previous ? previous->syncWaitNext : bucket.head};
+        thread->syncWaitAddress = address;
+        thread->syncWaitPrevious = previous;
+        thread->syncWaitNext = next;
+        (previous ? previous->syncWaitNext : bucket.head) = thread;
+        (next ? next->syncWaitPrevious : bucket.tail) = thread;
+    }
+
+    KThread *KProcess::RemoveSyncWaiterLocked(SyncWaiterBucket &bucket, KThread *thread) {
+        KThread *previous{thread->syncWaitPrevious}, *next{thread->syncWaitNext};
+        (previous ? previous->syncWaitNext : bucket.head) = next;
+        (next ? next->syncWaitPrevious : bucket.tail) = previous;
+        thread->syncWaitAddress = nullptr;
+        thread->syncWaitPrevious = nullptr;
+        thread->syncWaitNext = nullptr;
+        return next;
+    }
+
+    bool KProcess::HasSyncWaitersLocked(SyncWaiterBucket &bucket, void *address) {
+        for (KThread *waiter{bucket.head}; waiter; waiter = waiter->syncWaitNext)
+            if (waiter->syncWaitAddress == address)
+                return true;
+        return false;
+    }
+
     Result KProcess::ConditionalVariableWait(u32 *key, u32 *mutex, KHandle tag, i64 timeout) {
         TRACE_EVENT_FMT("kernel", "ConditionalVariableWait 0x{:X} (0x{:X})", key, mutex);
 
+        auto &bucket{GetSyncWaiterBucket(key)};
         {
-            std::lock_guard lock(syncWaiterMutex);
-            auto queue{syncWaiters.equal_range(key)};
-            syncWaiters.insert(std::upper_bound(queue.first, queue.second, state.thread->priority.load(), [](const i8 priority, const SyncWaiters::value_type &it) { return it.second->priority > priority; }), {key, state.thread});
+            std::lock_guard lock(bucket.mutex);
+            InsertSyncWaiterLocked(bucket, key, state.thread.get());
 
             __atomic_store_n(key, true, __ATOMIC_SEQ_CST); // We need to notify any userspace threads that there are waiters on this conditional variable by writing back a boolean flag denoting it
 
@@ -230,15 +268,15 @@ namespace skyline::kernel::type {
         }
 
         if (timeout > 0 && !state.scheduler->TimedWaitSchedule(std::chrono::nanoseconds(timeout))) {
-            std::unique_lock lock(syncWaiterMutex);
-            auto queue{syncWaiters.equal_range(key)};
-            auto iterator{std::find(queue.first, queue.second, SyncWaiters::value_type{key, state.thread})};
-            if (iterator != queue.second)
-                if (syncWaiters.erase(iterator) == queue.second)
+            std::unique_lock lock(bucket.mutex);
+            if (state.thread->syncWaitAddress) {
+                RemoveSyncWaiterLocked(bucket, state.thread.get());
+                if (!HasSyncWaitersLocked(bucket, key))
                     __atomic_store_n(key, false, __ATOMIC_SEQ_CST);
+            }
 
             lock.unlock();
-            state.scheduler->InsertThread(state.thread);
+            state.scheduler->InsertThread(state.thread.get());
             state.scheduler->WaitSchedule();
 
             return result::TimedOut;
@@ -259,42 +297,52 @@ namespace skyline::kernel::type {
     void KProcess::ConditionalVariableSignal(u32 *key, i32 amount) {
         TRACE_EVENT_FMT("kernel", "ConditionalVariableSignal 0x{:X}", key);
 
-        std::lock_guard lock(syncWaiterMutex);
-        auto queue{syncWaiters.equal_range(key)};
+        auto &bucket{GetSyncWaiterBucket(key)};
+        std::lock_guard lock(bucket.mutex);
 
-        auto it{queue.first};
-        for (i32 waiterCount{amount}; it != queue.second && (amount <= 0 || waiterCount); it = syncWaiters.erase(it), waiterCount--)
-            state.scheduler->InsertThread(it->second);
+        KThread *waiter{bucket.head};
+        for (i32 waiterCount{amount}; waiter && (amount <= 0 || waiterCount);) {
+            if (waiter->syncWaitAddress == key) {
+                KThread *next{RemoveSyncWaiterLocked(bucket, waiter)};
+                state.scheduler->InsertThread(waiter);
+                waiter = next;
+                waiterCount--;
+            } else {
+                waiter = waiter->syncWaitNext;
+            }
+        }
 
-        if (it == queue.second)
+        while (waiter && waiter->syncWaitAddress != key)
+            waiter = waiter->syncWaitNext;
+        if (!waiter)
             __atomic_store_n(key, false, __ATOMIC_SEQ_CST); // We need to update the boolean flag denoting that there are no more threads waiting on this conditional variable
     }
 
     Result KProcess::WaitForAddress(u32 *address, u32 value, i64 timeout, bool (*arbitrationFunction)(u32 *, u32)) {
         TRACE_EVENT_FMT("kernel", "WaitForAddress 0x{:X}", address);
 
+        auto &bucket{GetSyncWaiterBucket(address)};
         {
-            std::lock_guard lock(syncWaiterMutex);
+            std::lock_guard lock(bucket.mutex);
             if (!arbitrationFunction(address, value)) [[unlikely]]
                 return result::InvalidState;
 
-            auto queue{syncWaiters.equal_range(address)};
-            syncWaiters.insert(std::upper_bound(queue.first, queue.second, state.thread->priority.load(), [](const i8 priority, const SyncWaiters::value_type &it) { return it.second->priority > priority; }), {address, state.thread});
+            InsertSyncWaiterLocked(bucket, address, state.thread.get());
 
             state.scheduler->RemoveThread();
         }
 
         if (timeout > 0 && !state.scheduler->TimedWaitSchedule(std::chrono::nanoseconds(timeout))) {
             {
-                std::lock_guard lock(syncWaiterMutex);
-                auto queue{syncWaiters.equal_range(address)};
-                auto iterator{std::find(queue.first, queue.second, SyncWaiters::value_type{address, state.thread})};
-                if (iterator != queue.second)
-                    if (syncWaiters.erase(iterator) == queue.second)
+                std::lock_guard lock(bucket.mutex);
+                if (state.thread->syncWaitAddress) {
+                    RemoveSyncWaiterLocked(bucket, state.thread.get());
+                    if (!HasSyncWaitersLocked(bucket, address))
                         __atomic_store_n(address, false, __ATOMIC_SEQ_CST);
+                }
             }
 
-            state.scheduler->InsertThread(state.thread);
+            state.scheduler->InsertThread(state.thread.get());
             state.scheduler->WaitSchedule();
 
             return result::TimedOut;
@@ -308,16 +356,30 @@ namespace skyline::kernel::type {
     Result KProcess::SignalToAddress(u32 *address, u32 value, i32 amount, bool(*mutateFunction)(u32 *address, u32 value, u32 waiterCount)) {
         TRACE_EVENT_FMT("kernel", "SignalToAddress 0x{:X}", address);
 
-        std::lock_guard lock(syncWaiterMutex);
-        auto queue{syncWaiters.equal_range(address)};
+        auto &bucket{GetSyncWaiterBucket(address)};
+        std::lock_guard lock(bucket.mutex);
+
+        if (mutateFunction) {
+            u32 addressWaiterCount{};
+            for (KThread *waiter{bucket.head}; waiter; waiter = waiter->syncWaitNext)
+                if (waiter->syncWaitAddress == address)
+                    addressWaiterCount++;
 
-        if (mutateFunction)
-            if (!mutateFunction(address, value, (amount <= 0) ? 0 : std::min(static_cast<u32>(std::distance(queue.first, queue.second) - amount), 0U))) [[unlikely]]
+            if (!mutateFunction(address, value, (amount <= 0) ? 0 : std::min(static_cast<u32>(addressWaiterCount - amount), 0U))) [[unlikely]]
                 return result::InvalidState;
+        }
 
         i32 waiterCount{amount};
-        for (auto it{queue.first}; it != queue.second && (amount <= 0 || waiterCount); it = syncWaiters.erase(it), waiterCount--)
-            state.scheduler->InsertThread(it->second);
+        for (KThread *waiter{bucket.head}; waiter && (amount <= 0 || waiterCount);) {
+            if (waiter->syncWaitAddress == address) {
+                KThread *next{RemoveSyncWaiterLocked(bucket, waiter)};
+                state.scheduler->InsertThread(waiter);
+                waiter = next;
+                waiterCount--;
+            } else {
+                waiter = waiter->syncWaitNext;
+            }
+        }
 
         return {};
     }
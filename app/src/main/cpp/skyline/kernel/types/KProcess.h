@@ -30,9 +30,39 @@ namespace skyline {
             std::atomic_bool alreadyKilled{}; //!< If the process has already been killed prior so there's no need to redundantly kill it again
             std::vector<std::shared_ptr<KThread>> threads;
 
-            using SyncWaiters = std::multimap<void *, std::shared_ptr<KThread>>;
-            std::mutex syncWaiterMutex; //!< Synchronizes all mutations to the map to prevent races
-            SyncWaiters syncWaiters; //!< All threads waiting on process-wide synchronization primitives (Atomic keys + Address Arbiter)
+            /**
+             * @brief A bucket of threads waiting on process-wide synchronization primitives (Atomic keys + Address Arbiter) with addresses that hash to it
+             * @note Waiters are intrusively linked through KThread::syncWaitNext/syncWaitPrevious in order of priority, threads with the same priority are in FIFO order
+             */
+            struct alignas(64) SyncWaiterBucket {
+                std::mutex mutex; //!< Synchronizes all mutations to the bucket and the sync waiter members of threads in it
+                KThread *head{}; //!< The highest priority waiter in the bucket
+                KThread *tail{}; //!< The lowest priority waiter in the bucket
+            };
+
+            static constexpr size_t SyncWaiterBucketCount{64}; //!< The amount of buckets in the sync waiter table, this should be a power of two
+            std::array<SyncWaiterBucket, SyncWaiterBucketCount> syncWaiters; //!< A fixed-size table of all threads waiting on process-wide synchronization primitives
+
+            /**
+             * @return The bucket in the sync waiter table which waiters on the supplied address are inserted into
+             */
+            SyncWaiterBucket &GetSyncWaiterBucket(void *address);
+
+            /**
+             * @brief Inserts the supplied thread into the bucket after all waiters with a higher or equal priority
+             */
+            static void InsertSyncWaiterLocked(SyncWaiterBucket &bucket, void *address, KThread *thread);
+
+            /**
+             * @brief Unlinks the supplied thread from the bucket it's waiting in
+             * @return The next waiter in the bucket after the removed thread
+             */
+            static KThread *RemoveSyncWaiterLocked(SyncWaiterBucket &bucket, KThread *thread);
+
+            /**
+             * @return If there are any threads waiting on the supplied address
+             */
+            static bool HasSyncWaitersLocked(SyncWaiterBucket &bucket, void *address);
 
             /**
             * @brief The status of a single TLS page (A page is 4096 bytes on ARMv8)
@@ -97,6 +127,14 @@ namespace skyline {
              */
             std::shared_ptr<KThread> CreateThread(void *entry, u64 argument = 0, void *stackTop = nullptr, std::optional<i8> priority = std::nullopt, std::optional<u8> idealCore = std::nullopt);
 
+            /**
+             * @return A copy of the list of all threads that have been created in the process
+             */
+            std::vector<std::shared_ptr<KThread>> GetThreads() {
+                std::lock_guard lock(threadMutex);
+                return threads;
+            }
+
             /**
             * @brief The output for functions that return created kernel objects
             * @tparam objectClass The class of the kernel object
@@ -195,6 +233,18 @@ namespace skyline {
              */
             std::optional<HandleOut<KMemory>> GetMemoryObject(u8 *ptr);
 
+            /**
+             * @return The handle and type of every object in the handle table which hasn't been closed
+             */
+            std::vector<std::pair<KHandle, KType>> GetHandleTypes() {
+                std::shared_lock lock(handleMutex);
+                std::vector<std::pair<KHandle, KType>> handleTypes;
+                for (size_t index{}; index < handles.size(); index++)
+                    if (handles[index])
+                        handleTypes.emplace_back(static_cast<KHandle>(constant::BaseHandleIndex + index), handles[index]->objectType);
+                return handleTypes;
+            }
+
             /**
              * @brief Closes a handle in the handle table
              */
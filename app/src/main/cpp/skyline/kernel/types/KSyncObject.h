@@ -13,7 +13,7 @@ namespace skyline::kernel::type {
     class KSyncObject : public KObject {
       public:
         inline static std::mutex syncObjectMutex; //!< A global lock used for locking all signalling to avoid races
-        std::list<std::shared_ptr<KThread>> syncObjectWaiters; //!< A list of threads waiting on this object to be signalled
+        std::list<KThread *> syncObjectWaiters; //!< A list of threads waiting on this object to be signalled, these are borrowed references as the threads remove themselves prior to returning from the wait
         bool signalled; //!< If the current object is signalled (An object stays signalled till the signal has been explicitly reset)
 
         /**
@@ -7,6 +7,7 @@
 #include <common/trace.h>
 #include <nce.h>
 #include <os.h>
+#include <kernel/host_thread_pool.h>
 #include "KProcess.h"
 #include "KThread.h"
 
@@ -28,17 +29,16 @@ namespace skyline::kernel::type {
 
     KThread::~KThread() {
         Kill(true);
-        if (thread.joinable())
-            thread.join();
-        if (preemptionTimer)
-            timer_delete(preemptionTimer);
+    }
+
+    void KThread::InstallSignalHandlers() {
+        signal::SetSignalHandler({SIGINT, SIGILL, SIGTRAP, SIGBUS, SIGFPE, SIGSEGV}, nce::NCE::SignalHandler);
+        signal::SetSignalHandler({Scheduler::YieldSignal, Scheduler::PreemptionSignal}, Scheduler::SignalHandler, false); // We want futexes to fail and their predicates rechecked
+        signal::SetSignalHandler({Profiler::ProfilerSignal}, Profiler::SignalHandler); // Sampling shouldn't have any side effects on the thread, so any interrupted syscalls are restarted
     }
 
     void KThread::StartThread() {
-        std::array<char, 16> threadName;
-        pthread_getname_np(pthread, threadName.data(), threadName.size());
-        pthread_setname_np(pthread, fmt::format("HOS-{}", id).c_str());
-        Logger::UpdateTag();
+        pthread = pthread_self(); // This is only read after the thread is ready, which is set with the status mutex locked
 
         if (!ctx.tpidrroEl0)
             ctx.tpidrroEl0 = parent->AllocateTlsSlot();
@@ -54,30 +54,14 @@ namespace skyline::kernel::type {
                 std::lock_guard lock(statusMutex);
                 running = false;
                 ready = false;
+                Profiler::ReleaseThreadBuffer(*this);
                 statusCondition.notify_all();
             }
 
             Signal();
-
-            if (threadName[0] != 'H' || threadName[1] != 'O' || threadName[2] != 'S' || threadName[3] != '-') {
-                pthread_setname_np(pthread, threadName.data());
-                Logger::UpdateTag();
-            }
-
             return;
         }
 
-        struct sigevent event{
-            .sigev_signo = Scheduler::PreemptionSignal,
-            .sigev_notify = SIGEV_THREAD_ID,
-            .sigev_notify_thread_id = gettid(),
-        };
-        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &preemptionTimer))
-            throw exception("timer_create has failed with '{}'", strerror(errno));
-
-        signal::SetSignalHandler({SIGINT, SIGILL, SIGTRAP, SIGBUS, SIGFPE, SIGSEGV}, nce::NCE::SignalHandler);
-        signal::SetSignalHandler({Scheduler::YieldSignal, Scheduler::PreemptionSignal}, Scheduler::SignalHandler, false); // We want futexes to fail and their predicates rechecked
-
         {
             std::lock_guard lock(statusMutex);
             ready = true;
@@ -201,21 +185,29 @@ namespace skyline::kernel::type {
         if (!running) {
             {
                 std::lock_guard migrationLock(coreMigrationMutex);
-                auto thisShared{shared_from_this()};
-                coreId = state.scheduler->GetOptimalCoreForThread(thisShared).id;
-                state.scheduler->InsertThread(thisShared);
+                coreId = state.scheduler->GetOptimalCoreForThread(this).id;
+                state.scheduler->InsertThread(this);
             }
 
             running = true;
             killed = false;
             statusCondition.notify_all();
             if (self) {
-                pthread = pthread_self();
                 lock.unlock();
+
+                // Unlike the workers of the thread pool, the calling thread doesn't have the signal handlers for running guest code installed
+                std::array<char, 16> threadName;
+                pthread_getname_np(pthread_self(), threadName.data(), threadName.size());
+                pthread_setname_np(pthread_self(), fmt::format("HOS-{}", id).c_str());
+                Logger::UpdateTag();
+                InstallSignalHandlers();
+
                 StartThread();
+
+                pthread_setname_np(pthread_self(), threadName.data());
+                Logger::UpdateTag();
             } else {
-                thread = std::thread(&KThread::StartThread, this);
-                pthread = thread.native_handle();
+                state.threadPool->Run(shared_from_this());
             }
         }
     }
@@ -241,32 +233,6 @@ namespace skyline::kernel::type {
             pthread_kill(pthread, signal);
     }
 
-    void KThread::ArmPreemptionTimer(std::chrono::nanoseconds timeToFire) {
-        std::unique_lock lock(statusMutex);
-        statusCondition.wait(lock, [this]() { return ready || killed; });
-        if (!killed && running) {
-            struct itimerspec spec{.it_value = {
-                .tv_nsec = std::min(static_cast<i64>(timeToFire.count()), constant::NsInSecond),
-                .tv_sec = std::max(std::chrono::duration_cast<std::chrono::seconds>(timeToFire).count() - 1, 0LL),
-            }};
-            timer_settime(preemptionTimer, 0, &spec, nullptr);
-            isPreempted = true;
-        }
-    }
-
-    void KThread::DisarmPreemptionTimer() {
-        if (!isPreempted) [[unlikely]]
-            return;
-
-        std::unique_lock lock(statusMutex);
-        statusCondition.wait(lock, [this]() { return ready || killed; });
-        if (!killed && running) {
-            struct itimerspec spec{};
-            timer_settime(preemptionTimer, 0, &spec, nullptr);
-            isPreempted = false;
-        }
-    }
-
     void KThread::UpdatePriorityInheritance() {
         auto waitingOn{waitThread};
         i8 currentPriority{priority.load()};
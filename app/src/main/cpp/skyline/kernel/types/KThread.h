@@ -6,6 +6,7 @@
 #include <csetjmp>
 #include <nce/guest.h>
 #include <kernel/scheduler.h>
+#include <kernel/profiler.h>
 #include <common/signal.h>
 #include "KSyncObject.h"
 #include "KPrivateMemory.h"
@@ -19,16 +20,17 @@ namespace skyline {
         class KThread : public KSyncObject, public std::enable_shared_from_this<KThread> {
           private:
             KProcess *parent;
-            std::thread thread; //!< If this KThread is backed by a host thread then this'll hold it
             pthread_t pthread{}; //!< The pthread_t for the host thread running this guest thread
-            timer_t preemptionTimer{}; //!< A kernel timer used for preemption interrupts
 
             /**
              * @brief Entry function any guest threads, sets up necessary context and jumps into guest code from the calling thread
-             * @note This function also serves as the entry point for host threads created in StartThread
+             * @note This function is run on a host thread from the HostThreadPool unless the thread was started on the calling thread
+             * @note The signal handlers for running guest code must be installed on the calling thread prior to this
              */
             void StartThread();
 
+            friend HostThreadPool;
+
           public:
             std::mutex statusMutex; //!< Synchronizes all thread state changes (running/ready/killed)
             std::condition_variable statusCondition; //!< Signalled on the status of the thread changing
@@ -58,26 +60,38 @@ namespace skyline {
             u64 timesliceStart{}; //!< A timestamp in host CNTVCT ticks of when the thread's current timeslice started
             u64 averageTimeslice{}; //!< A weighted average of the timeslice duration for this thread
 
-            bool isPreempted{}; //!< If the preemption timer has been armed and will fire
+            bool isPreempted{}; //!< If the thread's timeslice has been armed on its core and it'll be preempted on expiry
+            std::chrono::steady_clock::time_point preemptionDeadline{}; //!< The time at which the thread's armed timeslice expires, this is used to discard preemption signals for an earlier timeslice
             bool pendingYield{}; //!< If the thread has been yielded and hasn't been acted upon it yet
             bool forceYield{}; //!< If the thread has been forcefully yielded by another thread
 
             std::mutex waiterMutex; //!< Synchronizes operations on mutation of the waiter members
             u32 *waitKey; //!< The key of the mutex which this thread is waiting on
             KHandle waitTag; //!< The handle of the thread which requested the mutex lock
-            std::shared_ptr<KThread> waitThread; //!< The thread which this thread is waiting on
-            std::list<std::shared_ptr<type::KThread>> waiters; //!< A queue of threads waiting on this thread sorted by priority
+            KThread *waitThread{}; //!< The thread which this thread is waiting on, this is a borrowed reference as all threads are owned by their process
+            std::list<KThread *> waiters; //!< A queue of threads waiting on this thread sorted by priority, these are borrowed references as all threads are owned by their process
+
+            void *syncWaitAddress{}; //!< The address this thread is waiting on in its process's sync waiter table, this is nullptr if it isn't waiting
+            KThread *syncWaitPrevious{}; //!< The previous waiter in the sync waiter bucket this thread is waiting in
+            KThread *syncWaitNext{}; //!< The next waiter in the sync waiter bucket this thread is waiting in
 
             bool isCancellable{false}; //!< If the thread is currently in a position where it's cancellable
             bool cancelSync{false}; //!< Whether to cancel the SvcWaitSynchronization call this thread currently is in/the next one it joins
             type::KSyncObject *wakeObject{}; //!< A pointer to the synchronization object responsible for waking this thread up
 
+            std::atomic<Profiler::ThreadBuffer *> profilerBuffer{}; //!< The buffer that samples of this thread are recorded into by the profiler, this is nullptr if it isn't being profiled
+
             KThread(const DeviceState &state, KHandle handle, KProcess *parent, size_t id, void *entry, u64 argument, void *stackTop, i8 priority, u8 idealCore);
 
             ~KThread();
 
             /**
-             * @param self If the calling thread should jump directly into guest code or if a new thread should be created for it
+             * @brief Installs the signal handlers required for running guest code on the calling host thread
+             */
+            static void InstallSignalHandlers();
+
+            /**
+             * @param self If the calling thread should jump directly into guest code or if it should be run on a host thread from the pool
              * @note If the thread is already running then this does nothing
              * @note 'stack' will be created if it wasn't set prior to calling this
              */
@@ -93,16 +107,6 @@ namespace skyline {
              */
             void SendSignal(int signal);
 
-            /**
-             * @brief Arms the preemption kernel timer to fire in the specified amount of time
-             */
-            void ArmPreemptionTimer(std::chrono::nanoseconds timeToFire);
-
-            /**
-             * @brief Disarms the preemption kernel timer, any scheduled firings will be cancelled
-             */
-            void DisarmPreemptionTimer();
-
             /**
              * @brief Recursively updates the priority for any threads this thread might be waiting on
              * @note PI is performed by temporarily upgrading a thread's priority if a thread waiting on it has a higher priority to prevent priority inversion
@@ -112,7 +116,7 @@ namespace skyline {
             /**
              * @return If the supplied priority value is higher than the supplied thread's priority value
              */
-            static constexpr bool IsHigherPriority(const i8 priority, const std::shared_ptr<type::KThread> &it) {
+            static constexpr bool IsHigherPriority(const i8 priority, const KThread *it) {
                 return priority < it->priority;
             }
         };
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <common.h>
+#include <nce.h>
 
 namespace skyline::loader {
     /**
@@ -14,8 +15,16 @@ namespace skyline::loader {
          * @brief The contents and offset of an executable segment
          */
         struct Segment {
-            std::vector<u8> contents; //!< The raw contents of the segment
+            std::vector<u8> contents; //!< The raw contents of the segment, this is unused if the segment is a view
+            span<const u8> view; //!< A view into the backing the segment is loaded from, this avoids a copy for segments that aren't modified prior to being mapped
             size_t offset; //!< The offset from the base address to load the segment at
+
+            /**
+             * @return The contents of the segment regardless of if it's a view or not
+             */
+            span<const u8> Data() const {
+                return view.empty() ? span<const u8>{contents} : view;
+            }
         };
 
         Segment text; //!< The .text segment container
@@ -30,5 +39,7 @@ namespace skyline::loader {
 
         RelativeSegment dynsym; //!< The .dynsym segment relative to .rodata
         RelativeSegment dynstr; //!< The .dynstr segment relative to .rodata
+
+        std::optional<nce::NCE::PatchData> patch; //!< The patch data of the .text segment, this can be computed ahead of loading the executable on another thread otherwise it's computed during loading
     };
 }
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vfs/os_backing.h>
+#include <vfs/os_filesystem.h>
+#include "nro.h"
+#include "nso.h"
+#include "nca.h"
+#include "xci.h"
+#include "nsp.h"
+#include "library_scanner.h"
+
+namespace skyline::loader {
+    LibraryScanner::LibraryScanner(const std::string &appFilesPath) : keyStore(std::make_shared<crypto::KeyStore>(appFilesPath)), cachePath(appFilesPath + "library_cache/"), creationTime(time(nullptr)) {
+        vfs::OsFileSystem cache(cachePath); // This creates the cache directory if it doesn't exist
+    }
+
+    LibraryScanner::~LibraryScanner() {
+        PruneCache();
+    }
+
+    std::optional<std::string> LibraryScanner::GetCacheKey(int fd, language::SystemLanguage systemLanguage) {
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo))
+            return std::nullopt;
+
+        std::array<u8, IdentityHashSize> buffer;
+        auto read{pread64(fd, buffer.data(), buffer.size(), 0)};
+        if (read < 0)
+            return std::nullopt;
+
+        // 64-bit FNV-1a, this only needs to be stable across runs rather than cryptographically secure
+        u64 hash{0xCBF29CE484222325};
+        for (auto byte : span(buffer).first(static_cast<size_t>(read))) {
+            hash ^= byte;
+            hash *= 0x100000001B3;
+        }
+
+        auto modificationTime{static_cast<u64>(fileInfo.st_mtim.tv_sec) * constant::NsInSecond + static_cast<u64>(fileInfo.st_mtim.tv_nsec)};
+        return fmt::format("{:016X}-{:016X}-{:016X}-{}", static_cast<u64>(fileInfo.st_size), modificationTime, hash, static_cast<u32>(systemLanguage));
+    }
+
+    std::optional<LibraryScanner::ApplicationMetadata> LibraryScanner::ReadCache(const std::string &key) {
+        try {
+            vfs::OsFileSystem cache(cachePath);
+            if (!cache.FileExists(key))
+                return std::nullopt;
+
+            auto file{cache.OpenFile(key)};
+            auto header{file->Read<CacheHeader>()};
+            if (header.magic != CacheHeader{}.magic || header.version != CacheVersion || file->size != sizeof(CacheHeader) + header.nameSize + header.publisherSize + header.iconSize)
+                return std::nullopt;
+
+            ApplicationMetadata metadata{.hasNacp = header.hasNacp != 0};
+            size_t offset{sizeof(CacheHeader)};
+
+            metadata.name.resize(header.nameSize);
+            file->Read(span(metadata.name), offset);
+            offset += header.nameSize;
+
+            metadata.publisher.resize(header.publisherSize);
+            file->Read(span(metadata.publisher), offset);
+            offset += header.publisherSize;
+
+            metadata.icon.resize(header.iconSize);
+            file->Read(span(metadata.icon), offset);
+
+            utimensat(AT_FDCWD, (cachePath + key).c_str(), nullptr, 0); // The modification time is used to determine the least recently used entries during pruning
+            return metadata;
+        } catch (const std::exception &e) {
+            Logger::Warn("Failed to read library cache entry '{}': {}", key, e.what());
+            return std::nullopt;
+        }
+    }
+
+    void LibraryScanner::WriteCache(const std::string &key, const ApplicationMetadata &metadata) {
+        try {
+            CacheHeader header{
+                .hasNacp = metadata.hasNacp,
+                .nameSize = static_cast<u32>(metadata.name.size()),
+                .publisherSize = static_cast<u32>(metadata.publisher.size()),
+                .iconSize = static_cast<u32>(metadata.icon.size()),
+            };
+
+            std::vector<u8> contents(sizeof(CacheHeader) + header.nameSize + header.publisherSize + header.iconSize);
+            auto output{contents.begin()};
+            output = std::copy_n(reinterpret_cast<const u8 *>(&header), sizeof(CacheHeader), output);
+            output = std::copy(metadata.name.begin(), metadata.name.end(), output);
+            output = std::copy(metadata.publisher.begin(), metadata.publisher.end(), output);
+            std::copy(metadata.icon.begin(), metadata.icon.end(), output);
+
+            // The entry is written to a temporary file and then renamed so a concurrent or interrupted scan never observes a partial entry
+            auto temporaryName{fmt::format("{}.{}.tmp", key, gettid())};
+            vfs::OsFileSystem cache(cachePath);
+            if (!cache.CreateFile(temporaryName, contents.size()))
+                return;
+            cache.OpenFile(temporaryName, {false, true, false})->Write(contents);
+
+            if (rename((cachePath + temporaryName).c_str(), (cachePath + key).c_str()))
+                Logger::Warn("Failed to commit library cache entry '{}': {}", key, strerror(errno));
+        } catch (const std::exception &e) {
+            Logger::Warn("Failed to write library cache entry '{}': {}", key, e.what());
+        }
+    }
+
+    void LibraryScanner::PruneCache() {
+        auto directory{opendir(cachePath.c_str())};
+        if (!directory)
+            return;
+
+        struct CacheEntry {
+            std::string name;
+            timespec lastUse;
+            size_t size;
+        };
+        std::vector<CacheEntry> entries;
+        size_t totalSize{};
+
+        int directoryFd{dirfd(directory)};
+        while (auto entry{readdir(directory)}) {
+            struct stat entryInfo;
+            if (fstatat(directoryFd, entry->d_name, &entryInfo, 0) || !S_ISREG(entryInfo.st_mode))
+                continue;
+
+            if (std::string_view(entry->d_name).ends_with(".tmp")) {
+                if (entryInfo.st_mtim.tv_sec < creationTime)
+                    unlinkat(directoryFd, entry->d_name, 0);
+                continue;
+            }
+
+            entries.push_back({entry->d_name, entryInfo.st_mtim, static_cast<size_t>(entryInfo.st_size)});
+            totalSize += static_cast<size_t>(entryInfo.st_size);
+        }
+
+        if (totalSize > MaxCacheSize) {
+            std::sort(entries.begin(), entries.end(), [](const CacheEntry &a, const CacheEntry &b) {
+                return std::tie(a.lastUse.tv_sec, a.lastUse.tv_nsec) < std::tie(b.lastUse.tv_sec, b.lastUse.tv_nsec);
+            });
+
+            size_t evicted{};
+            for (auto it{entries.begin()}; it != entries.end() && totalSize > MaxCacheSize; it++, evicted++) {
+                unlinkat(directoryFd, it->name.c_str(), 0);
+                totalSize -= it->size;
+            }
+            Logger::Debug("Evicted {} library cache entries", evicted);
+        }
+
+        closedir(directory);
+    }
+
+    LibraryScanner::ApplicationMetadata LibraryScanner::Parse(const ScanRequest &request, language::SystemLanguage systemLanguage) {
+        ApplicationMetadata metadata{};
+        try {
+            auto backing{std::make_shared<vfs::OsBacking>(request.fd)};
+
+            std::unique_ptr<Loader> loader;
+            switch (request.format) {
+                case RomFormat::NRO:
+                    loader = std::make_unique<NroLoader>(backing);
+                    break;
+                case RomFormat::NSO:
+                    loader = std::make_unique<NsoLoader>(backing);
+                    break;
+                case RomFormat::NCA:
+                    loader = std::make_unique<NcaLoader>(backing, keyStore);
+                    break;
+                case RomFormat::XCI:
+                    loader = std::make_unique<XciLoader>(backing, keyStore, true);
+                    break;
+                case RomFormat::NSP:
+                    loader = std::make_unique<NspLoader>(backing, keyStore, true);
+                    break;
+                default:
+                    metadata.result = LoaderResult::ParsingError;
+                    return metadata;
+            }
+
+            if (loader->nacp) {
+                auto language{language::GetApplicationLanguage(systemLanguage)};
+                if (((1 << static_cast<u32>(language)) & loader->nacp->supportedTitleLanguages) == 0)
+                    language = loader->nacp->GetFirstSupportedTitleLanguage();
+
+                metadata.hasNacp = true;
+                metadata.name = loader->nacp->GetApplicationName(language);
+                metadata.publisher = loader->nacp->GetApplicationPublisher(language);
+                metadata.icon = loader->GetIcon(language);
+            }
+        } catch (const loader_exception &e) {
+            metadata = {.result = e.error};
+        } catch (const std::exception &e) {
+            metadata = {.result = LoaderResult::ParsingError};
+        }
+
+        return metadata;
+    }
+
+    LibraryScanner::ApplicationMetadata LibraryScanner::Scan(const ScanRequest &request, language::SystemLanguage systemLanguage) {
+        auto key{GetCacheKey(request.fd, systemLanguage)};
+        if (key)
+            if (auto cached{ReadCache(*key)})
+                return *cached;
+
+        auto metadata{Parse(request, systemLanguage)};
+
+        // Failures aren't cached as they might be resolved by importing keys without the file itself changing
+        if (key && metadata.result == LoaderResult::Success)
+            WriteCache(*key, metadata);
+
+        return metadata;
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common/language.h>
+#include <crypto/key_store.h>
+#include <vfs/filesystem.h>
+#include "loader.h"
+
+namespace skyline::loader {
+    /**
+     * @brief The LibraryScanner class extracts the metadata displayed in the game library from ROM files
+     * @note A single KeyStore is shared by all files in a scan and only the control NCA of NSPs and XCIs is parsed
+     * @note Successfully extracted metadata is cached on disk keyed by the identity of the file, unchanged files are not parsed again on subsequent scans
+     * @note The cache is bounded in size, the least recently used entries are evicted when the scanner is destroyed
+     * @note Scan is thread-safe, the library is scanned by calling it concurrently from a pool of worker threads
+     */
+    class LibraryScanner {
+      public:
+        /**
+         * @brief The metadata of a single ROM file
+         */
+        struct ApplicationMetadata {
+            LoaderResult result{LoaderResult::Success};
+            bool hasNacp{}; //!< If the ROM contained an NACP, the strings and icon are only valid if this is true
+            std::string name;
+            std::string publisher;
+            std::vector<u8> icon; //!< The raw JPEG icon of the application
+        };
+
+        struct ScanRequest {
+            int fd; //!< A readable FD to the ROM, this isn't closed by the scanner
+            RomFormat format;
+        };
+
+      private:
+        static constexpr u32 CacheVersion{1}; //!< This must be incremented when the cache format or the extracted metadata changes
+        static constexpr size_t IdentityHashSize{0x1000}; //!< The amount of bytes from the start of a file which are hashed for its identity
+        static constexpr size_t MaxCacheSize{32 * 1024 * 1024}; //!< The maximum total size of all cache files, this is dominated by icons and fits several hundred entries
+
+        /**
+         * @brief The header of a cache file, it's followed by the name, publisher and icon
+         */
+        struct CacheHeader {
+            u32 magic{util::MakeMagic<u32>("SLMC")};
+            u32 version{CacheVersion};
+            u32 hasNacp;
+            u32 nameSize;
+            u32 publisherSize;
+            u32 iconSize;
+        };
+
+        std::shared_ptr<crypto::KeyStore> keyStore;
+        std::string cachePath; //!< The path to the directory holding all cache files
+        time_t creationTime; //!< The time at which the scanner was created, temporary cache files older than this were left behind by an interrupted scan
+
+        /**
+         * @return A string uniquely identifying the contents of the file and the language used for the metadata, this is used as the name of the cache file
+         * @note The identity consists of the size and modification time of the file alongside a hash of the start of the file, this detects replaced files without reading them in entirety
+         */
+        static std::optional<std::string> GetCacheKey(int fd, language::SystemLanguage systemLanguage);
+
+        std::optional<ApplicationMetadata> ReadCache(const std::string &key);
+
+        void WriteCache(const std::string &key, const ApplicationMetadata &metadata);
+
+        /**
+         * @brief Evicts the least recently used cache entries until the cache fits within MaxCacheSize and deletes any stale temporary files
+         * @note The modification time of an entry is updated whenever it's read, so it reflects the last use of the entry
+         */
+        void PruneCache();
+
+        /**
+         * @brief Parses the ROM file to extract its metadata without consulting the cache
+         */
+        ApplicationMetadata Parse(const ScanRequest &request, language::SystemLanguage systemLanguage);
+
+      public:
+        /**
+         * @param appFilesPath The path to the internal app data directory, this is used to read the keys and to store the cache
+         */
+        LibraryScanner(const std::string &appFilesPath);
+
+        ~LibraryScanner();
+
+        /**
+         * @brief Retrieves the metadata of a single ROM file, from the cache if possible
+         */
+        ApplicationMetadata Scan(const ScanRequest &request, language::SystemLanguage systemLanguage);
+    };
+}
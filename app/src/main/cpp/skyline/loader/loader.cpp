@@ -14,8 +14,8 @@ namespace skyline::loader {
         u8 *base{reinterpret_cast<u8 *>(process->memory.base.address + offset)};
 
         u64 textSize{executable.text.contents.size()};
-        u64 roSize{executable.ro.contents.size()};
-        u64 dataSize{executable.data.contents.size() + executable.bssSize};
+        u64 roSize{executable.ro.Data().size()};
+        u64 dataSize{executable.data.Data().size() + executable.bssSize};
 
         if (!util::IsPageAligned(textSize) || !util::IsPageAligned(roSize) || !util::IsPageAligned(dataSize))
             throw exception("LoadProcessData: Sections are not aligned with page size: 0x{:X}, 0x{:X}, 0x{:X}", textSize, roSize, dataSize);
@@ -23,7 +23,7 @@ namespace skyline::loader {
         if (!util::IsPageAligned(executable.text.offset) || !util::IsPageAligned(executable.ro.offset) || !util::IsPageAligned(executable.data.offset))
             throw exception("LoadProcessData: Section offsets are not aligned with page size: 0x{:X}, 0x{:X}, 0x{:X}", executable.text.offset, executable.ro.offset, executable.data.offset);
 
-        auto patch{state.nce->GetPatchData(executable.text.contents)};
+        auto patch{executable.patch ? std::move(*executable.patch) : nce::NCE::GetPatchData(executable.text.contents)};
         auto size{patch.size + textSize + roSize + dataSize};
 
         process->NewHandle<kernel::type::KPrivateMemory>(base, patch.size, memory::Permission{false, false, false}, memory::states::Reserved); // ---
@@ -40,8 +40,8 @@ namespace skyline::loader {
 
         state.nce->PatchCode(executable.text.contents, reinterpret_cast<u32 *>(base), patch.size, patch.offsets);
         std::memcpy(base + patch.size + executable.text.offset, executable.text.contents.data(), textSize);
-        std::memcpy(base + patch.size + executable.ro.offset, executable.ro.contents.data(), roSize);
-        std::memcpy(base + patch.size + executable.data.offset, executable.data.contents.data(), dataSize - executable.bssSize);
+        std::memcpy(base + patch.size + executable.ro.offset, executable.ro.Data().data(), roSize);
+        std::memcpy(base + patch.size + executable.data.offset, executable.data.Data().data(), dataSize - executable.bssSize);
 
         auto rodataOffset{base + patch.size + executable.ro.offset};
         ExecutableSymbolicInfo symbolicInfo{
@@ -53,7 +53,13 @@ namespace skyline::loader {
             .symbols = span(reinterpret_cast<Elf64_Sym *>(rodataOffset + executable.dynsym.offset), executable.dynsym.size / sizeof(Elf64_Sym)),
             .symbolStrings = span(reinterpret_cast<char *>(rodataOffset + executable.dynstr.offset), executable.dynstr.size),
         };
-        executables.insert(std::upper_bound(executables.begin(), executables.end(), base, [](void *ptr, const ExecutableSymbolicInfo &it) { return ptr < it.patchStart; }), symbolicInfo);
+
+        for (auto &symbol : symbolicInfo.symbols)
+            if (symbol.st_size && symbol.st_name && symbol.st_name < symbolicInfo.symbolStrings.size())
+                symbolicInfo.sortedSymbols.push_back(&symbol);
+        std::sort(symbolicInfo.sortedSymbols.begin(), symbolicInfo.sortedSymbols.end(), [](const Elf64_Sym *a, const Elf64_Sym *b) { return a->st_value < b->st_value; });
+
+        executables.insert(std::upper_bound(executables.begin(), executables.end(), base, [](void *ptr, const ExecutableSymbolicInfo &it) { return ptr < it.patchStart; }), std::move(symbolicInfo));
 
         return {base, size, base + patch.size};
     }
@@ -62,10 +68,10 @@ namespace skyline::loader {
         auto executable{std::lower_bound(executables.begin(), executables.end(), ptr, [](const ExecutableSymbolicInfo &it, void *ptr) { return it.programEnd < ptr; })};
         if (executable != executables.end() && ptr >= executable->patchStart && ptr <= executable->programEnd) {
             if (ptr >= executable->programStart) {
-                auto offset{reinterpret_cast<u8 *>(ptr) - reinterpret_cast<u8 *>(executable->programStart)};
-                auto symbol{std::find_if(executable->symbols.begin(), executable->symbols.end(), [&offset](const Elf64_Sym &sym) { return sym.st_value <= offset && sym.st_value + sym.st_size > offset; })};
-                if (symbol != executable->symbols.end() && symbol->st_name && symbol->st_name < executable->symbolStrings.size()) {
-                    return {executable->symbolStrings.data() + symbol->st_name, executable->name};
+                u64 offset{static_cast<u64>(reinterpret_cast<u8 *>(ptr) - reinterpret_cast<u8 *>(executable->programStart))};
+                auto symbol{std::upper_bound(executable->sortedSymbols.begin(), executable->sortedSymbols.end(), offset, [](u64 offset, const Elf64_Sym *sym) { return offset < sym->st_value; })};
+                if (symbol != executable->sortedSymbols.begin() && (*--symbol)->st_value + (*symbol)->st_size > offset) {
+                    return {executable->symbolStrings.data() + (*symbol)->st_name, executable->name};
                 } else {
                     return {.executableName = executable->name};
                 }
@@ -60,6 +60,7 @@ namespace skyline::loader {
             std::string patchName; //!< The name of the patch section
             span<Elf64_Sym> symbols; //!< A span over the .dynsym section
             span<char> symbolStrings; //!< A span over the .dynstr section
+            std::vector<Elf64_Sym *> sortedSymbols; //!< All named symbols with a non-zero size from .dynsym sorted by their address, this is used to binary search for symbols
         };
 
         std::vector<ExecutableSymbolicInfo> executables;
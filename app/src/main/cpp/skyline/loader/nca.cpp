@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
+#include <common/trace.h>
 #include <kernel/types/KProcess.h>
 #include <vfs/npdm.h>
 #include "nso.h"
@@ -19,25 +21,53 @@ namespace skyline::loader {
         if (!exeFs->FileExists("rtld"))
             throw exception("Cannot load an ExeFS that doesn't contain rtld");
 
-        auto nsoFile{exeFs->OpenFile("rtld")};
+        // Reading, decompressing and scanning every NSO for instructions to patch doesn't depend on any other NSO or the process, so they're all done concurrently
+        // Only mapping the NSOs into the address space needs to be done in order as the offset of every NSO depends on the size of the ones prior to it
+        struct PendingNso {
+            std::string name;
+            std::future<Executable> executable;
+        };
+        std::vector<PendingNso> pendingNsos;
+        for (const auto &nso : {"rtld", "main", "subsdk0", "subsdk1", "subsdk2", "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"}) {
+            if (!exeFs->FileExists(nso))
+                continue;
 
-        state.process->memory.InitializeVmm(process->npdm.meta.flags.type);
+            std::string name{nso + std::string(".nso")};
+            pendingNsos.push_back({name, std::async(std::launch::async, [backing{exeFs->OpenFile(nso)}, name]() {
+                pthread_setname_np(pthread_self(), "Sky-LoadNso");
+                TRACE_EVENT_FMT("loader", "ReadNso {}", name);
+                auto executable{NsoLoader::ReadNso(backing)};
+                {
+                    TRACE_EVENT_FMT("loader", "GetPatchData {}", name);
+                    executable.patch = nce::NCE::GetPatchData(executable.text.contents);
+                }
+                return executable;
+            })});
+        }
 
-        auto loadInfo{NsoLoader::LoadNso(loader, nsoFile, process, state, 0, "rtld.nso")};
-        u64 offset{loadInfo.size};
-        u8 *base{loadInfo.base};
-        void *entry{loadInfo.entry};
+        {
+            TRACE_EVENT("loader", "InitializeVmm");
+            state.process->memory.InitializeVmm(process->npdm.meta.flags.type);
+        }
 
-        Logger::Info("Loaded 'rtld.nso' at 0x{:X} (.text @ 0x{:X})", base, entry);
+        u8 *base{};
+        void *entry{};
+        u64 offset{};
+        for (auto &pendingNso : pendingNsos) {
+            auto executable{[&]() {
+                TRACE_EVENT_FMT("loader", "WaitNso {}", pendingNso.name);
+                return pendingNso.executable.get();
+            }()};
 
-        for (const auto &nso : {"main", "subsdk0", "subsdk1", "subsdk2", "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"}) {
-            if (exeFs->FileExists(nso))
-                nsoFile = exeFs->OpenFile(nso);
-            else
-                continue;
+            TRACE_EVENT_FMT("loader", "LoadExecutable {}", pendingNso.name);
+            auto loadInfo{loader->LoadExecutable(process, state, executable, offset, pendingNso.name)};
+            if (!base) {
+                // rtld is always the first NSO, it's placed at the base of the code region and the process is started at its entry point
+                base = loadInfo.base;
+                entry = loadInfo.entry;
+            }
 
-            loadInfo = NsoLoader::LoadNso(loader, nsoFile, process, state, offset, nso + std::string(".nso"));
-            Logger::Info("Loaded '{}.nso' at 0x{:X} (.text @ 0x{:X})", nso, base + offset, loadInfo.entry);
+            Logger::Info("Loaded '{}' at 0x{:X} (.text @ 0x{:X})", pendingNso.name, base + offset, loadInfo.entry);
             offset += loadInfo.size;
         }
 
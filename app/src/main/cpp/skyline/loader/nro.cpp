@@ -44,17 +44,23 @@ namespace skyline::loader {
         return buffer;
     }
 
+    Executable::Segment NroLoader::GetSegmentView(const NroSegmentHeader &segment, size_t offset) {
+        Executable::Segment output{.offset = offset};
+        output.view = backing->GetView(segment.offset, segment.size);
+        if (output.view.empty())
+            output.contents = GetSegment(segment);
+        return output;
+    }
+
     void *NroLoader::LoadProcessData(const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state) {
         Executable executable{};
 
         executable.text.contents = GetSegment(header.text);
         executable.text.offset = 0;
 
-        executable.ro.contents = GetSegment(header.ro);
-        executable.ro.offset = header.text.size;
-
-        executable.data.contents = GetSegment(header.data);
-        executable.data.offset = header.text.size + header.ro.size;
+        // .rodata and .data are copied directly into guest memory without modification, so they can be a view into the NRO when it's memory-mapped
+        executable.ro = GetSegmentView(header.ro, header.text.size);
+        executable.data = GetSegmentView(header.data, header.text.size + header.ro.size);
 
         executable.bssSize = header.bssSize;
 
@@ -67,6 +67,12 @@ namespace skyline::loader {
          */
         std::vector<u8> GetSegment(const NroSegmentHeader &segment);
 
+        /**
+         * @brief Loads the specified segment as a view into the backing if it supports views, otherwise the segment is read into a buffer
+         * @note This must not be used for segments that are modified prior to being mapped, such as .text which is patched
+         */
+        Executable::Segment GetSegmentView(const NroSegmentHeader &segment, size_t offset);
+
       public:
         NroLoader(std::shared_ptr<vfs::Backing> backing);
 
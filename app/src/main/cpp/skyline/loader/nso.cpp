@@ -18,10 +18,16 @@ namespace skyline::loader {
         std::vector<u8> outputBuffer(segment.decompressedSize);
 
         if (compressedSize) {
-            std::vector<u8> compressedBuffer(compressedSize);
-            backing->Read(compressedBuffer, segment.fileOffset);
-
-            LZ4_decompress_safe(reinterpret_cast<char *>(compressedBuffer.data()), reinterpret_cast<char *>(outputBuffer.data()), static_cast<int>(compressedSize), static_cast<int>(segment.decompressedSize));
+            // The compressed data can be decompressed directly out of the backing if it supports views, otherwise it needs to be read into an intermediate buffer
+            std::vector<u8> compressedBuffer;
+            span<const u8> compressed{backing->GetView(segment.fileOffset, compressedSize)};
+            if (compressed.empty()) {
+                compressedBuffer.resize(compressedSize);
+                backing->Read(compressedBuffer, segment.fileOffset);
+                compressed = compressedBuffer;
+            }
+
+            LZ4_decompress_safe(reinterpret_cast<const char *>(compressed.data()), reinterpret_cast<char *>(outputBuffer.data()), static_cast<int>(compressedSize), static_cast<int>(segment.decompressedSize));
         } else {
             backing->Read(outputBuffer, segment.fileOffset);
         }
@@ -29,7 +35,7 @@ namespace skyline::loader {
         return outputBuffer;
     }
 
-    Loader::ExecutableLoadInfo NsoLoader::LoadNso(Loader *loader, const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset, const std::string &name) {
+    Executable NsoLoader::ReadNso(const std::shared_ptr<vfs::Backing> &backing) {
         auto header{backing->Read<NsoHeader>()};
 
         if (header.magic != util::MakeMagic<u32>("NSO0"))
@@ -56,6 +62,11 @@ namespace skyline::loader {
             executable.dynstr = {header.dynstr.offset, header.dynstr.size};
         }
 
+        return executable;
+    }
+
+    Loader::ExecutableLoadInfo NsoLoader::LoadNso(Loader *loader, const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset, const std::string &name) {
+        auto executable{ReadNso(backing)};
         return loader->LoadExecutable(process, state, executable, offset, name);
     }
 
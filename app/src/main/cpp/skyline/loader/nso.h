@@ -80,6 +80,13 @@ namespace skyline::loader {
       public:
         NsoLoader(std::shared_ptr<vfs::Backing> backing);
 
+        /**
+         * @brief Reads an NSO and decompresses all of its segments without loading it into memory
+         * @param backing The backing that the NSO is contained within
+         * @note This doesn't depend on any emulator state and can be called from any thread
+         */
+        static Executable ReadNso(const std::shared_ptr<vfs::Backing> &backing);
+
         /**
          * @brief Loads an NSO into memory, offset by the given amount
          * @param backing The backing that the NSO is contained within
@@ -22,7 +22,7 @@ namespace skyline::loader {
         }
     }
 
-    NspLoader::NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore) : nsp(std::make_shared<vfs::PartitionFileSystem>(backing)) {
+    NspLoader::NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, bool metadataOnly) : nsp(std::make_shared<vfs::PartitionFileSystem>(backing)) {
         ExtractTickets(nsp, keyStore);
 
         auto root{nsp->OpenDirectory("", {false, true})};
@@ -31,11 +31,19 @@ namespace skyline::loader {
                 continue;
 
             try {
-                auto nca{vfs::NCA(nsp->OpenFile(entry.name), keyStore)};
-
-                if (nca.contentType == vfs::NcaContentType::Program && nca.romFs != nullptr && nca.exeFs != nullptr)
+                auto ncaBacking{nsp->OpenFile(entry.name)};
+                // Only the control NCA is required for metadata, the type of every NCA is checked from its header prior to setting up its sections
+                std::optional<vfs::NCA> nca;
+                if (metadataOnly)
+                    nca = vfs::NCA::OpenIfContentType(std::move(ncaBacking), keyStore, vfs::NcaContentType::Control);
+                else
+                    nca.emplace(std::move(ncaBacking), keyStore);
+                if (!nca)
+                    continue;
+
+                if (nca->contentType == vfs::NcaContentType::Program && nca->romFs != nullptr && nca->exeFs != nullptr)
                     programNca = std::move(nca);
-                else if (nca.contentType == vfs::NcaContentType::Control && nca.romFs != nullptr)
+                else if (nca->contentType == vfs::NcaContentType::Control && nca->romFs != nullptr)
                     controlNca = std::move(nca);
             } catch (const loader_exception &e) {
                 throw loader_exception(e.error);
@@ -44,10 +52,11 @@ namespace skyline::loader {
             }
         }
 
-        if (!programNca || !controlNca)
+        if ((!programNca && !metadataOnly) || !controlNca)
             throw exception("Incomplete NSP file");
 
-        romFs = programNca->romFs;
+        if (programNca)
+            romFs = programNca->romFs;
         controlRomFs = std::make_shared<vfs::RomFileSystem>(controlNca->romFs);
         nacp.emplace(controlRomFs->OpenFile("control.nacp"));
     }
@@ -22,7 +22,10 @@ namespace skyline::loader {
         std::optional<vfs::NCA> controlNca; //!< The main control NCA within the NSP
 
       public:
-        NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore);
+        /**
+         * @param metadataOnly If only the control NCA should be parsed, this is sufficient for GetIcon and the NACP but the loader cannot be used to load the application
+         */
+        NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, bool metadataOnly = false);
 
         std::vector<u8> GetIcon(language::ApplicationLanguage language) override;
 
@@ -8,7 +8,7 @@
 #include "xci.h"
 
 namespace skyline::loader {
-    XciLoader::XciLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore) {
+    XciLoader::XciLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, bool metadataOnly) {
         header = backing->Read<GamecardHeader>();
 
         if (header.magic != util::MakeMagic<u32>("HEAD"))
@@ -36,11 +36,19 @@ namespace skyline::loader {
                     continue;
 
                 try {
-                    auto nca{vfs::NCA(secure->OpenFile(entry.name), keyStore, true)};
-
-                    if (nca.contentType == vfs::NcaContentType::Program && nca.romFs != nullptr && nca.exeFs != nullptr)
+                    auto ncaBacking{secure->OpenFile(entry.name)};
+                    // Only the control NCA is required for metadata, the type of every NCA is checked from its header prior to setting up its sections
+                    std::optional<vfs::NCA> nca;
+                    if (metadataOnly)
+                        nca = vfs::NCA::OpenIfContentType(std::move(ncaBacking), keyStore, vfs::NcaContentType::Control, true);
+                    else
+                        nca.emplace(std::move(ncaBacking), keyStore, true);
+                    if (!nca)
+                        continue;
+
+                    if (nca->contentType == vfs::NcaContentType::Program && nca->romFs != nullptr && nca->exeFs != nullptr)
                         programNca = std::move(nca);
-                    else if (nca.contentType == vfs::NcaContentType::Control && nca.romFs != nullptr)
+                    else if (nca->contentType == vfs::NcaContentType::Control && nca->romFs != nullptr)
                         controlNca = std::move(nca);
                 } catch (const loader_exception &e) {
                     throw loader_exception(e.error);
@@ -52,10 +60,11 @@ namespace skyline::loader {
             throw exception("Corrupted secure partition");
         }
 
-        if (!programNca || !controlNca)
+        if ((!programNca && !metadataOnly) || !controlNca)
             throw exception("Incomplete XCI file");
 
-        romFs = programNca->romFs;
+        if (programNca)
+            romFs = programNca->romFs;
         controlRomFs = std::make_shared<vfs::RomFileSystem>(controlNca->romFs);
         nacp.emplace(controlRomFs->OpenFile("control.nacp"));
     }
@@ -3,6 +3,7 @@
 
 #include <cxxabi.h>
 #include <unistd.h>
+#include "common/settings.h"
 #include "common/signal.h"
 #include "common/trace.h"
 #include "os.h"
@@ -28,7 +29,14 @@ namespace skyline::nce {
         try {
             if (svc) [[likely]] {
                 TRACE_EVENT("kernel", perfetto::StaticString{svc.name});
-                (svc.function)(state);
+                auto &svcStatistics{state.nce->svcStatistics};
+                if (svcStatistics) [[unlikely]] {
+                    i64 start{util::GetTimeNs()};
+                    (svc.function)(state);
+                    svcStatistics->Record(state.thread->coreId, svcId, util::GetTimeNs() - start);
+                } else {
+                    (svc.function)(state);
+                }
             } else {
                 throw exception("Unimplemented SVC 0x{:X}", svcId);
             }
@@ -143,6 +151,8 @@ namespace skyline::nce {
 
     NCE::NCE(const DeviceState &state) : state(state) {
         signal::SetTlsRestorer(&NceTlsRestorer);
+        if (state.settings->svcStatistics)
+            svcStatistics = std::make_unique<kernel::svc::SvcStatistics>();
     }
 
     constexpr u8 MainSvcTrampolineSize{17}; // Size of the main SVC trampoline function in u32 units
@@ -5,6 +5,7 @@
 
 #include "common.h"
 #include <sys/wait.h>
+#include "kernel/svc_statistics.h"
 
 namespace skyline::nce {
     /**
@@ -34,6 +35,8 @@ namespace skyline::nce {
          */
         static void SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls);
 
+        std::unique_ptr<kernel::svc::SvcStatistics> svcStatistics; //!< Statistics of all SVC calls, this is nullptr if they aren't being collected
+
         NCE(const DeviceState &state);
 
         struct PatchData {
@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
+#include "common/settings.h"
+#include "common/trace.h"
 #include "nce.h"
 #include "nce/guest.h"
 #include "kernel/types/KProcess.h"
+#include "kernel/profiler.h"
+#include "kernel/snapshot.h"
 #include "vfs/os_backing.h"
+#include "vfs/cached_backing.h"
 #include "loader/nro.h"
 #include "loader/nso.h"
 #include "loader/nca.h"
@@ -28,35 +34,73 @@ namespace skyline::kernel {
           systemLanguage(systemLanguage) {}
 
     void OS::Execute(int romFd, loader::RomFormat romType) {
-        auto romFile{std::make_shared<vfs::OsBacking>(romFd)};
-        auto keyStore{std::make_shared<crypto::KeyStore>(appFilesPath)};
+        vfs::BlockCache::Get().SetCapacity(static_cast<size_t>(state.settings->blockCacheSize) * 1024 * 1024);
+
+        auto romFile{std::make_shared<vfs::OsBacking>(romFd, false, vfs::Backing::Mode{true, false, false}, true)};
+
+        // Parsing the keys is only required for encrypted formats, it's done concurrently with creating the process as they don't depend on each other
+        std::future<std::shared_ptr<crypto::KeyStore>> keyStoreFuture;
+        if (romType == loader::RomFormat::NCA || romType == loader::RomFormat::NSP || romType == loader::RomFormat::XCI)
+            keyStoreFuture = std::async(std::launch::async, [this]() {
+                pthread_setname_np(pthread_self(), "Sky-KeyStore");
+                TRACE_EVENT("loader", "KeyStore");
+                return std::make_shared<crypto::KeyStore>(appFilesPath);
+            });
+
+        auto &process{state.process};
+        {
+            TRACE_EVENT("loader", "CreateProcess");
+            process = std::make_shared<kernel::type::KProcess>(state);
+        }
 
         state.loader = [&]() -> std::shared_ptr<loader::Loader> {
+            TRACE_EVENT("loader", "CreateLoader");
+            auto keyStore{[&]() {
+                TRACE_EVENT("loader", "WaitKeyStore");
+                return keyStoreFuture.get();
+            }};
+
             switch (romType) {
                 case loader::RomFormat::NRO:
                     return std::make_shared<loader::NroLoader>(std::move(romFile));
                 case loader::RomFormat::NSO:
                     return std::make_shared<loader::NsoLoader>(std::move(romFile));
                 case loader::RomFormat::NCA:
-                    return std::make_shared<loader::NcaLoader>(std::move(romFile), std::move(keyStore));
+                    return std::make_shared<loader::NcaLoader>(std::move(romFile), keyStore());
                 case loader::RomFormat::NSP:
-                    return std::make_shared<loader::NspLoader>(romFile, keyStore);
+                    return std::make_shared<loader::NspLoader>(romFile, keyStore());
                 case loader::RomFormat::XCI:
-                    return std::make_shared<loader::XciLoader>(romFile, keyStore);
+                    return std::make_shared<loader::XciLoader>(romFile, keyStore());
                 default:
                     throw exception("Unsupported ROM extension.");
             }
         }();
 
-        auto &process{state.process};
-        process = std::make_shared<kernel::type::KProcess>(state);
-        auto entry{state.loader->LoadProcessData(process, state)};
-        process->InitializeHeapTls();
+        void *entry;
+        {
+            TRACE_EVENT("loader", "LoadProcessData");
+            entry = state.loader->LoadProcessData(process, state);
+        }
+        {
+            TRACE_EVENT("loader", "InitializeHeapTls");
+            process->InitializeHeapTls();
+        }
         auto thread{process->CreateThread(entry)};
         if (thread) {
+            std::unique_ptr<Profiler> profiler; // This must outlive all guest threads as they write samples into buffers owned by it
+            if (state.settings->guestProfiler)
+                profiler = std::make_unique<Profiler>(state, appFilesPath + "guest_profile.folded");
+
+            std::unique_ptr<SnapshotWriter> snapshotWriter;
+            if (state.settings->guestSnapshots)
+                snapshotWriter = std::make_unique<SnapshotWriter>(state, appFilesPath + "snapshots/");
+
             Logger::Debug("Starting main HOS thread");
             thread->Start(true);
             process->Kill(true, true, true);
+
+            if (state.nce->svcStatistics)
+                Logger::Info("SVC Statistics:\n{}", state.nce->svcStatistics->Dump());
         }
     }
 }
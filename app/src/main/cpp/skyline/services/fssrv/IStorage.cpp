@@ -21,7 +21,11 @@ namespace skyline::service::fssrv {
             return result::InvalidSize;
         }
 
-        backing->Read(request.outputBuf.at(0), static_cast<size_t>(offset));
+        auto output{request.outputBuf.at(0)};
+        if (auto view{backing->GetView(static_cast<size_t>(offset), output.size())}; !view.empty())
+            output.copy_from(view);
+        else
+            backing->Read(output, static_cast<size_t>(offset));
         return {};
     }
 
@@ -11,7 +11,34 @@
 #include "GraphicBufferProducer.h"
 
 namespace skyline::service::hosbinder {
-    GraphicBufferProducer::GraphicBufferProducer(const DeviceState &state, nvdrv::core::NvMap &nvMap) : state(state), bufferEvent(std::make_shared<kernel::type::KEvent>(state, true)), nvMap(nvMap) {}
+    GraphicBufferProducer::GraphicBufferProducer(const DeviceState &state, nvdrv::core::NvMap &nvMap) : state(state), nvMap(nvMap), consumerReference(std::make_shared<ConsumerReference>(this)), bufferEvent(std::make_shared<kernel::type::KEvent>(state, true)) {}
+
+    GraphicBufferProducer::~GraphicBufferProducer() {
+        {
+            std::scoped_lock lock(consumerReference->mutex);
+            consumerReference->producer = nullptr;
+        }
+
+        // Any guest thread blocked in DequeueBuffer must leave it before the queue is destroyed
+        std::unique_lock lock(mutex);
+        abandoned = true;
+        bufferCondition.notify_all();
+        bufferCondition.wait(lock, [this] { return dequeueWaiterCount == 0; });
+    }
+
+    void GraphicBufferProducer::OnBufferConsumed(i32 slot, u64 slotFrameNumber) {
+        {
+            std::scoped_lock lock(mutex);
+            auto &buffer{queue[static_cast<size_t>(slot)]};
+            if (buffer.state != BufferState::Queued || buffer.frameNumber != slotFrameNumber)
+                return; // The slot was reset or reused while the frame was pending presentation
+
+            buffer.state = BufferState::Free;
+        }
+
+        bufferCondition.notify_all();
+        bufferEvent->Signal();
+    }
 
     void GraphicBufferProducer::FreeGraphicBufferNvMap(GraphicBuffer &buffer) {
         auto surface{buffer.graphicHandle.surfaces.at(0)};
@@ -58,6 +85,7 @@ namespace skyline::service::hosbinder {
 
         if (!count) {
             activeSlotCount = 0;
+            bufferCondition.notify_all();
             bufferEvent->Signal();
             return AndroidStatus::Ok;
         }
@@ -78,6 +106,7 @@ namespace skyline::service::hosbinder {
         }
 
         activeSlotCount = static_cast<u8>(count);
+        bufferCondition.notify_all();
         bufferEvent->Signal();
 
         return AndroidStatus::Ok;
@@ -92,21 +121,41 @@ namespace skyline::service::hosbinder {
         constexpr i32 InvalidGraphicBufferSlot{-1}; //!< https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/include/gui/BufferQueueCore.h;l=61
         slot = InvalidGraphicBufferSlot;
 
-        std::scoped_lock lock(mutex);
-        // We don't need a loop here since the consumer is blocking and instantly frees all buffers
-        // If a valid slot is not found on the first iteration then it would be stuck in an infinite loop
-        // As a result of this, we simply warn and return InvalidOperation to the guest
+        std::unique_lock lock(mutex);
+        // Queued buffers are freed by the presentation thread once it's done with them, we wait for that if there's no free buffer
+        // If there are no queued buffers then a valid slot can never become free by waiting, so we simply warn and return InvalidOperation to the guest
         auto buffer{queue.end()};
         size_t dequeuedSlotCount{};
-        for (auto it{queue.begin()}; it != std::min(queue.begin() + activeSlotCount, queue.end()); it++) {
-            // We want to select the oldest slot that's free to use as we'd want all slots to be used
-            // If we go linearly then we have a higher preference for selecting the former slots and being out of order
-            if (it->state == BufferState::Free) {
-                if (buffer == queue.end() || it->frameNumber < buffer->frameNumber)
-                    buffer = it;
-            } else if (it->state == BufferState::Dequeued) {
-                dequeuedSlotCount++;
+        u64 initialDisconnectCount{disconnectCount};
+        while (true) {
+            // A disconnected or abandoned queue will never have its queued buffers consumed, waiting on it would block the guest indefinitely
+            if (abandoned || disconnectCount != initialDisconnectCount) {
+                Logger::Warn("Buffer queue was {} while waiting for a free buffer", abandoned ? "abandoned" : "disconnected");
+                return AndroidStatus::NoInit;
+            }
+
+            size_t queuedSlotCount{};
+            for (auto it{queue.begin()}; it != std::min(queue.begin() + activeSlotCount, queue.end()); it++) {
+                // We want to select the oldest slot that's free to use as we'd want all slots to be used
+                // If we go linearly then we have a higher preference for selecting the former slots and being out of order
+                if (it->state == BufferState::Free) {
+                    if (buffer == queue.end() || it->frameNumber < buffer->frameNumber)
+                        buffer = it;
+                } else if (it->state == BufferState::Dequeued) {
+                    dequeuedSlotCount++;
+                } else if (it->state == BufferState::Queued) {
+                    queuedSlotCount++;
+                }
             }
+
+            if (buffer != queue.end() || async || !queuedSlotCount)
+                break;
+
+            dequeuedSlotCount = 0;
+            dequeueWaiterCount++;
+            bufferCondition.wait(lock);
+            if (--dequeueWaiterCount == 0 && abandoned)
+                bufferCondition.notify_all(); // Wake up the destructor which is waiting for all waiters to leave
         }
 
         if (buffer != queue.end()) {
@@ -172,6 +221,7 @@ namespace skyline::service::hosbinder {
             FreeGraphicBufferNvMap(*bufferSlot.graphicBuffer);
         bufferSlot.graphicBuffer = nullptr;
 
+        bufferCondition.notify_all();
         bufferEvent->Signal();
 
         Logger::Debug("#{}", slot);
@@ -198,6 +248,7 @@ namespace skyline::service::hosbinder {
         graphicBuffer = *std::exchange(bufferSlot->graphicBuffer, nullptr);
         fence = AndroidFence{};
 
+        bufferCondition.notify_all();
         bufferEvent->Signal();
 
         Logger::Debug("#{}", std::distance(queue.begin(), bufferSlot));
@@ -267,7 +318,7 @@ namespace skyline::service::hosbinder {
                 return AndroidStatus::BadValue;
         }
 
-        std::scoped_lock lock(mutex);
+        std::unique_lock lock(mutex);
         if (slot < 0 || slot >= queue.size()) [[unlikely]] {
             Logger::Warn("#{} was out of range", slot);
             return AndroidStatus::BadValue;
@@ -387,19 +438,28 @@ namespace skyline::service::hosbinder {
             auto &texture{buffer.texture};
             std::scoped_lock textureLock(*texture);
             texture->SynchronizeHost();
-            u64 frameId;
-            state.gpu->presentation.Present(texture, isAutoTimestamp ? 0 : timestamp, swapInterval, crop, scalingMode, transform, frameId);
         }
 
+        // The slot stays queued until the presentation thread has copied the texture, it's only freed and the buffer event signalled at that point
         buffer.frameNumber = ++frameNumber;
-        buffer.state = BufferState::Free;
-        bufferEvent->Signal();
+        buffer.state = BufferState::Queued;
 
         width = defaultWidth;
         height = defaultHeight;
         transformHint = state.gpu->presentation.GetTransformHint();
         pendingBufferCount = GetPendingBufferCount();
 
+        auto texture{buffer.texture};
+        auto onConsumed{[reference{consumerReference}, slot, slotFrameNumber{buffer.frameNumber}]() {
+            std::scoped_lock referenceLock(reference->mutex);
+            if (reference->producer)
+                reference->producer->OnBufferConsumed(slot, slotFrameNumber);
+        }};
+
+        // The lock must be released prior to presenting as the callback may be invoked synchronously when a queued frame is replaced, it also avoids blocking other calls while the guest waits for space in the present queue
+        lock.unlock();
+        state.gpu->presentation.Present(texture, isAutoTimestamp ? 0 : timestamp, swapInterval, crop, scalingMode, transform, std::move(onConsumed));
+
         Logger::Debug("#{} - {}Timestamp: {}, Crop: ({}-{})x({}-{}), Scale Mode: {}, Transform: {} [Sticky: {}], Swap Interval: {}, Is Async: {}", slot, isAutoTimestamp ? "Auto " : "", timestamp, crop.left, crop.right, crop.top, crop.bottom, ToString(scalingMode), ToString(transform), ToString(stickyTransform), swapInterval, async);
         return AndroidStatus::Ok;
     }
@@ -421,6 +481,7 @@ namespace skyline::service::hosbinder {
 
         buffer.state = BufferState::Free;
         buffer.frameNumber = 0;
+        bufferCondition.notify_all();
         bufferEvent->Signal();
 
         Logger::Debug("#{}", slot);
@@ -533,6 +594,9 @@ namespace skyline::service::hosbinder {
             slot.graphicBuffer = nullptr;
         }
 
+        disconnectCount++;
+        bufferCondition.notify_all();
+
         Logger::Debug("API: {}", ToString(api));
         return AndroidStatus::Ok;
     }
@@ -581,6 +645,7 @@ namespace skyline::service::hosbinder {
         preallocatedBufferCount = static_cast<u8>(std::count_if(queue.begin(), queue.end(), [](const BufferSlot &slot) { return slot.graphicBuffer && slot.isPreallocated; }));
         activeSlotCount = static_cast<u8>(std::count_if(queue.begin(), queue.end(), [](const BufferSlot &slot) { return slot.graphicBuffer != nullptr; }));
 
+        bufferCondition.notify_all();
         bufferEvent->Signal();
 
         return AndroidStatus::Ok;
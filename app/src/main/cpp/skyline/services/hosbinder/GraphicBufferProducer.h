@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <kernel/types/KEvent.h>
 #include "parcel.h"
 #include "android_types.h"
@@ -71,9 +72,30 @@ namespace skyline::service::hosbinder {
         NativeWindowApi connectedApi{NativeWindowApi::None}; //!< The API that the producer is currently connected to
         u64 frameNumber{}; //!< The amount of frames that have been presented so far
         nvdrv::core::NvMap &nvMap;
+        std::condition_variable bufferCondition; //!< Signalled when a queued buffer has been consumed by the presentation engine and is free again, or when the queue is disconnected or abandoned
+        u64 disconnectCount{}; //!< The amount of times the producer has been disconnected, a waiter in DequeueBuffer gives up if this changes
+        bool abandoned{}; //!< If the producer is being destroyed, no thread may start waiting on bufferCondition after this is set
+        size_t dequeueWaiterCount{}; //!< The amount of threads waiting on bufferCondition in DequeueBuffer, the destructor waits for this to reach zero
+
+        /**
+         * @brief A reference to the producer held by frames that are pending presentation, it's cleared when the producer is destroyed as the frames may outlive it
+         */
+        struct ConsumerReference {
+            std::mutex mutex;
+            GraphicBufferProducer *producer;
+
+            ConsumerReference(GraphicBufferProducer *producer) : producer(producer) {}
+        };
+        std::shared_ptr<ConsumerReference> consumerReference;
 
         void FreeGraphicBufferNvMap(GraphicBuffer &buffer);
 
+        /**
+         * @brief Frees a queued slot once the presentation engine is done with its texture, this is called from the presentation thread
+         * @param slotFrameNumber The frame number of the slot at the time it was queued, the slot isn't freed if it has been reset or requeued since
+         */
+        void OnBufferConsumed(i32 slot, u64 slotFrameNumber);
+
         /**
          * @return The amount of buffers which have been queued onto the consumer
          */
@@ -189,6 +211,8 @@ namespace skyline::service::hosbinder {
 
         GraphicBufferProducer(const DeviceState &state, nvdrv::core::NvMap &nvmap);
 
+        ~GraphicBufferProducer();
+
         /**
          * @brief The handler for Binder IPC transactions with IGraphicBufferProducer
          * @url https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/libs/gui/IGraphicBufferProducer.cpp;l=277-426
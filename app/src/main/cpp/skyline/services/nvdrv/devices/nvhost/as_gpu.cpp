@@ -19,6 +19,18 @@ namespace skyline::service::nvdrv::device::nvhost {
 
     AsGpu::AsGpu(const DeviceState &state, Driver &driver, Core &core, const SessionContext &ctx) : NvDevice(state, driver, core, ctx) {}
 
+    void AsGpu::GmmuMapLocked(u64 virt, u8 *cpuPtr, u64 size, bool sparse) {
+        asCtx->gmmu.Map(virt, cpuPtr, size, {sparse});
+        if (auto &capture{state.soc->pushBufferCapture})
+            capture->RecordMap(asCtx->captureId, virt, size, sparse);
+    }
+
+    void AsGpu::GmmuUnmapLocked(u64 virt, u64 size) {
+        asCtx->gmmu.Unmap(virt, size);
+        if (auto &capture{state.soc->pushBufferCapture})
+            capture->RecordUnmap(asCtx->captureId, virt, size);
+    }
+
     PosixResult AsGpu::BindChannel(In<FileDescriptor> channelFd) {
         std::scoped_lock lock(mutex);
 
@@ -76,7 +88,7 @@ namespace skyline::service::nvdrv::device::nvhost {
         u64 size{static_cast<u64>(pages) * pageSize};
 
         if (flags.sparse)
-            asCtx->gmmu.Map(offset, GMMU::SparsePlaceholderAddress(), size, {true});
+            GmmuMapLocked(offset, GMMU::SparsePlaceholderAddress(), size, true);
 
         allocationMap[offset] = {
             .size = size,
@@ -100,9 +112,9 @@ namespace skyline::service::nvdrv::device::nvhost {
         // Sparse mappings shouldn't be fully unmapped, just returned to their sparse state
         // Only FreeSpace can unmap them fully
         if (mapping->sparseAlloc)
-            asCtx->gmmu.Map(offset, GMMU::SparsePlaceholderAddress(), mapping->size, {true});
+            GmmuMapLocked(offset, GMMU::SparsePlaceholderAddress(), mapping->size, true);
         else
-            asCtx->gmmu.Unmap(offset, mapping->size);
+            GmmuUnmapLocked(offset, mapping->size);
 
         mappingMap.erase(offset);
     }
@@ -126,7 +138,7 @@ namespace skyline::service::nvdrv::device::nvhost {
 
             // Unset sparse flag if required
             if (allocation.sparse)
-                asCtx->gmmu.Unmap(offset, allocation.size);
+                GmmuUnmapLocked(offset, allocation.size);
 
             auto &allocator{pageSize == VM::PageSize ? *vm.smallPageAllocator : *vm.bigPageAllocator};
             u32 pageSizeBits{pageSize == VM::PageSize ? VM::PageSizeBits : vm.bigPageSizeBits};
@@ -161,9 +173,9 @@ namespace skyline::service::nvdrv::device::nvhost {
             // Sparse mappings shouldn't be fully unmapped, just returned to their sparse state
             // Only FreeSpace can unmap them fully
             if (mapping->sparseAlloc)
-                asCtx->gmmu.Map(offset, GMMU::SparsePlaceholderAddress(), mapping->size, {true});
+                GmmuMapLocked(offset, GMMU::SparsePlaceholderAddress(), mapping->size, true);
             else
-                asCtx->gmmu.Unmap(offset, mapping->size);
+                GmmuUnmapLocked(offset, mapping->size);
 
             mappingMap.erase(offset);
         } catch (const std::out_of_range &e) {
@@ -197,7 +209,7 @@ namespace skyline::service::nvdrv::device::nvhost {
                 u64 gpuAddress{offset + bufferOffset};
                 u8 *cpuPtr{mapping->ptr + bufferOffset};
 
-                asCtx->gmmu.Map(gpuAddress, cpuPtr, mappingSize);
+                GmmuMapLocked(gpuAddress, cpuPtr, mappingSize);
 
                 return PosixResult::Success;
             } catch (const std::out_of_range &e) {
@@ -219,7 +231,7 @@ namespace skyline::service::nvdrv::device::nvhost {
             if (alloc-- == allocationMap.begin() || (offset - alloc->first) + size > alloc->second.size)
                 throw exception("Cannot perform a fixed mapping into an unallocated region!");
 
-            asCtx->gmmu.Map(offset, cpuPtr, size);
+            GmmuMapLocked(offset, cpuPtr, size);
 
             auto mapping{std::make_shared<Mapping>(cpuPtr, offset, size, true, false, alloc->second.sparse)};
             alloc->second.mappings.push_back(mapping);
@@ -242,7 +254,7 @@ namespace skyline::service::nvdrv::device::nvhost {
             if (!offset)
                 throw exception("Failed to allocate free space in the GPU AS!");
 
-            asCtx->gmmu.Map(offset, cpuPtr, size);
+            GmmuMapLocked(offset, cpuPtr, size);
 
             auto mapping{std::make_shared<Mapping>(cpuPtr, offset, size, false, bigPage, false)};
             mappingMap[offset] = mapping;
@@ -324,6 +336,8 @@ namespace skyline::service::nvdrv::device::nvhost {
         vm.bigPageAllocator = std::make_unique<VM::Allocator>(startBigPages, endBigPages);
 
         asCtx = std::make_shared<soc::gm20b::AddressSpaceContext>();
+        if (auto &capture{state.soc->pushBufferCapture})
+            asCtx->captureId = capture->CreateAddressSpace();
         vm.initialised = true;
 
         return PosixResult::Success;
@@ -352,7 +366,7 @@ namespace skyline::service::nvdrv::device::nvhost {
             }
 
             if (!entry.handle) {
-                asCtx->gmmu.Map(virtAddr, GMMU::SparsePlaceholderAddress(), size, {true});
+                GmmuMapLocked(virtAddr, GMMU::SparsePlaceholderAddress(), size, true);
             } else {
                 auto h{core.nvMap.GetHandle(entry.handle)};
                 if (!h)
@@ -360,7 +374,7 @@ namespace skyline::service::nvdrv::device::nvhost {
 
                 u8 *cpuPtr{reinterpret_cast<u8 *>(h->address + (static_cast<u64>(entry.handleOffsetBigPages) << vm.bigPageSizeBits))};
 
-                asCtx->gmmu.Map(virtAddr, cpuPtr, size);
+                GmmuMapLocked(virtAddr, cpuPtr, size);
             }
         }
 
@@ -73,6 +73,16 @@ namespace skyline::service::nvdrv::device::nvhost {
 
         void FreeMappingLocked(u64 offset);
 
+        /**
+         * @brief Maps a region into the GMMU and records the mapping if pushbuffers are being captured
+         */
+        void GmmuMapLocked(u64 virt, u8 *cpuPtr, u64 size, bool sparse = false);
+
+        /**
+         * @brief Unmaps a region from the GMMU and records the unmapping if pushbuffers are being captured
+         */
+        void GmmuUnmapLocked(u64 virt, u64 size);
+
       public:
         struct MappingFlags {
             bool fixed : 1;
@@ -171,6 +171,8 @@ namespace skyline::service::nvdrv::device::nvhost {
         }
 
         channelCtx = std::make_unique<soc::gm20b::ChannelContext>(state, asCtx, numEntries);
+        if (auto &capture{state.soc->pushBufferCapture})
+            channelCtx->captureId = capture->CreateChannel(asCtx->captureId);
 
         fence = core.syncpointManager.GetSyncpointFence(channelSyncpoint);
 
@@ -187,6 +189,8 @@ namespace skyline::service::nvdrv::device::nvhost {
 
         // Map onto the GPU
         asCtx->gmmu.Map(pushBufferAddr, reinterpret_cast<u8 *>(pushBufferMemory.data()), pushBufferSize);
+        if (auto &capture{state.soc->pushBufferCapture})
+            capture->RecordMap(asCtx->captureId, pushBufferAddr, pushBufferSize, false);
 
         return PosixResult::Success;
     }
@@ -6,6 +6,7 @@
 #include "soc/smmu.h"
 #include "soc/host1x.h"
 #include "soc/gm20b/gpfifo.h"
+#include "soc/gm20b/pushbuffer_capture.h"
 
 namespace skyline::soc {
     /**
@@ -16,7 +17,11 @@ namespace skyline::soc {
       public:
         SMMU smmu;
         host1x::Host1x host1x;
+        std::unique_ptr<gm20b::PushBufferCapture> pushBufferCapture; //!< Records the workload of all GPU channels, this is only created when capturing is enabled
 
-        SOC(const DeviceState &state) : host1x(state) {}
+        /**
+         * @param capturePath The path to capture GPU pushbuffers to, no capture is performed if this is empty
+         */
+        SOC(const DeviceState &state, const std::string &capturePath = {}) : host1x(state), pushBufferCapture(capturePath.empty() ? nullptr : std::make_unique<gm20b::PushBufferCapture>(capturePath)) {}
     };
 }
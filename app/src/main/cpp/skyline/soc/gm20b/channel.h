@@ -5,6 +5,8 @@
 
 #include <gpu/interconnect/command_executor.h>
 #include "engines/engine.h"
+#include "engines/maxwell_dma.h"
+#include "engines/kepler_memory.h"
 #include "gpfifo.h"
 
 namespace skyline::soc::gm20b {
@@ -12,6 +14,10 @@ namespace skyline::soc::gm20b {
         class Maxwell3D;
     }
 
+    namespace engine::fermi2d {
+        class Fermi2D;
+    }
+
     struct AddressSpaceContext;
 
     /**
@@ -21,13 +27,19 @@ namespace skyline::soc::gm20b {
     struct ChannelContext {
         std::shared_ptr<AddressSpaceContext> asCtx;
         gpu::interconnect::CommandExecutor executor;
-        engine::Engine fermi2D;
+        std::unique_ptr<engine::fermi2d::Fermi2D> fermi2D;
         std::unique_ptr<engine::maxwell3d::Maxwell3D> maxwell3D; //!< TODO: fix this once graphics context is moved into a cpp file
         engine::Engine maxwellCompute;
-        engine::Engine maxwellDma;
-        engine::Engine keplerMemory;
+        engine::MaxwellDma maxwellDma;
+        engine::KeplerMemory keplerMemory;
         ChannelGpfifo gpfifo;
+        u32 captureId{}; //!< The ID of the channel in the pushbuffer capture, this is only valid when capturing
 
         ChannelContext(const DeviceState &state, std::shared_ptr<AddressSpaceContext> asCtx, size_t numEntries);
+
+        /**
+         * @note This is defined out-of-line as the engines held by pointer are only complete in the implementation
+         */
+        ~ChannelContext();
     };
 }
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <soc/gm20b/engines/maxwell/types.h>
+
+namespace skyline::soc::gm20b::engine::fermi2d::type {
+    #pragma pack(push, 1)
+
+    /**
+     * @brief A source or destination surface of the 2D engine
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/master/classes/twod/cl902d.h
+     */
+    struct Surface {
+        using ColorFormat = maxwell3d::type::RenderTarget::ColorFormat; //!< The 2D engine shares the encoding of color formats with the 3D engine
+
+        enum class MemoryLayout : u32 {
+            BlockLinear = 0,
+            Pitch = 1,
+        };
+
+        ColorFormat format;
+        MemoryLayout memoryLayout;
+        struct {
+            u8 widthLog2 : 3; //!< The width of a block in GOBs with log2 encoding, this must be 0
+            u8 _pad0_ : 1;
+            u8 heightLog2 : 3; //!< The height of a block in GOBs with log2 encoding
+            u8 _pad1_ : 1;
+            u8 depthLog2 : 3; //!< The depth of a block in GOBs with log2 encoding
+            u32 _pad2_ : 21;
+        } blockSize;
+        u32 depth;
+        u32 layer;
+        u32 pitch; //!< The pitch of the surface in bytes, this is only valid for pitch surfaces
+        u32 width;
+        u32 height;
+        maxwell3d::type::Address address;
+    };
+    static_assert(sizeof(Surface) == (0xA * sizeof(u32)));
+
+    struct SampleMode {
+        enum class Origin : u8 {
+            Center = 0, //!< The source coordinates refer to the center of the first destination pixel
+            Corner = 1, //!< The source coordinates refer to the top-left corner of the first destination pixel
+        };
+
+        enum class Filter : u8 {
+            Point = 0,
+            Bilinear = 1,
+        };
+
+        Origin origin : 1;
+        u8 _pad0_ : 3;
+        Filter filter : 1;
+        u32 _pad1_ : 27;
+    };
+    static_assert(sizeof(SampleMode) == sizeof(u32));
+
+    #pragma pack(pop)
+}
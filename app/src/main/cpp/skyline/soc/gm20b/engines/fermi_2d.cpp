@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <soc.h>
+#include "fermi_2d.h"
+
+namespace skyline::soc::gm20b::engine::fermi2d {
+    Fermi2D::Fermi2D(const DeviceState &state, ChannelContext &channelCtx, gpu::interconnect::CommandExecutor &executor) : Engine(state), context(*state.gpu, channelCtx, executor) {}
+
+    void Fermi2D::CallMethod(u32 method, u32 argument, bool lastCall) {
+        Logger::Debug("Called method in Fermi 2D: 0x{:X} args: 0x{:X}", method, argument);
+
+        if (method >= RegisterCount) [[unlikely]] {
+            Logger::Warn("Called method outside of Fermi 2D register space: 0x{:X} args: 0x{:X}", method, argument);
+            return;
+        }
+
+        registers.raw[method] = argument;
+
+        // The blit is triggered by writing the integer part of the source Y coordinate which is the upper word of the fixed-point value
+        #define FERMI2D_OFFSET(field) (sizeof(typeof(Registers::field)) - sizeof(typeof(*Registers::field))) / sizeof(u32)
+        #define FERMI2D_STRUCT_OFFSET(field, member) FERMI2D_OFFSET(field) + U32_OFFSET(typeof(*Registers::field), member)
+        if (method == FERMI2D_STRUCT_OFFSET(pixelsFromMemory, srcY0) + 1)
+            Blit();
+        #undef FERMI2D_OFFSET
+        #undef FERMI2D_STRUCT_OFFSET
+    }
+
+    void Fermi2D::Blit() {
+        auto &pixelsFromMemory{*registers.pixelsFromMemory};
+
+        // Fixed-point values are converted to floating-point as the fractional precision beyond that is irrelevant for any realistic surface size
+        auto fixedToFloat{[](i64 value) {
+            return static_cast<float>(static_cast<double>(value) / static_cast<double>(1ULL << 32));
+        }};
+
+        context.Blit(*registers.srcSurface, *registers.dstSurface,
+                     fixedToFloat(pixelsFromMemory.srcX0), fixedToFloat(pixelsFromMemory.srcY0),
+                     pixelsFromMemory.dstX0, pixelsFromMemory.dstY0, pixelsFromMemory.dstWidth, pixelsFromMemory.dstHeight,
+                     fixedToFloat(pixelsFromMemory.duDx), fixedToFloat(pixelsFromMemory.dvDy),
+                     pixelsFromMemory.sampleMode);
+    }
+}
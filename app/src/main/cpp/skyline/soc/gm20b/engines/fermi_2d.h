@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <gpu/interconnect/blit_context.h>
+#include "engine.h"
+#include "fermi/types.h"
+
+namespace skyline::soc::gm20b {
+    struct ChannelContext;
+}
+
+namespace skyline::soc::gm20b::engine::fermi2d {
+    /**
+     * @brief The Fermi 2D engine handles copying and scaling rectangles between surfaces
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/master/classes/twod/cl902d.h
+     */
+    class Fermi2D : public Engine {
+      private:
+        gpu::interconnect::BlitContext context;
+
+        /**
+         * @brief Performs the blit described by the current register state
+         */
+        void Blit();
+
+      public:
+        static constexpr u32 RegisterCount{0x258}; //!< The number of Fermi 2D registers
+
+        #pragma pack(push, 1)
+        union Registers {
+            std::array<u32, RegisterCount> raw;
+
+            template<size_t Offset, typename Type>
+            using Register = util::OffsetMember<Offset, Type, u32>;
+
+            Register<0x80, type::Surface> dstSurface;
+            Register<0x8C, type::Surface> srcSurface;
+
+            struct PixelsFromMemory {
+                u32 blockShape; // 0x220
+                u32 corralSize; // 0x221
+                u32 safeOverlap; // 0x222
+                type::SampleMode sampleMode; // 0x223
+                u32 _pad0_[8];
+                u32 dstX0; // 0x22C
+                u32 dstY0; // 0x22D
+                u32 dstWidth; // 0x22E
+                u32 dstHeight; // 0x22F
+                i64 duDx; // 0x230, A signed 32.32 fixed-point value with the fractional part first
+                i64 dvDy; // 0x232
+                i64 srcX0; // 0x234
+                i64 srcY0; // 0x236, Writing the integer part of this triggers the blit
+            };
+            static_assert(sizeof(PixelsFromMemory) == (0x18 * sizeof(u32)));
+            Register<0x220, PixelsFromMemory> pixelsFromMemory;
+        };
+        static_assert(sizeof(Registers) == (RegisterCount * sizeof(u32)));
+        #pragma pack(pop)
+
+        Registers registers{};
+
+        Fermi2D(const DeviceState &state, ChannelContext &channelCtx, gpu::interconnect::CommandExecutor &executor);
+
+        void CallMethod(u32 method, u32 argument, bool lastCall);
+    };
+}
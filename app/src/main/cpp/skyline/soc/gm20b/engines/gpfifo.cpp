@@ -29,7 +29,9 @@ namespace skyline::soc::gm20b::engine {
                 if (action.operation == Registers::SyncpointOperation::Incr) {
                     Logger::Debug("Increment syncpoint: {}", +action.index);
                     channelCtx.executor.Execute();
-                    state.soc->host1x.syncpoints.at(action.index).Increment();
+                    u32 value{state.soc->host1x.syncpoints.at(action.index).Increment()};
+                    if (auto &capture{state.soc->pushBufferCapture})
+                        capture->RecordSyncpointIncrement(channelCtx.captureId, action.index, value);
                 } else if (action.operation == Registers::SyncpointOperation::Wait) {
                     Logger::Debug("Wait syncpoint: {}, thresh: {}", +action.index, registers.syncpoint.payload);
 
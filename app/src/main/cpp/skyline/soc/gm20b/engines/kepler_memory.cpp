@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/trace.h>
+#include <gpu/texture/block_linear.h>
+#include <soc.h>
+#include "kepler_memory.h"
+
+namespace skyline::soc::gm20b::engine {
+    KeplerMemory::KeplerMemory(const DeviceState &state, ChannelContext &channelCtx) : Engine(state), channelCtx(channelCtx) {}
+
+    void KeplerMemory::CallMethod(u32 method, u32 argument, bool lastCall) {
+        Logger::Debug("Called method in Kepler Memory: 0x{:X} args: 0x{:X}", method, argument);
+
+        if (method >= RegisterCount) [[unlikely]] {
+            Logger::Warn("Called method outside of Kepler Memory register space: 0x{:X} args: 0x{:X}", method, argument);
+            return;
+        }
+
+        #define KEPLER_MEMORY_OFFSET(field) (sizeof(typeof(Registers::field)) - sizeof(typeof(*Registers::field))) / sizeof(u32)
+        // Inline data is written in non-incrementing runs of potentially thousands of words, this is the hot path so it's checked first
+        if (method == KEPLER_MEMORY_OFFSET(loadInlineData)) [[likely]] {
+            LoadInlineData(argument);
+            return;
+        }
+
+        registers.raw[method] = argument;
+
+        if (method == KEPLER_MEMORY_OFFSET(launchDma))
+            LaunchDma();
+        #undef KEPLER_MEMORY_OFFSET
+    }
+
+    void KeplerMemory::LaunchDma() {
+        if (inlineDataSize)
+            Logger::Warn("Launching a new inline transfer with {}/{} bytes of the previous transfer outstanding", inlineData.size() * sizeof(u32), inlineDataSize);
+
+        inlineDataSize = static_cast<size_t>(*registers.lineLengthIn) * *registers.lineCount;
+        inlineData.clear();
+        inlineData.reserve(util::AlignUp(inlineDataSize, sizeof(u32)) / sizeof(u32));
+
+        // A transfer without any data completes immediately as no inline data will be supplied for it
+        if (!inlineDataSize)
+            CompleteTransfer();
+    }
+
+    void KeplerMemory::LoadInlineData(u32 data) {
+        if (!inlineDataSize) [[unlikely]] {
+            Logger::Warn("Inline data supplied without an active transfer: 0x{:X}", data);
+            return;
+        }
+
+        inlineData.push_back(data);
+        if (inlineData.size() * sizeof(u32) >= inlineDataSize)
+            FlushInlineData();
+    }
+
+    void KeplerMemory::FlushInlineData() {
+        TRACE_EVENT("gpu", "KeplerMemory::FlushInlineData", "size", inlineDataSize);
+
+        // The last word may be partially filled, only the bytes of the transfer itself are written
+        auto data{span(inlineData).cast<u8>().first(inlineDataSize)};
+        if (registers.launchDma->dstMemoryLayout == Registers::LaunchDma::MemoryLayout::Pitch)
+            FlushPitch(data);
+        else
+            FlushBlockLinear(data);
+
+        inlineDataSize = 0;
+        inlineData.clear();
+
+        CompleteTransfer();
+    }
+
+    void KeplerMemory::CompleteTransfer() {
+        if (registers.launchDma->completionType != Registers::LaunchDma::CompletionType::ReleaseSemaphore)
+            return;
+
+        struct FourWordResult {
+            u64 value;
+            u64 timestamp;
+        };
+
+        u64 address{registers.semaphore->address.Pack()};
+        u32 payload{registers.semaphore->payload};
+        switch (registers.launchDma->semaphoreStructSize) {
+            case Registers::LaunchDma::SemaphoreStructSize::OneWord:
+                channelCtx.asCtx->gmmu.Write<u32>(address, payload);
+                break;
+
+            case Registers::LaunchDma::SemaphoreStructSize::FourWords: {
+                // Convert the current nanosecond time to GPU ticks
+                constexpr i64 NsToTickNumerator{384};
+                constexpr i64 NsToTickDenominator{625};
+
+                i64 nsTime{util::GetTimeNs()};
+                i64 timestamp{(nsTime / NsToTickDenominator) * NsToTickNumerator + ((nsTime % NsToTickDenominator) * NsToTickNumerator) / NsToTickDenominator};
+
+                channelCtx.asCtx->gmmu.Write<FourWordResult>(address, FourWordResult{payload, static_cast<u64>(timestamp)});
+                break;
+            }
+        }
+    }
+
+    void KeplerMemory::FlushPitch(span<u8> data) {
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        u64 destination{registers.offsetOut->Pack()};
+        u32 lineLength{*registers.lineLengthIn}, lineCount{*registers.lineCount}, pitch{*registers.pitchOut};
+
+        if (lineCount == 1 || pitch == lineLength) {
+            gmmu.Write(destination, data.data(), data.size());
+            return;
+        }
+
+        for (u32 line{}; line < lineCount; line++)
+            gmmu.Write(destination + static_cast<u64>(line) * pitch, data.data() + static_cast<size_t>(line) * lineLength, lineLength);
+    }
+
+    void KeplerMemory::FlushBlockLinear(span<u8> data) {
+        auto &surface{*registers.dstSurface};
+        if (surface.blockSize.width != 0)
+            Logger::Warn("Unsupported inline transfer surface block width: {}", 1U << surface.blockSize.width);
+
+        gpu::BlockLinearLayout layout{
+            .widthBytes = surface.width,
+            .height = surface.height,
+            .depth = std::max(surface.depth, 1U),
+            .blockHeight = 1U << surface.blockSize.height,
+            .blockDepth = 1U << surface.blockSize.depth,
+        };
+
+        u32 lineLength{*registers.lineLengthIn}, lineCount{*registers.lineCount};
+        if (surface.originX + lineLength > util::AlignUp(layout.widthBytes, gpu::BlockLinearLayout::GobWidth) || surface.originY + lineCount > util::AlignUp(layout.height, gpu::BlockLinearLayout::GobHeight * layout.blockHeight)) {
+            Logger::Warn("Inline transfer region ({}, {}) + ({}, {}) exceeds block-linear surface: {}x{}", surface.originX, surface.originY, lineLength, lineCount, layout.widthBytes, layout.height);
+            return;
+        }
+
+        if (surface.layer >= layout.depth) {
+            Logger::Warn("Inline transfer layer {} exceeds block-linear surface depth: {}", surface.layer, layout.depth);
+            return;
+        }
+
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        u64 destination{registers.offsetOut->Pack()};
+        u8 *surfacePointer{gmmu.TranslateContiguous(destination, layout.GetSize())};
+        if (surfacePointer) {
+            gpu::CopyBlockLinearRegion<false>(layout, surfacePointer, surface.originX, surface.originY, surface.layer, data.data(), lineLength, lineLength, lineCount);
+            return;
+        }
+
+        // The surface isn't contiguous in host memory (split across mappings, sparse or partially unmapped), each sector is written through the GMMU instead
+        // Staging the entire surface isn't viable as it would require reading unmapped parts of it and writing back bytes outside the transfer region
+        for (u32 line{}; line < lineCount; line++) {
+            u8 *lineData{data.data() + static_cast<size_t>(line) * lineLength};
+            gpu::ForEachBlockLinearSpan(layout, surface.originX, surface.originY + line, surface.layer, lineLength, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                gmmu.Write(destination + surfaceOffset, lineData + lineOffset, size);
+            });
+        }
+    }
+}
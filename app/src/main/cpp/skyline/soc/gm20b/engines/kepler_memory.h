@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include "engine.h"
+
+namespace skyline::soc::gm20b {
+    struct ChannelContext;
+}
+
+namespace skyline::soc::gm20b::engine {
+    /**
+     * @brief The Kepler Memory engine handles uploading data supplied inline in the pushbuffer to GPU memory (Inline-to-Memory)
+     */
+    class KeplerMemory : public Engine {
+      private:
+        ChannelContext &channelCtx;
+        std::vector<u32> inlineData; //!< The data of the current transfer, this is accumulated across all LoadInlineData calls and written to guest memory at once
+        size_t inlineDataSize{}; //!< The size of the current transfer in bytes, this is 0 if there's no active transfer
+
+        /**
+         * @brief Begins a new transfer with the current register state
+         */
+        void LaunchDma();
+
+        void LoadInlineData(u32 data);
+
+        /**
+         * @brief Writes the accumulated data of the transfer to guest memory in its destination layout
+         */
+        void FlushInlineData();
+
+        void FlushPitch(span<u8> data);
+
+        void FlushBlockLinear(span<u8> data);
+
+        /**
+         * @brief Performs the completion action of the transfer once all of its data has been written, this releases the semaphore if requested
+         */
+        void CompleteTransfer();
+
+      public:
+        static constexpr u32 RegisterCount{0x80}; //!< The number of Kepler Memory registers
+
+        #pragma pack(push, 1)
+        union Registers {
+            std::array<u32, RegisterCount> raw;
+
+            template<size_t Offset, typename Type>
+            using Register = util::OffsetMember<Offset, Type, u32>;
+
+            struct Address {
+                u32 high;
+                u32 low;
+
+                u64 Pack() {
+                    return (static_cast<u64>(high) << 32) | low;
+                }
+            };
+            static_assert(sizeof(Address) == sizeof(u64));
+
+            Register<0x60, u32> lineLengthIn;
+            Register<0x61, u32> lineCount;
+            Register<0x62, Address> offsetOut;
+            Register<0x64, u32> pitchOut;
+
+            struct Surface {
+                struct {
+                    u8 width : 4; //!< Log2 of the width of a block in GOBs, this must be 0
+                    u8 height : 4; //!< Log2 of the height of a block in GOBs
+                    u8 depth : 4; //!< Log2 of the depth of a block in GOBs
+                    u8 _pad0_ : 4;
+                    u16 _pad1_;
+                } blockSize; // 0x65
+                u32 width; // 0x66
+                u32 height; // 0x67
+                u32 depth; // 0x68
+                u32 layer; // 0x69
+                u32 originX; // 0x6A, this is in bytes
+                u32 originY; // 0x6B
+            };
+            static_assert(sizeof(Surface) == (0x7 * sizeof(u32)));
+            Register<0x65, Surface> dstSurface;
+
+            struct LaunchDma {
+                enum class MemoryLayout : u32 {
+                    BlockLinear = 0,
+                    Pitch = 1,
+                };
+
+                enum class CompletionType : u32 {
+                    FlushDisable = 0,
+                    FlushOnly = 1,
+                    ReleaseSemaphore = 2,
+                };
+
+                enum class SemaphoreStructSize : u32 {
+                    FourWords = 0,
+                    OneWord = 1,
+                };
+
+                MemoryLayout dstMemoryLayout : 1;
+                bool reductionEnable : 1;
+                u32 _pad0_ : 2;
+                CompletionType completionType : 2;
+                u32 _pad1_ : 2;
+                u32 interruptType : 2;
+                u32 _pad2_ : 2;
+                SemaphoreStructSize semaphoreStructSize : 1;
+                u32 reductionOp : 3;
+                u32 reductionFormat : 2;
+                u32 _pad3_ : 2;
+                bool sysmembarDisable : 1;
+                u32 _pad4_ : 11;
+            };
+            static_assert(sizeof(LaunchDma) == sizeof(u32));
+            Register<0x6C, LaunchDma> launchDma;
+
+            Register<0x6D, u32> loadInlineData;
+
+            struct Semaphore {
+                Address address; // 0x77
+                u32 payload; // 0x79
+            };
+            static_assert(sizeof(Semaphore) == (0x3 * sizeof(u32)));
+            Register<0x77, Semaphore> semaphore;
+        };
+        static_assert(sizeof(Registers) == (RegisterCount * sizeof(u32)));
+        #pragma pack(pop)
+
+        Registers registers{};
+
+        KeplerMemory(const DeviceState &state, ChannelContext &channelCtx);
+
+        void CallMethod(u32 method, u32 argument, bool lastCall);
+    };
+}
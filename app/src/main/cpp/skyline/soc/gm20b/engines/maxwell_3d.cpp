@@ -250,7 +250,9 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
             MAXWELL3D_CASE(syncpointAction, {
                 Logger::Debug("Increment syncpoint: {}", static_cast<u16>(syncpointAction.id));
                 channelCtx.executor.Execute();
-                state.soc->host1x.syncpoints.at(syncpointAction.id).Increment();
+                u32 value{state.soc->host1x.syncpoints.at(syncpointAction.id).Increment()};
+                if (auto &capture{state.soc->pushBufferCapture})
+                    capture->RecordSyncpointIncrement(channelCtx.captureId, syncpointAction.id, value);
             })
 
             MAXWELL3D_CASE(clearBuffers, {
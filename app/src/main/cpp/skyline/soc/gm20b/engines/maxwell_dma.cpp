@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/trace.h>
+#include <gpu/texture/block_linear.h>
+#include <soc.h>
+#include "maxwell_dma.h"
+
+namespace skyline::soc::gm20b::engine {
+    MaxwellDma::MaxwellDma(const DeviceState &state, ChannelContext &channelCtx) : Engine(state), channelCtx(channelCtx) {}
+
+    void MaxwellDma::CallMethod(u32 method, u32 argument, bool lastCall) {
+        Logger::Debug("Called method in Maxwell DMA: 0x{:X} args: 0x{:X}", method, argument);
+
+        if (method >= RegisterCount) [[unlikely]] {
+            Logger::Warn("Called method outside of Maxwell DMA register space: 0x{:X} args: 0x{:X}", method, argument);
+            return;
+        }
+
+        registers.raw[method] = argument;
+
+        #define MAXWELL_DMA_OFFSET(field) (sizeof(typeof(Registers::field)) - sizeof(typeof(*Registers::field))) / sizeof(u32)
+        if (method == MAXWELL_DMA_OFFSET(launchDma))
+            LaunchDma();
+        #undef MAXWELL_DMA_OFFSET
+    }
+
+    void MaxwellDma::LaunchDma() {
+        auto &launch{*registers.launchDma};
+        TRACE_EVENT("gpu", "MaxwellDma::LaunchDma", "lineLength", *registers.lineLengthIn, "lineCount", *registers.lineCount);
+
+        if (launch.dataTransferType != Registers::LaunchDma::DataTransferType::None) {
+            using MemoryLayout = Registers::LaunchDma::MemoryLayout;
+            bool srcPitch{launch.srcMemoryLayout == MemoryLayout::Pitch}, dstPitch{launch.dstMemoryLayout == MemoryLayout::Pitch};
+
+            if (launch.remapEnable) {
+                auto &remap{*registers.remap};
+                using Swizzle = Registers::RemapComponents::Swizzle;
+
+                // Only remapping a single 32-bit constant component is supported, this is how the DMA engine is used to clear buffers
+                if (dstPitch && remap.components.dstX == Swizzle::ConstA && remap.components.componentSizeMinusOne == 3 && remap.components.numDstComponentsMinusOne == 0)
+                    FillContiguous(registers.offsetOut->Pack(), remap.constA, *registers.lineLengthIn);
+                else
+                    Logger::Warn("Unimplemented DMA component remap: 0x{:X}", util::BitCast<u32>(remap.components));
+            } else if (srcPitch && dstPitch) {
+                CopyPitchToPitch();
+            } else if (!srcPitch && dstPitch) {
+                CopyBlockLinearToPitch();
+            } else if (srcPitch && !dstPitch) {
+                CopyPitchToBlockLinear();
+            } else {
+                Logger::Warn("Unimplemented block-linear to block-linear DMA copy");
+            }
+        }
+
+        ReleaseSemaphore();
+    }
+
+    void MaxwellDma::CopyContiguous(u64 source, u64 destination, size_t size) {
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        u8 *sourcePointer{gmmu.TranslateContiguous(source, size)};
+        u8 *destinationPointer{gmmu.TranslateContiguous(destination, size)};
+
+        if (sourcePointer && destinationPointer) {
+            // The source and destination may overlap as guests use the DMA engine to shift data within a buffer
+            std::memmove(destinationPointer, sourcePointer, size);
+        } else if (sourcePointer) {
+            gmmu.Write(destination, sourcePointer, size);
+        } else if (destinationPointer) {
+            gmmu.Read(destinationPointer, source, size);
+        } else {
+            sourceStaging.resize(size);
+            gmmu.Read(sourceStaging.data(), source, size);
+            gmmu.Write(destination, sourceStaging.data(), size);
+        }
+    }
+
+    void MaxwellDma::FillContiguous(u64 destination, u32 value, size_t count) {
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        size_t size{count * sizeof(u32)};
+        u8 *destinationPointer{gmmu.TranslateContiguous(destination, size)};
+        bool stagedDestination{!destinationPointer};
+        if (stagedDestination) {
+            destinationStaging.resize(size);
+            destinationPointer = destinationStaging.data();
+        }
+
+        std::fill_n(reinterpret_cast<u32 *>(destinationPointer), count, value);
+
+        if (stagedDestination)
+            gmmu.Write(destination, destinationPointer, size);
+    }
+
+    void MaxwellDma::CopyPitchToPitch() {
+        u64 source{registers.offsetIn->Pack()}, destination{registers.offsetOut->Pack()};
+        u32 lineLength{*registers.lineLengthIn};
+
+        if (!registers.launchDma->multiLineEnable) {
+            CopyContiguous(source, destination, lineLength);
+            return;
+        }
+
+        u32 lineCount{*registers.lineCount}, pitchIn{*registers.pitchIn}, pitchOut{*registers.pitchOut};
+        if (lineCount == 0 || lineLength == 0)
+            return;
+
+        // Lines which are packed together in both the source and destination can be copied in a single contiguous copy
+        if (pitchIn == lineLength && pitchOut == lineLength) {
+            CopyContiguous(source, destination, static_cast<size_t>(lineLength) * lineCount);
+            return;
+        }
+
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        size_t sourceSize{static_cast<size_t>(pitchIn) * (lineCount - 1) + lineLength};
+        size_t destinationSize{static_cast<size_t>(pitchOut) * (lineCount - 1) + lineLength};
+        u8 *sourcePointer{gmmu.TranslateContiguous(source, sourceSize)};
+        u8 *destinationPointer{gmmu.TranslateContiguous(destination, destinationSize)};
+
+        if (sourcePointer && destinationPointer) {
+            for (u32 line{}; line < lineCount; line++)
+                std::memmove(destinationPointer + static_cast<size_t>(line) * pitchOut, sourcePointer + static_cast<size_t>(line) * pitchIn, lineLength);
+        } else {
+            sourceStaging.resize(lineLength);
+            for (u32 line{}; line < lineCount; line++) {
+                gmmu.Read(sourceStaging.data(), source + static_cast<u64>(line) * pitchIn, lineLength);
+                gmmu.Write(destination + static_cast<u64>(line) * pitchOut, sourceStaging.data(), lineLength);
+            }
+        }
+    }
+
+    /**
+     * @return The block-linear layout of the supplied DMA surface
+     */
+    static gpu::BlockLinearLayout GetSurfaceLayout(const MaxwellDma::Registers::Surface &surface) {
+        if (surface.blockSize.width != 0)
+            Logger::Warn("Unsupported DMA surface block width: {}", 1U << surface.blockSize.width);
+
+        return gpu::BlockLinearLayout{
+            .widthBytes = surface.width,
+            .height = surface.height,
+            .depth = std::max(surface.depth, 1U),
+            .blockHeight = 1U << surface.blockSize.height,
+            .blockDepth = 1U << surface.blockSize.depth,
+        };
+    }
+
+    /**
+     * @return If the copy region and layer are within the bounds of the block-linear surface, a warning is logged if they aren't
+     */
+    static bool IsRegionInSurface(const MaxwellDma::Registers::Surface &surface, const gpu::BlockLinearLayout &layout, u32 lineLength, u32 lineCount) {
+        if (surface.origin.x + lineLength > util::AlignUp(layout.widthBytes, gpu::BlockLinearLayout::GobWidth) || surface.origin.y + lineCount > util::AlignUp(layout.height, gpu::BlockLinearLayout::GobHeight * layout.blockHeight)) {
+            Logger::Warn("DMA copy region ({}, {}) + ({}, {}) exceeds block-linear surface: {}x{}", surface.origin.x, surface.origin.y, lineLength, lineCount, layout.widthBytes, layout.height);
+            return false;
+        }
+
+        if (surface.layer >= layout.depth) {
+            Logger::Warn("DMA copy layer {} exceeds block-linear surface depth: {}", surface.layer, layout.depth);
+            return false;
+        }
+
+        return true;
+    }
+
+    void MaxwellDma::CopyBlockLinearToPitch() {
+        auto &surface{*registers.srcSurface};
+        auto layout{GetSurfaceLayout(surface)};
+        u64 source{registers.offsetIn->Pack()}, destination{registers.offsetOut->Pack()};
+        u32 lineLength{*registers.lineLengthIn}, lineCount{registers.launchDma->multiLineEnable ? *registers.lineCount : 1}, pitchOut{*registers.pitchOut};
+        if (lineCount == 0 || lineLength == 0 || !IsRegionInSurface(surface, layout, lineLength, lineCount))
+            return;
+
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        u8 *sourcePointer{gmmu.TranslateContiguous(source, layout.GetSize())};
+        u8 *destinationPointer{gmmu.TranslateContiguous(destination, static_cast<size_t>(pitchOut) * (lineCount - 1) + lineLength)};
+        if (sourcePointer && destinationPointer) {
+            gpu::CopyBlockLinearRegion<true>(layout, sourcePointer, surface.origin.x, surface.origin.y, surface.layer, destinationPointer, pitchOut, lineLength, lineCount);
+            return;
+        }
+
+        // Either side isn't contiguous in host memory, only the bytes of the copy region are accessed through the GMMU so unmapped parts of the surface or padding between lines are never touched
+        destinationStaging.resize(lineLength);
+        for (u32 line{}; line < lineCount; line++) {
+            u64 destinationLine{destination + static_cast<u64>(line) * pitchOut};
+            u8 *lineData{destinationPointer ? destinationPointer + static_cast<size_t>(line) * pitchOut : destinationStaging.data()};
+
+            if (sourcePointer)
+                gpu::CopyBlockLinearRegion<true>(layout, sourcePointer, surface.origin.x, surface.origin.y + line, surface.layer, lineData, lineLength, lineLength, 1);
+            else
+                gpu::ForEachBlockLinearSpan(layout, surface.origin.x, surface.origin.y + line, surface.layer, lineLength, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                    gmmu.Read(lineData + lineOffset, source + surfaceOffset, size);
+                });
+
+            if (!destinationPointer)
+                gmmu.Write(destinationLine, lineData, lineLength);
+        }
+    }
+
+    void MaxwellDma::CopyPitchToBlockLinear() {
+        auto &surface{*registers.dstSurface};
+        auto layout{GetSurfaceLayout(surface)};
+        u64 source{registers.offsetIn->Pack()}, destination{registers.offsetOut->Pack()};
+        u32 lineLength{*registers.lineLengthIn}, lineCount{registers.launchDma->multiLineEnable ? *registers.lineCount : 1}, pitchIn{*registers.pitchIn};
+        if (lineCount == 0 || lineLength == 0 || !IsRegionInSurface(surface, layout, lineLength, lineCount))
+            return;
+
+        auto &gmmu{channelCtx.asCtx->gmmu};
+        u8 *sourcePointer{gmmu.TranslateContiguous(source, static_cast<size_t>(pitchIn) * (lineCount - 1) + lineLength)};
+        u8 *destinationPointer{gmmu.TranslateContiguous(destination, layout.GetSize())};
+        if (sourcePointer && destinationPointer) {
+            gpu::CopyBlockLinearRegion<false>(layout, destinationPointer, surface.origin.x, surface.origin.y, surface.layer, sourcePointer, pitchIn, lineLength, lineCount);
+            return;
+        }
+
+        // Either side isn't contiguous in host memory, only the bytes of the copy region are accessed through the GMMU so the rest of the surface is never read back or overwritten
+        sourceStaging.resize(lineLength);
+        for (u32 line{}; line < lineCount; line++) {
+            u8 *lineData;
+            if (sourcePointer) {
+                lineData = sourcePointer + static_cast<size_t>(line) * pitchIn;
+            } else {
+                lineData = sourceStaging.data();
+                gmmu.Read(lineData, source + static_cast<u64>(line) * pitchIn, lineLength);
+            }
+
+            if (destinationPointer)
+                gpu::CopyBlockLinearRegion<false>(layout, destinationPointer, surface.origin.x, surface.origin.y + line, surface.layer, lineData, lineLength, lineLength, 1);
+            else
+                gpu::ForEachBlockLinearSpan(layout, surface.origin.x, surface.origin.y + line, surface.layer, lineLength, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                    gmmu.Write(destination + surfaceOffset, lineData + lineOffset, size);
+                });
+        }
+    }
+
+    void MaxwellDma::ReleaseSemaphore() {
+        auto &semaphore{*registers.semaphore};
+        switch (registers.launchDma->semaphoreType) {
+            case Registers::LaunchDma::SemaphoreType::None:
+                break;
+
+            case Registers::LaunchDma::SemaphoreType::ReleaseOneWord:
+                channelCtx.asCtx->gmmu.Write<u32>(semaphore.address.Pack(), semaphore.payload);
+                break;
+
+            case Registers::LaunchDma::SemaphoreType::ReleaseFourWord: {
+                struct FourWordResult {
+                    u32 payload;
+                    u32 _pad_;
+                    u64 timestamp;
+                };
+
+                // Convert the current nanosecond time to GPU ticks
+                constexpr i64 NsToTickNumerator{384};
+                constexpr i64 NsToTickDenominator{625};
+
+                i64 nsTime{util::GetTimeNs()};
+                i64 timestamp{(nsTime / NsToTickDenominator) * NsToTickNumerator + ((nsTime % NsToTickDenominator) * NsToTickNumerator) / NsToTickDenominator};
+
+                channelCtx.asCtx->gmmu.Write<FourWordResult>(semaphore.address.Pack(), FourWordResult{semaphore.payload, 0, static_cast<u64>(timestamp)});
+                break;
+            }
+
+            default:
+                Logger::Warn("Unknown DMA semaphore type: {}", static_cast<u32>(registers.launchDma->semaphoreType));
+                break;
+        }
+    }
+}
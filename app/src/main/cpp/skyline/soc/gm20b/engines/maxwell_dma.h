@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include "engine.h"
+
+namespace skyline::soc::gm20b {
+    struct ChannelContext;
+}
+
+namespace skyline::soc::gm20b::engine {
+    /**
+     * @brief The Maxwell DMA engine handles copying memory between pitch-linear and block-linear layouts in the GPU address space
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/master/classes/dma-copy/clb0b5.h
+     */
+    class MaxwellDma : public Engine {
+      private:
+        ChannelContext &channelCtx;
+        std::vector<u8> sourceStaging; //!< A buffer for source data which isn't contiguous in host memory
+        std::vector<u8> destinationStaging; //!< A buffer for destination data which isn't contiguous in host memory
+
+        /**
+         * @brief Executes the DMA described by the current register state
+         */
+        void LaunchDma();
+
+        /**
+         * @brief Copies a contiguous range of memory, this avoids any per-line address translation
+         */
+        void CopyContiguous(u64 source, u64 destination, size_t size);
+
+        /**
+         * @brief Fills a contiguous range of memory with a repeated 32-bit value, this is used for clears through the component remapper
+         */
+        void FillContiguous(u64 destination, u32 value, size_t count);
+
+        void CopyPitchToPitch();
+
+        void CopyBlockLinearToPitch();
+
+        void CopyPitchToBlockLinear();
+
+        void ReleaseSemaphore();
+
+      public:
+        static constexpr u32 RegisterCount{0x1D6}; //!< The number of Maxwell DMA registers
+
+        #pragma pack(push, 1)
+        union Registers {
+            std::array<u32, RegisterCount> raw;
+
+            template<size_t Offset, typename Type>
+            using Register = util::OffsetMember<Offset, Type, u32>;
+
+            struct Address {
+                u32 high;
+                u32 low;
+
+                u64 Pack() {
+                    return (static_cast<u64>(high) << 32) | low;
+                }
+            };
+            static_assert(sizeof(Address) == sizeof(u64));
+
+            struct Semaphore {
+                Address address; // 0x90
+                u32 payload; // 0x92
+            };
+            Register<0x90, Semaphore> semaphore;
+
+            struct LaunchDma {
+                enum class DataTransferType : u32 {
+                    None = 0,
+                    Pipelined = 1,
+                    NonPipelined = 2,
+                };
+
+                enum class SemaphoreType : u32 {
+                    None = 0,
+                    ReleaseOneWord = 1,
+                    ReleaseFourWord = 2,
+                };
+
+                enum class MemoryLayout : u32 {
+                    BlockLinear = 0,
+                    Pitch = 1,
+                };
+
+                DataTransferType dataTransferType : 2;
+                bool flushEnable : 1;
+                SemaphoreType semaphoreType : 2;
+                u32 interruptType : 2;
+                MemoryLayout srcMemoryLayout : 1;
+                MemoryLayout dstMemoryLayout : 1;
+                bool multiLineEnable : 1;
+                bool remapEnable : 1;
+                bool forceRmwDisable : 1;
+                u32 srcType : 1;
+                u32 dstType : 1;
+                u32 semaphoreReduction : 4;
+                bool semaphoreReductionSign : 1;
+                bool reductionEnable : 1;
+                bool bypassL2 : 1;
+                u32 _pad_ : 11;
+            };
+            static_assert(sizeof(LaunchDma) == sizeof(u32));
+            Register<0xC0, LaunchDma> launchDma;
+
+            Register<0x100, Address> offsetIn;
+            Register<0x102, Address> offsetOut;
+            Register<0x104, u32> pitchIn;
+            Register<0x105, u32> pitchOut;
+            Register<0x106, u32> lineLengthIn;
+            Register<0x107, u32> lineCount;
+
+            struct RemapComponents {
+                enum class Swizzle : u8 {
+                    SrcX = 0,
+                    SrcY = 1,
+                    SrcZ = 2,
+                    SrcW = 3,
+                    ConstA = 4,
+                    ConstB = 5,
+                    NoWrite = 6,
+                };
+
+                Swizzle dstX : 3;
+                u8 _pad0_ : 1;
+                Swizzle dstY : 3;
+                u8 _pad1_ : 1;
+                Swizzle dstZ : 3;
+                u8 _pad2_ : 1;
+                Swizzle dstW : 3;
+                u8 _pad3_ : 1;
+                u8 componentSizeMinusOne : 2;
+                u8 _pad4_ : 2;
+                u8 numSrcComponentsMinusOne : 2;
+                u8 _pad5_ : 2;
+                u8 numDstComponentsMinusOne : 2;
+                u8 _pad6_ : 6;
+            };
+            static_assert(sizeof(RemapComponents) == sizeof(u32));
+
+            struct Remap {
+                u32 constA; // 0x1C0
+                u32 constB; // 0x1C1
+                RemapComponents components; // 0x1C2
+            };
+            Register<0x1C0, Remap> remap;
+
+            struct Surface {
+                struct {
+                    u8 width : 4; //!< Log2 of the width of a block in GOBs, this must be 0
+                    u8 height : 4; //!< Log2 of the height of a block in GOBs
+                    u8 depth : 4; //!< Log2 of the depth of a block in GOBs
+                    u8 gobHeight : 4; //!< The height of a GOB in lines, this must be 2 (8 lines) on the Tegra X1
+                    u16 _pad_;
+                } blockSize;
+                u32 width;
+                u32 height;
+                u32 depth;
+                u32 layer;
+                struct {
+                    u16 x; //!< The X offset of the region in bytes
+                    u16 y;
+                } origin;
+            };
+            static_assert(sizeof(Surface) == (0x6 * sizeof(u32)));
+
+            Register<0x1C3, Surface> dstSurface;
+            Register<0x1CA, Surface> srcSurface;
+        };
+        static_assert(sizeof(Registers) == (RegisterCount * sizeof(u32)));
+        #pragma pack(pop)
+
+        Registers registers{};
+
+        MaxwellDma(const DeviceState &state, ChannelContext &channelCtx);
+
+        void CallMethod(u32 method, u32 argument, bool lastCall);
+    };
+}
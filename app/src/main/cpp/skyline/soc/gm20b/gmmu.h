@@ -17,5 +17,6 @@ namespace skyline::soc::gm20b {
 
     struct AddressSpaceContext {
         GMMU gmmu;
+        u32 captureId{}; //!< The ID of the address space in the pushbuffer capture, this is only valid when capturing
     };
 }
@@ -7,6 +7,7 @@
 #include <soc.h>
 #include <os.h>
 #include "engines/maxwell_3d.h"
+#include "engines/fermi_2d.h"
 
 namespace skyline::soc::gm20b {
     /**
@@ -89,7 +90,7 @@ namespace skyline::soc::gm20b {
                     channelCtx.keplerMemory.CallMethod(method, argument, lastCall);
                     break;
                 case TwoDSubChannel:
-                    channelCtx.fermi2D.CallMethod(method, argument, lastCall);
+                    channelCtx.fermi2D->CallMethod(method, argument, lastCall);
                     break;
                 case CopySubChannel:
                     channelCtx.maxwellDma.CallMethod(method, argument, lastCall);
@@ -101,7 +102,11 @@ namespace skyline::soc::gm20b {
     }
 
     void ChannelGpfifo::Process(GpEntry gpEntry) {
+        auto &capture{state.soc->pushBufferCapture};
         if (!gpEntry.size) {
+            if (capture) [[unlikely]]
+                capture->RecordGpEntry(channelCtx.captureId, gpEntry, {});
+
             // This is a GPFIFO control entry, all control entries have a zero length and contain no pushbuffers
             switch (gpEntry.opcode) {
                 case GpEntry::Opcode::Nop:
@@ -115,6 +120,9 @@ namespace skyline::soc::gm20b {
         pushBufferData.resize(gpEntry.size);
         channelCtx.asCtx->gmmu.Read<u32>(pushBufferData, gpEntry.Address());
 
+        if (capture) [[unlikely]]
+            capture->RecordGpEntry(channelCtx.captureId, gpEntry, pushBufferData);
+
         // There will be at least one entry here
         auto entry{pushBufferData.begin()};
 
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <unordered_set>
+#include "gpfifo.h"
+#include "pushbuffer_capture.h"
+
+namespace skyline::soc::gm20b {
+    PushBufferCapture::PushBufferCapture(const std::string &path) : file(path, std::ios::binary | std::ios::trunc) {
+        if (!file)
+            throw exception("Cannot open pushbuffer capture file: {}", path);
+
+        FileHeader header{};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        Logger::Info("Capturing GPU pushbuffers to {}", path);
+    }
+
+    PushBufferCapture::~PushBufferCapture() {
+        std::scoped_lock lock(mutex);
+        file.flush();
+    }
+
+    u32 PushBufferCapture::CreateAddressSpace() {
+        std::scoped_lock lock(mutex);
+        return nextId++;
+    }
+
+    u32 PushBufferCapture::CreateChannel(u32 addressSpace) {
+        std::scoped_lock lock(mutex);
+        u32 channel{nextId++};
+        WriteRecordLocked(RecordType::Channel, ChannelRecord{
+            .channel = channel,
+            .addressSpace = addressSpace,
+        });
+        return channel;
+    }
+
+    void PushBufferCapture::RecordGpEntry(u32 channel, GpEntry entry, span<const u32> pushBuffer) {
+        std::scoped_lock lock(mutex);
+        WriteRecordLocked(RecordType::GpEntry, GpEntryRecord{
+            .channel = channel,
+            .entry = util::BitCast<u64>(entry),
+        }, pushBuffer.cast<const u8>());
+    }
+
+    void PushBufferCapture::RecordMap(u32 addressSpace, u64 virtualAddress, u64 size, bool sparse) {
+        std::scoped_lock lock(mutex);
+        WriteRecordLocked(RecordType::Map, MapRecord{
+            .addressSpace = addressSpace,
+            .sparse = sparse,
+            .virtualAddress = virtualAddress,
+            .size = size,
+        });
+    }
+
+    void PushBufferCapture::RecordUnmap(u32 addressSpace, u64 virtualAddress, u64 size) {
+        std::scoped_lock lock(mutex);
+        WriteRecordLocked(RecordType::Unmap, UnmapRecord{
+            .addressSpace = addressSpace,
+            .virtualAddress = virtualAddress,
+            .size = size,
+        });
+    }
+
+    void PushBufferCapture::RecordSyncpointIncrement(u32 channel, u32 id, u32 value) {
+        std::scoped_lock lock(mutex);
+        WriteRecordLocked(RecordType::SyncpointIncrement, SyncpointIncrementRecord{
+            .channel = channel,
+            .id = id,
+            .value = value,
+        });
+    }
+
+    PushBufferCaptureReader::PushBufferCaptureReader(const std::string &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw exception("Cannot open pushbuffer capture file: {}", path);
+
+        auto remaining{static_cast<u64>(file.tellg())};
+        file.seekg(0);
+
+        auto read{[&](void *output, u64 size) {
+            if (size > remaining)
+                throw exception("Pushbuffer capture is truncated: 0x{:X} bytes are required but only 0x{:X} are left", size, remaining);
+            file.read(reinterpret_cast<char *>(output), static_cast<std::streamsize>(size));
+            if (!file)
+                throw exception("Cannot read pushbuffer capture file: {}", path);
+            remaining -= size;
+        }};
+
+        PushBufferCapture::FileHeader header;
+        read(&header, sizeof(header));
+        if (header.magic != PushBufferCapture::Magic)
+            throw exception("Invalid pushbuffer capture magic: 0x{:08X}", header.magic);
+        if (header.version != PushBufferCapture::Version)
+            throw exception("Unsupported pushbuffer capture version: {}", header.version);
+
+        std::unordered_set<u32> channels; //!< The IDs of all channels which have been created so far
+        auto checkChannel{[&](u32 channel) {
+            if (!channels.contains(channel))
+                throw exception("Pushbuffer capture record #{} references channel {} prior to its creation", records.size(), channel);
+        }};
+
+        while (remaining) {
+            PushBufferCapture::RecordHeader recordHeader;
+            read(&recordHeader, sizeof(recordHeader));
+            if (recordHeader.size > remaining)
+                throw exception("Pushbuffer capture record #{} is truncated: 0x{:X} bytes are required but only 0x{:X} are left", records.size(), recordHeader.size, remaining);
+
+            auto readPayload{[&]<typename Payload>(Payload &payload) {
+                if (recordHeader.type != PushBufferCapture::RecordType::GpEntry && recordHeader.size != sizeof(Payload))
+                    throw exception("Pushbuffer capture record #{} of type {} has an invalid size: 0x{:X}", records.size(), static_cast<u32>(recordHeader.type), recordHeader.size);
+                read(&payload, sizeof(Payload));
+            }};
+
+            switch (recordHeader.type) {
+                case PushBufferCapture::RecordType::Channel: {
+                    PushBufferCapture::ChannelRecord record;
+                    readPayload(record);
+                    if (!channels.insert(record.channel).second)
+                        throw exception("Pushbuffer capture record #{} creates channel {} a second time", records.size(), record.channel);
+                    records.emplace_back(record);
+                    break;
+                }
+
+                case PushBufferCapture::RecordType::GpEntry: {
+                    if (recordHeader.size < sizeof(PushBufferCapture::GpEntryRecord) || (recordHeader.size - sizeof(PushBufferCapture::GpEntryRecord)) % sizeof(u32))
+                        throw exception("Pushbuffer capture record #{} has an invalid GpEntry size: 0x{:X}", records.size(), recordHeader.size);
+
+                    GpEntryData data;
+                    readPayload(data.record);
+                    checkChannel(data.record.channel);
+
+                    // Control entries don't reference a pushbuffer, all other entries must contain exactly the words they reference
+                    data.pushBuffer.resize((recordHeader.size - sizeof(PushBufferCapture::GpEntryRecord)) / sizeof(u32));
+                    auto entry{util::BitCast<GpEntry>(data.record.entry)};
+                    if (data.pushBuffer.size() != entry.size)
+                        throw exception("Pushbuffer capture record #{} has {} pushbuffer words for a GpEntry of {} words", records.size(), data.pushBuffer.size(), static_cast<u32>(entry.size));
+                    read(data.pushBuffer.data(), data.pushBuffer.size() * sizeof(u32));
+
+                    records.emplace_back(std::move(data));
+                    break;
+                }
+
+                case PushBufferCapture::RecordType::Map: {
+                    PushBufferCapture::MapRecord record;
+                    readPayload(record);
+                    records.emplace_back(record);
+                    break;
+                }
+
+                case PushBufferCapture::RecordType::Unmap: {
+                    PushBufferCapture::UnmapRecord record;
+                    readPayload(record);
+                    records.emplace_back(record);
+                    break;
+                }
+
+                case PushBufferCapture::RecordType::SyncpointIncrement: {
+                    PushBufferCapture::SyncpointIncrementRecord record;
+                    readPayload(record);
+                    checkChannel(record.channel);
+                    records.emplace_back(record);
+                    break;
+                }
+
+                default:
+                    throw exception("Pushbuffer capture record #{} has an unknown type: {}", records.size(), static_cast<u32>(recordHeader.type));
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <fstream>
+#include <variant>
+#include <common.h>
+
+namespace skyline::soc::gm20b {
+    struct GpEntry;
+
+    /**
+     * @brief Records the front-end workload of all GPU channels to a file so that it can be replayed offline without the guest
+     * @note The file is a FileHeader followed by a flat stream of records, each record is a RecordHeader followed by `RecordHeader::size` bytes of payload
+     * @note Channels and address spaces are identified by IDs which are assigned in increasing order on their creation and never reused, every channel is described by a ChannelRecord prior to any of its other records
+     */
+    class PushBufferCapture {
+      public:
+        static constexpr u32 Magic{util::MakeMagic<u32>("SKPB")};
+        static constexpr u32 Version{1};
+
+        #pragma pack(push, 1)
+        struct FileHeader {
+            u32 magic{Magic};
+            u32 version{Version};
+        };
+
+        enum class RecordType : u32 {
+            Channel = 0, //!< ChannelRecord
+            GpEntry = 1, //!< GpEntryRecord followed by the words of the pushbuffer it references
+            Map = 2, //!< MapRecord
+            Unmap = 3, //!< UnmapRecord
+            SyncpointIncrement = 4, //!< SyncpointIncrementRecord
+        };
+
+        struct RecordHeader {
+            RecordType type;
+            u32 size; //!< The size of the payload in bytes
+        };
+
+        struct ChannelRecord {
+            u32 channel;
+            u32 addressSpace; //!< The address space the channel is bound to
+        };
+
+        struct GpEntryRecord {
+            u32 channel;
+            u32 _pad_;
+            u64 entry; //!< The raw GpEntry as it was submitted by the guest
+        };
+
+        struct MapRecord {
+            u32 addressSpace;
+            u32 sparse; //!< If the mapping is a sparse placeholder without any backing
+            u64 virtualAddress;
+            u64 size;
+        };
+
+        struct UnmapRecord {
+            u32 addressSpace;
+            u32 _pad_;
+            u64 virtualAddress;
+            u64 size;
+        };
+
+        struct SyncpointIncrementRecord {
+            u32 channel;
+            u32 id;
+            u32 value; //!< The value of the syncpoint after the increment
+        };
+        #pragma pack(pop)
+
+      private:
+        std::mutex mutex; //!< Synchronizes writes to the file as every channel is recorded from its own thread
+        std::ofstream file;
+        u32 nextId{}; //!< The ID assigned to the next channel or address space
+
+        template<typename Payload>
+        void WriteRecordLocked(RecordType type, const Payload &payload, span<const u8> extra = {}) {
+            RecordHeader header{type, static_cast<u32>(sizeof(Payload) + extra.size())};
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(&payload), sizeof(Payload));
+            if (!extra.empty())
+                file.write(reinterpret_cast<const char *>(extra.data()), static_cast<std::streamsize>(extra.size()));
+        }
+
+      public:
+        /**
+         * @param path The path of the file to write the capture to, any existing file is overwritten
+         */
+        PushBufferCapture(const std::string &path);
+
+        ~PushBufferCapture();
+
+        /**
+         * @return A new ID for an address space which is being created
+         */
+        u32 CreateAddressSpace();
+
+        /**
+         * @brief Records the creation of a channel bound to the supplied address space
+         * @return A new ID for the channel
+         */
+        u32 CreateChannel(u32 addressSpace);
+
+        /**
+         * @brief Records a GpEntry and the contents of the pushbuffer it references, the contents are empty for control entries
+         */
+        void RecordGpEntry(u32 channel, GpEntry entry, span<const u32> pushBuffer);
+
+        void RecordMap(u32 addressSpace, u64 virtualAddress, u64 size, bool sparse);
+
+        void RecordUnmap(u32 addressSpace, u64 virtualAddress, u64 size);
+
+        /**
+         * @brief Records a syncpoint increment which was performed by a method in a channel's pushbuffer
+         */
+        void RecordSyncpointIncrement(u32 channel, u32 id, u32 value);
+    };
+
+    /**
+     * @brief Decodes a capture written by PushBufferCapture into its records, the structure of the capture is validated so that it can be replayed without any further checks
+     */
+    class PushBufferCaptureReader {
+      public:
+        struct GpEntryData {
+            PushBufferCapture::GpEntryRecord record;
+            std::vector<u32> pushBuffer; //!< The words of the pushbuffer referenced by the entry, this is empty for control entries
+        };
+
+        using Record = std::variant<PushBufferCapture::ChannelRecord, GpEntryData, PushBufferCapture::MapRecord, PushBufferCapture::UnmapRecord, PushBufferCapture::SyncpointIncrementRecord>;
+
+        std::vector<Record> records; //!< All records in the order they were captured in
+
+        PushBufferCaptureReader(const std::string &path);
+    };
+}
@@ -5,75 +5,119 @@
 #include "syncpoint.h"
 
 namespace skyline::soc::host1x {
-    Syncpoint::WaiterHandle Syncpoint::RegisterWaiter(u32 threshold, const std::function<void()> &callback) {
-        if (value.load(std::memory_order_acquire) >= threshold) {
+    Syncpoint::WaiterHandle Syncpoint::RegisterWaiter(u32 threshold, std::function<void()> callback) {
+        if (IsThresholdReached(Load(), threshold)) {
             // (Fast path) We don't need to wait on the mutex and can just get away with atomics
             callback();
             return {};
         }
 
-        std::scoped_lock lock(mutex);
-        if (value.load(std::memory_order_acquire) >= threshold) {
+        std::unique_lock lock(mutex);
+        u64 current{value.load(std::memory_order_acquire)};
+        u64 target{GetTarget(current, threshold)};
+        if (target <= current) {
+            lock.unlock();
             callback();
             return {};
         }
 
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        return waiters.emplace(it, threshold, callback);
+        WaiterKey key{target, nextWaiterId++};
+        waiters.emplace(key, std::move(callback));
+        return WaiterHandle{key};
     }
 
     void Syncpoint::DeregisterWaiter(WaiterHandle waiter) {
-        std::scoped_lock lock(mutex);
-        // We want to ensure the iterator still exists prior to erasing it
-        // Otherwise, if an invalid iterator was passed in then it could lead to UB
-        // It is important to avoid UB in that case since the deregister isn't called from a locked context
-        for (auto it{waiters.begin()}; it != waiters.end(); it++)
-            if (it == waiter)
-                waiters.erase(it);
+        if (!waiter)
+            return;
+
+        std::unique_lock lock(mutex);
+        if (waiters.erase(waiter.key))
+            return;
+
+        auto dispatched{dispatchedWaiters.find(waiter.key)};
+        if (dispatched == dispatchedWaiters.end())
+            return; // The callback has already returned
+
+        if (!dispatched->second.running) {
+            dispatchedWaiters.erase(dispatched); // The dispatching thread skips any waiter which was removed prior to running it
+            return;
+        }
+
+        // The callback is running, we wait for it to return unless this is the thread running it as that would never complete
+        if (dispatched->second.thread == std::this_thread::get_id())
+            return;
+
+        dispatchCondition.wait(lock, [&] { return !dispatchedWaiters.contains(waiter.key); });
     }
 
     u32 Syncpoint::Increment() {
         auto readValue{value.fetch_add(1, std::memory_order_acq_rel) + 1}; // We don't want to constantly do redundant atomic loads
 
-        std::scoped_lock lock(mutex);
-        bool signalCondition{};
-        auto it{waiters.begin()};
-        while (it != waiters.end() && readValue >= it->threshold) {
-            auto &waiter{*it};
-            if (waiter.callback)
-                waiter.callback();
-            else
-                signalCondition = true;
-            it++;
+        boost::container::small_vector<std::pair<WaiterKey, std::function<void()>>, 8> callbacks;
+        {
+            std::scoped_lock lock(mutex);
+            bool signalCondition{};
+            auto it{waiters.begin()};
+            for (; it != waiters.end() && it->first.first <= readValue; it++) {
+                if (it->second) {
+                    // Dequeued waiters are tracked until their callback returns so that a deregistration can cancel them or wait on them
+                    dispatchedWaiters.emplace(it->first, DispatchedWaiter{std::this_thread::get_id(), false});
+                    callbacks.emplace_back(it->first, std::move(it->second));
+                } else {
+                    signalCondition = true;
+                }
+            }
+
+            waiters.erase(waiters.begin(), it);
+
+            if (signalCondition)
+                incrementCondition.notify_all();
         }
 
-        waiters.erase(waiters.begin(), it);
+        // Callbacks are run without holding any lock so they cannot stall the registration of other waiters or concurrent increments, and can reenter the syncpoint
+        for (auto &[key, callback] : callbacks) {
+            {
+                std::scoped_lock lock(mutex);
+                auto dispatched{dispatchedWaiters.find(key)};
+                if (dispatched == dispatchedWaiters.end())
+                    continue; // The waiter was deregistered prior to its callback being run
+                dispatched->second.running = true;
+            }
 
-        if (signalCondition)
-            incrementCondition.notify_all();
+            callback();
 
-        return readValue;
+            {
+                std::scoped_lock lock(mutex);
+                dispatchedWaiters.erase(key);
+            }
+            dispatchCondition.notify_all();
+        }
+
+        return static_cast<u32>(readValue);
     }
 
     bool Syncpoint::Wait(u32 threshold, std::chrono::steady_clock::duration timeout) {
-        if (value.load(std::memory_order_acquire) >= threshold)
+        if (IsThresholdReached(Load(), threshold))
             // (Fast Path) We don't need to wait on the mutex and can just get away with atomics
-            return {};
+            return true;
 
         std::unique_lock lock(mutex);
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        waiters.emplace(it, threshold, nullptr);
+        u64 target{GetTarget(value.load(std::memory_order_acquire), threshold)};
+        auto isReached{[&] { return value.load(std::memory_order_relaxed) >= target; }};
+        if (isReached())
+            return true;
+
+        WaiterKey key{target, nextWaiterId++};
+        waiters.emplace(key, nullptr);
 
         if (timeout == std::chrono::steady_clock::duration::max()) {
-            incrementCondition.wait(lock, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
+            incrementCondition.wait(lock, isReached);
             return true;
         } else {
-            return incrementCondition.wait_for(lock, timeout, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
+            bool reached{incrementCondition.wait_for(lock, timeout, isReached)};
+            if (!reached)
+                waiters.erase(key);
+            return reached;
         }
     }
 }
-
@@ -11,41 +11,89 @@ namespace skyline::soc::host1x {
 
     /**
      * @brief The Syncpoint class represents a single syncpoint in the GPU which is used for GPU -> CPU synchronisation
+     * @note Thresholds are compared relative to the current value of the syncpoint, this keeps comparisons correct when the 32-bit counter wraps around
      */
     class Syncpoint {
       private:
-        std::atomic<u32> value{}; //!< An atomically-incrementing counter at the core of a syncpoint
+        std::atomic<u64> value{}; //!< An atomically-incrementing counter at the core of a syncpoint, it's extended to 64-bits internally so waiters can be ordered across a wraparound of the guest-visible 32-bit value
 
-        std::mutex mutex; //!< Synchronizes insertions and deletions of waiters alongside locking the increment condition
+        std::mutex mutex; //!< Synchronizes insertions and deletions of waiters and dispatches alongside locking the increment condition
         std::condition_variable incrementCondition; //!< Signalled on thresholds for waiters which are tied to Wait(...)
+        std::condition_variable dispatchCondition; //!< Signalled whenever the callback of a dispatched waiter has returned
+        u64 nextWaiterId{1}; //!< The ID assigned to the next waiter, an ID of 0 is reserved for invalid handles
 
-        struct Waiter {
-            u32 threshold; //!< The syncpoint value to wait on to be reached
-            std::function<void()> callback; //!< The callback to do after the wait has ended, refers to cvar signal when nullptr
+        /**
+         * @brief The key of a waiter, this orders waiters by their 64-bit target value with the ID disambiguating waiters on the same target
+         */
+        using WaiterKey = std::pair<u64, u64>;
+
+        std::map<WaiterKey, std::function<void()>> waiters; //!< All waiters sorted in ascending order by target, a null callback refers to a cvar signal
 
-            Waiter(u32 threshold, std::function<void()> callback) : threshold(threshold), callback(std::move(callback)) {}
+        /**
+         * @brief A waiter which has been dequeued by an increment and whose callback is pending or running on the dispatching thread
+         */
+        struct DispatchedWaiter {
+            std::thread::id thread; //!< The thread running the increment which dequeued the waiter
+            bool running; //!< If the callback has started running, a waiter that isn't running yet can still be cancelled
         };
-        std::list<Waiter> waiters; //!< A linked list of all waiters, it's sorted in ascending order by threshold
+
+        std::map<WaiterKey, DispatchedWaiter> dispatchedWaiters; //!< Waiters that have been dequeued by any concurrent increment but whose callbacks haven't returned yet
+
+        /**
+         * @return The 64-bit value at which the supplied threshold will be reached, this is equal to or below the current value if it has already been reached
+         */
+        static constexpr u64 GetTarget(u64 current, u32 threshold) {
+            return current + static_cast<u64>(static_cast<i64>(static_cast<i32>(threshold - static_cast<u32>(current))));
+        }
 
       public:
+        /**
+         * @return If the supplied syncpoint value has reached the threshold, this accounts for the value wrapping around
+         * @note Thresholds more than 2^31 increments ahead of the value are treated as having been reached
+         */
+        static constexpr bool IsThresholdReached(u32 value, u32 threshold) {
+            return static_cast<i32>(value - threshold) >= 0;
+        }
+
         /**
          * @return The value of the syncpoint, retrieved in an atomically safe manner
          */
-        constexpr u32 Load() {
-            return value.load(std::memory_order_acquire);
+        u32 Load() {
+            return static_cast<u32>(value.load(std::memory_order_acquire));
         }
 
-        using WaiterHandle = decltype(waiters)::iterator; //!< Aliasing an iterator to a Waiter as an opaque handle
+        /**
+         * @brief An opaque handle to a registered waiter, it evaluates to false if it doesn't refer to a waiter
+         */
+        class WaiterHandle {
+          private:
+            WaiterKey key{};
+
+            friend Syncpoint;
+
+            constexpr WaiterHandle(WaiterKey key) : key(key) {}
+
+          public:
+            constexpr WaiterHandle() = default;
+
+            constexpr explicit operator bool() const {
+                return key.second != 0;
+            }
+        };
 
         /**
          * @brief Registers a new waiter with a callback that will be called when the syncpoint reaches the target threshold
          * @note The callback will be called immediately if the syncpoint has already reached the given threshold
+         * @note The callback is called without any locks of the syncpoint held, it may register or deregister any waiters (including itself) and increment the syncpoint
          * @return A handle that can be used to deregister the waiter, its boolean operator will evaluate to false if the threshold has already been reached
          */
-        WaiterHandle RegisterWaiter(u32 threshold, const std::function<void()> &callback);
+        WaiterHandle RegisterWaiter(u32 threshold, std::function<void()> callback);
 
         /**
-         * @note If the supplied handle is invalid then the function will do nothing
+         * @note If the supplied handle is invalid or the waiter has already been signalled then the function will do nothing
+         * @note If the waiter has been dequeued by an increment but its callback hasn't started running yet, it's cancelled and won't be run
+         * @note If the callback of the waiter is concurrently being run on another thread, this will block until it has returned
+         * @note If this is called from a callback on the thread that is running the waiter's callback (such as a callback deregistering itself), this returns immediately as waiting would deadlock
          */
         void DeregisterWaiter(WaiterHandle waiter);
 
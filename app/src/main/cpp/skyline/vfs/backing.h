@@ -22,6 +22,10 @@ namespace skyline::vfs {
             throw exception("This backing does not support being resized");
         }
 
+        virtual span<const u8> GetViewImpl(size_t offset, size_t pSize) {
+            return {};
+        }
+
       public:
         union Mode {
             struct {
@@ -100,6 +104,23 @@ namespace skyline::vfs {
             return object;
         }
 
+        /**
+         * @brief Retrieves a view directly into the contents of the backing without copying them
+         * @param offset The offset to start the view at
+         * @param pSize The size of the view
+         * @return A span over the requested region or an empty span if the backing doesn't support direct access, callers must fall back to Read in that case
+         * @note The view is only valid for the lifetime of the backing and reflects writes done through the backing, it must never be written to
+         */
+        span<const u8> GetView(size_t offset, size_t pSize) {
+            if (!mode.read)
+                throw exception("Attempting to view a backing that is not readable");
+
+            if (offset > size || (size - offset) < pSize)
+                throw exception("Trying to view past the end of a backing: 0x{:X}/0x{:X} (Offset: 0x{:X})", pSize, size, offset);
+
+            return GetViewImpl(offset, pSize);
+        }
+
         /**
          * @brief Writes from a buffer to a particular offset in the backing
          * @param input The data to write to the backing
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "cached_backing.h"
+
+namespace skyline::vfs {
+    BlockCache::~BlockCache() {
+        {
+            std::scoped_lock lock(readAheadMutex);
+            readAheadExit = true;
+        }
+        readAheadCondition.notify_all();
+
+        if (readAheadThread.joinable())
+            readAheadThread.join();
+    }
+
+    BlockCache &BlockCache::Get() {
+        static BlockCache cache;
+        return cache;
+    }
+
+    void BlockCache::TrimLocked(Shard &shard) {
+        size_t shardCapacity{GetCapacity() / ShardCount};
+        while (shard.size > shardCapacity && !shard.lru.empty()) {
+            auto &last{shard.lru.back()};
+            shard.size -= last.data.size();
+            shard.blocks.erase(BlockKey{last.owner, last.index});
+            shard.lru.pop_back();
+        }
+    }
+
+    void BlockCache::SetCapacity(size_t pCapacity) {
+        capacity.store(pCapacity, std::memory_order_relaxed);
+        for (auto &shard : shards) {
+            std::scoped_lock lock(shard.mutex);
+            TrimLocked(shard);
+        }
+    }
+
+    bool BlockCache::Lookup(const CachedBacking *owner, size_t index, span<u8> output, size_t blockOffset) {
+        BlockKey key{owner, index};
+        auto &shard{GetShard(key)};
+        std::scoped_lock lock(shard.mutex);
+
+        auto it{shard.blocks.find(key)};
+        if (it == shard.blocks.end())
+            return false;
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        std::memcpy(output.data(), it->second->data.data() + blockOffset, output.size());
+        return true;
+    }
+
+    void BlockCache::Insert(const CachedBacking *owner, size_t index, span<u8> data) {
+        BlockKey key{owner, index};
+        auto &shard{GetShard(key)};
+        std::scoped_lock lock(shard.mutex);
+
+        if (shard.blocks.contains(key))
+            return;
+
+        if (data.size() > GetCapacity() / ShardCount)
+            return; // The block would evict the entire shard and then itself
+
+        shard.lru.emplace_front(CachedBlock{owner, index, std::vector<u8>(data.begin(), data.end())});
+        shard.blocks.emplace(key, shard.lru.begin());
+        shard.size += data.size();
+
+        TrimLocked(shard);
+    }
+
+    bool BlockCache::Contains(const CachedBacking *owner, size_t index) {
+        BlockKey key{owner, index};
+        auto &shard{GetShard(key)};
+        std::scoped_lock lock(shard.mutex);
+        return shard.blocks.contains(key);
+    }
+
+    void BlockCache::Evict(const CachedBacking *owner) {
+        for (auto &shard : shards) {
+            std::scoped_lock lock(shard.mutex);
+            for (auto it{shard.lru.begin()}; it != shard.lru.end();) {
+                if (it->owner == owner) {
+                    shard.size -= it->data.size();
+                    shard.blocks.erase(BlockKey{it->owner, it->index});
+                    it = shard.lru.erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+    }
+
+    void BlockCache::QueueReadAhead(CachedBacking *backing, size_t start, size_t end) {
+        {
+            std::scoped_lock lock(readAheadMutex);
+            auto it{std::find_if(readAheadRequests.begin(), readAheadRequests.end(), [backing](const ReadAheadRequest &request) { return request.backing == backing; })};
+            if (it != readAheadRequests.end()) {
+                // Only the most recent position of a stream is relevant, an older request would read blocks that have already been consumed
+                it->start = start;
+                it->end = end;
+            } else {
+                readAheadRequests.push_back(ReadAheadRequest{backing, start, end});
+            }
+
+            if (!readAheadThread.joinable())
+                readAheadThread = std::thread(&BlockCache::ReadAheadRun, this);
+        }
+        readAheadCondition.notify_all();
+    }
+
+    void BlockCache::CancelReadAhead(CachedBacking *backing) {
+        std::unique_lock lock(readAheadMutex);
+        std::erase_if(readAheadRequests, [backing](const ReadAheadRequest &request) { return request.backing == backing; });
+        readAheadCondition.wait(lock, [&] { return readAheadActive != backing; });
+    }
+
+    void BlockCache::ReadAheadRun() {
+        pthread_setname_np(pthread_self(), "BlockCache");
+
+        std::vector<u8> buffer;
+        std::unique_lock lock(readAheadMutex);
+        while (true) {
+            readAheadCondition.wait(lock, [this] { return readAheadExit || !readAheadRequests.empty(); });
+            if (readAheadExit)
+                return;
+
+            auto request{readAheadRequests.front()};
+            readAheadRequests.pop_front();
+            readAheadActive = request.backing;
+
+            lock.unlock();
+            request.backing->ReadAhead(request.start, request.end, buffer);
+            lock.lock();
+
+            readAheadActive = nullptr;
+            readAheadCondition.notify_all(); // Wake up any backing waiting in CancelReadAhead
+        }
+    }
+
+    CachedBacking::CachedBacking(std::shared_ptr<Backing> pBacking, size_t blockSize, BlockCache &cache) : Backing({true, false, false}, pBacking->size), backing(std::move(pBacking)), blockSize(blockSize), cache(cache) {
+        if (!std::has_single_bit(blockSize))
+            throw exception("CachedBacking block size must be a power of 2: 0x{:X}", blockSize);
+    }
+
+    CachedBacking::~CachedBacking() {
+        cache.CancelReadAhead(this);
+        cache.Evict(this);
+
+        auto statistics{GetStatistics()};
+        if (statistics.hits || statistics.misses)
+            Logger::Debug("Hits: {}, Misses: {}, Hit Rate: {:.2f}%, Read-Ahead Blocks: {}, Bypassed Reads: {}", statistics.hits, statistics.misses, statistics.HitRate() * 100.0, statistics.readAheadBlocks, statistics.bypassedReads);
+    }
+
+    size_t CachedBacking::ReadBlocks(std::vector<u8> &buffer, size_t start, size_t end) {
+        size_t offset{start * blockSize};
+        buffer.resize(std::min(end * blockSize, size) - offset);
+        return backing->ReadUnchecked(buffer, offset);
+    }
+
+    void CachedBacking::TrackAccess(size_t startBlock, size_t endBlock) {
+        // A read which continues within the last block of the previous read is still considered to be sequential
+        size_t previousEnd{sequentialEnd.exchange(endBlock, std::memory_order_relaxed)};
+        if (startBlock != previousEnd && startBlock + 1 != previousEnd) {
+            sequentialRun.store(0, std::memory_order_relaxed);
+            return;
+        }
+
+        if (sequentialRun.fetch_add(1, std::memory_order_relaxed) + 1 < ReadAheadThreshold)
+            return;
+
+        size_t blockCount{util::AlignUp(size, blockSize) / blockSize};
+        if (endBlock >= blockCount)
+            return;
+
+        cache.QueueReadAhead(this, endBlock, std::min(endBlock + ReadAheadBlocks, blockCount));
+    }
+
+    void CachedBacking::ReadAhead(size_t start, size_t end, std::vector<u8> &buffer) {
+        while (start < end && cache.Contains(this, start))
+            start++;
+        while (end > start && cache.Contains(this, end - 1))
+            end--;
+        if (start == end)
+            return;
+
+        try {
+            size_t read{ReadBlocks(buffer, start, end)};
+            for (size_t index{start}; index < end && (index - start) * blockSize < read; index++) {
+                size_t blockOffset{(index - start) * blockSize};
+                cache.Insert(this, index, span(buffer).subspan(blockOffset, std::min(blockSize, read - blockOffset)));
+                readAheadBlocks.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (const std::exception &e) {
+            // Read-ahead is purely speculative, any error will be surfaced by the synchronous read of the same data
+            Logger::Warn("Read-ahead of blocks 0x{:X}-0x{:X} failed: {}", start, end, e.what());
+        }
+    }
+
+    size_t CachedBacking::ReadImpl(span<u8> output, size_t offset) {
+        if (output.empty() || offset >= size)
+            return 0;
+
+        // Reads larger than a quarter of the cache aren't cached as they'd evict a large part of it for data that's unlikely to be read again
+        if (output.size() >= std::max(cache.GetCapacity() / 4, blockSize)) {
+            bypassedReads.fetch_add(1, std::memory_order_relaxed);
+            return backing->ReadUnchecked(output, offset);
+        }
+
+        size_t end{std::min(offset + output.size(), size)};
+        size_t startBlock{offset / blockSize}, endBlock{util::AlignUp(end, blockSize) / blockSize};
+        TrackAccess(startBlock, endBlock);
+
+        std::vector<u8> missBuffer;
+        for (size_t index{startBlock}; index < endBlock;) {
+            size_t blockStart{index * blockSize};
+            size_t copyStart{std::max(offset, blockStart)}, copyEnd{std::min(end, blockStart + blockSize)};
+            if (cache.Lookup(this, index, output.subspan(copyStart - offset, copyEnd - copyStart), copyStart - blockStart)) {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                index++;
+                continue;
+            }
+
+            // Consecutive missing blocks are coalesced into a single read from the parent backing
+            size_t missEnd{index + 1};
+            while (missEnd < endBlock && !cache.Contains(this, missEnd))
+                missEnd++;
+            misses.fetch_add(missEnd - index, std::memory_order_relaxed);
+
+            size_t read{ReadBlocks(missBuffer, index, missEnd)};
+            if (read != missBuffer.size())
+                return 0;
+
+            for (size_t missStart{index}; index < missEnd; index++) {
+                size_t bufferOffset{(index - missStart) * blockSize};
+                auto block{span(missBuffer).subspan(bufferOffset, std::min(blockSize, read - bufferOffset))};
+                cache.Insert(this, index, block);
+
+                blockStart = index * blockSize;
+                copyStart = std::max(offset, blockStart);
+                copyEnd = std::min(end, blockStart + blockSize);
+                std::memcpy(output.data() + (copyStart - offset), block.data() + (copyStart - blockStart), copyEnd - copyStart);
+            }
+        }
+
+        return end - offset;
+    }
+}
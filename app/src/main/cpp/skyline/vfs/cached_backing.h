@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include "backing.h"
+
+namespace skyline::vfs {
+    class CachedBacking;
+
+    /**
+     * @brief A process-wide cache of blocks from all CachedBacking instances which is bounded by a single capacity, alongside a single worker thread that services read-ahead for all of them
+     * @note The cache is split into shards by block with an independent LRU in each, this avoids a single lock being contended by concurrent readers
+     */
+    class BlockCache {
+      public:
+        static constexpr size_t DefaultCapacity{32 * 1024 * 1024}; //!< The amount of memory used for cached blocks prior to SetCapacity being called
+
+      private:
+        static constexpr size_t ShardCount{8};
+
+        struct CachedBlock {
+            const CachedBacking *owner; //!< The backing which the block belongs to
+            size_t index; //!< The index of the block in the owner
+            std::vector<u8> data; //!< The contents of the block, this is only shorter than the block size for the final block
+        };
+
+        struct BlockKey {
+            const CachedBacking *owner;
+            size_t index;
+
+            bool operator==(const BlockKey &) const = default;
+        };
+
+        struct BlockKeyHash {
+            size_t operator()(const BlockKey &key) const {
+                return std::hash<const void *>{}(key.owner) ^ (key.index * 0x9E3779B97F4A7C15);
+            }
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::list<CachedBlock> lru; //!< The blocks in this shard ordered from most to least recently used
+            std::unordered_map<BlockKey, std::list<CachedBlock>::iterator, BlockKeyHash> blocks; //!< A map from a block to the corresponding entry in the LRU
+            size_t size{}; //!< The total size of all blocks in this shard
+        };
+
+        std::array<Shard, ShardCount> shards;
+        std::atomic<size_t> capacity{DefaultCapacity};
+
+        struct ReadAheadRequest {
+            CachedBacking *backing;
+            size_t start; //!< The first block to read ahead
+            size_t end; //!< The block after the last block to read ahead
+        };
+
+        std::thread readAheadThread; //!< The thread that services read-ahead requests for all backings, this is only started on the first request
+        std::mutex readAheadMutex;
+        std::condition_variable readAheadCondition; //!< Signalled when a request is queued or the worker finishes a request
+        std::deque<ReadAheadRequest> readAheadRequests; //!< The pending read-ahead requests, there's at most one per backing
+        CachedBacking *readAheadActive{}; //!< The backing that the worker is currently reading from, if any
+        bool readAheadExit{}; //!< If the read-ahead thread should exit
+
+        Shard &GetShard(const BlockKey &key) {
+            return shards[BlockKeyHash{}(key) % ShardCount];
+        }
+
+        /**
+         * @brief Evicts least recently used blocks from the shard until it fits within its share of the capacity
+         * @note The shard's mutex must be locked when calling this
+         */
+        void TrimLocked(Shard &shard);
+
+        /**
+         * @brief Services read-ahead requests until the cache is destroyed
+         */
+        void ReadAheadRun();
+
+        BlockCache() = default;
+
+      public:
+        ~BlockCache();
+
+        /**
+         * @return The global block cache
+         */
+        static BlockCache &Get();
+
+        /**
+         * @brief Changes the maximum amount of memory used by cached blocks, evicting blocks if they exceed the new capacity
+         */
+        void SetCapacity(size_t capacity);
+
+        size_t GetCapacity() const {
+            return capacity.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Copies a part of the supplied block into the output if it is cached and marks it as the most recently used entry
+         * @return If the block was present in the cache
+         */
+        bool Lookup(const CachedBacking *owner, size_t index, span<u8> output, size_t blockOffset);
+
+        /**
+         * @brief Inserts a block into the cache if it isn't already present, evicting the least recently used blocks of the shard if it is full
+         */
+        void Insert(const CachedBacking *owner, size_t index, span<u8> data);
+
+        /**
+         * @return If the supplied block is present in the cache
+         */
+        bool Contains(const CachedBacking *owner, size_t index);
+
+        /**
+         * @brief Removes all blocks belonging to the supplied backing from the cache
+         */
+        void Evict(const CachedBacking *owner);
+
+        /**
+         * @brief Queues the supplied range of blocks to be read ahead by the worker, this replaces any pending request from the same backing
+         */
+        void QueueReadAhead(CachedBacking *backing, size_t start, size_t end);
+
+        /**
+         * @brief Drops any pending read-ahead of the supplied backing and waits for the worker to finish reading from it
+         */
+        void CancelReadAhead(CachedBacking *backing);
+    };
+
+    /**
+     * @brief A backing which caches fixed-size blocks of a parent backing in memory, this is intended to sit above backings that are expensive to read such as CtrEncryptedBacking
+     * @note The blocks are held in the global BlockCache which is shared by all instances
+     * @note Sequential reads are detected and the blocks following them are read ahead asynchronously by the BlockCache worker
+     */
+    class CachedBacking : public Backing {
+      public:
+        static constexpr size_t DefaultBlockSize{0x4000}; //!< 16 KiB blocks are a multiple of the RomFS/PFS0 hash block sizes and small enough for scattered reads
+
+        /**
+         * @brief Counters for evaluating the effectiveness of the cache
+         */
+        struct Statistics {
+            u64 hits; //!< The amount of block lookups which were served from the cache
+            u64 misses; //!< The amount of block lookups which required a read from the parent backing
+            u64 readAheadBlocks; //!< The amount of blocks which were inserted by read-ahead
+            u64 bypassedReads; //!< The amount of reads that were too large to be cached and went directly to the parent backing
+
+            /**
+             * @return The fraction of block lookups that were served from the cache
+             */
+            double HitRate() const {
+                return (hits + misses) ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+            }
+        };
+
+      private:
+        friend BlockCache;
+
+        static constexpr size_t ReadAheadThreshold{2}; //!< The amount of consecutive sequential reads after which read-ahead is triggered
+        static constexpr size_t ReadAheadBlocks{8}; //!< The amount of blocks read ahead of a sequential stream
+
+        std::shared_ptr<Backing> backing; //!< The parent backing
+        size_t blockSize;
+        BlockCache &cache;
+
+        std::atomic<u64> hits{}, misses{}, readAheadBlocks{}, bypassedReads{};
+
+        std::atomic<size_t> sequentialEnd{}; //!< The block index directly after the end of the last read
+        std::atomic<size_t> sequentialRun{}; //!< The amount of consecutive reads which started where the previous one ended
+
+        /**
+         * @brief Reads the blocks in the range [start, end) from the parent backing into the supplied buffer
+         * @return The amount of bytes read
+         */
+        size_t ReadBlocks(std::vector<u8> &buffer, size_t start, size_t end);
+
+        /**
+         * @brief Tracks the supplied read for sequential access and queues read-ahead for the blocks following it if it's part of a sequential stream
+         */
+        void TrackAccess(size_t startBlock, size_t endBlock);
+
+        /**
+         * @brief Reads the blocks in the range [start, end) which aren't already cached and inserts them into the cache
+         * @note This is called by the BlockCache read-ahead worker
+         */
+        void ReadAhead(size_t start, size_t end, std::vector<u8> &buffer);
+
+      protected:
+        size_t ReadImpl(span<u8> output, size_t offset) override;
+
+      public:
+        /**
+         * @param blockSize The size of a single cached block, this must be a power of 2
+         */
+        CachedBacking(std::shared_ptr<Backing> backing, size_t blockSize = DefaultBlockSize, BlockCache &cache = BlockCache::Get());
+
+        ~CachedBacking();
+
+        /**
+         * @return A snapshot of the cache counters
+         */
+        Statistics GetStatistics() const {
+            return {hits.load(std::memory_order_relaxed), misses.load(std::memory_order_relaxed), readAheadBlocks.load(std::memory_order_relaxed), bypassedReads.load(std::memory_order_relaxed)};
+        }
+    };
+}
@@ -3,27 +3,21 @@
 
 #pragma once
 
-#include <crypto/aes_cipher.h>
+#include <crypto/aes_ctr_cipher.h>
 #include <crypto/key_store.h>
 #include "backing.h"
 
 namespace skyline::vfs {
     /**
      * @brief A backing for decrypting AES-CTR data
+     * @note The keystream is derived from the offset of every read so no state is shared between reads, they can be done concurrently
      */
     class CtrEncryptedBacking : public Backing {
       private:
-        crypto::KeyStore::Key128 ctr;
-        crypto::AesCipher cipher;
+        crypto::AesCtrCipher cipher;
         std::shared_ptr<Backing> backing;
-        std::mutex mutex; //!< Synchronize all AES-CTR cipher state modifications
         size_t baseOffset; //!< The offset of the backing into the file is used to calculate the IV
 
-        /**
-         * @brief Calculates IV based on the offset
-         */
-        void UpdateCtr(u64 offset);
-
       protected:
         size_t ReadImpl(span<u8> output, size_t offset) override;
 
@@ -5,6 +5,7 @@
 #include <loader/loader.h>
 
 #include "ctr_encrypted_backing.h"
+#include "cached_backing.h"
 #include "region_backing.h"
 #include "partition_filesystem.h"
 #include "nca.h"
@@ -14,14 +15,14 @@
 namespace skyline::vfs {
     using namespace loader;
 
-    NCA::NCA(std::shared_ptr<vfs::Backing> pBacking, std::shared_ptr<crypto::KeyStore> pKeyStore, bool pUseKeyArea) : backing(std::move(pBacking)), keyStore(std::move(pKeyStore)), useKeyArea(pUseKeyArea) {
-        header = backing->Read<NcaHeader>();
+    NCA::NcaHeader NCA::ReadHeader(Backing &backing, const crypto::KeyStore &keyStore, bool &encrypted) {
+        auto header{backing.Read<NcaHeader>()};
 
         if (header.magic != util::MakeMagic<u32>("NCA3")) {
-            if (!keyStore->headerKey)
+            if (!keyStore.headerKey)
                 throw loader_exception(LoaderResult::MissingHeaderKey);
 
-            crypto::AesCipher cipher(*keyStore->headerKey, MBEDTLS_CIPHER_AES_128_XTS);
+            crypto::AesCipher cipher(*keyStore.headerKey, MBEDTLS_CIPHER_AES_128_XTS);
 
             cipher.XtsDecrypt({reinterpret_cast<u8 *>(&header), sizeof(NcaHeader)}, 0, 0x200);
 
@@ -31,6 +32,28 @@ namespace skyline::vfs {
             encrypted = true;
         }
 
+        return header;
+    }
+
+    NCA::NCA(std::shared_ptr<vfs::Backing> pBacking, std::shared_ptr<crypto::KeyStore> pKeyStore, bool pUseKeyArea) : backing(std::move(pBacking)), keyStore(std::move(pKeyStore)), useKeyArea(pUseKeyArea) {
+        header = ReadHeader(*backing, *keyStore, encrypted);
+        ReadSections();
+    }
+
+    NCA::NCA(std::shared_ptr<vfs::Backing> pBacking, std::shared_ptr<crypto::KeyStore> pKeyStore, const NcaHeader &pHeader, bool pEncrypted, bool pUseKeyArea) : header(pHeader), backing(std::move(pBacking)), keyStore(std::move(pKeyStore)), encrypted(pEncrypted), useKeyArea(pUseKeyArea) {
+        ReadSections();
+    }
+
+    std::optional<NCA> NCA::OpenIfContentType(std::shared_ptr<vfs::Backing> backing, std::shared_ptr<crypto::KeyStore> keyStore, NcaContentType contentType, bool useKeyArea) {
+        bool encrypted{};
+        auto header{ReadHeader(*backing, *keyStore, encrypted)};
+        if (header.contentType != contentType)
+            return std::nullopt;
+
+        return NCA(std::move(backing), std::move(keyStore), header, encrypted, useKeyArea);
+    }
+
+    void NCA::ReadSections() {
         contentType = header.contentType;
         rightsIdEmpty = header.rightsId == crypto::KeyStore::Key128{};
 
@@ -86,7 +109,8 @@ namespace skyline::vfs {
                 std::memcpy(ctr.data(), &secureValueLE, 4);
                 std::memcpy(ctr.data() + 4, &generationLE, 4);
 
-                return std::make_shared<CtrEncryptedBacking>(ctr, key, std::move(rawBacking), offset);
+                // Decrypted blocks are cached as repeated reads of the same sectors would otherwise need to be read and decrypted again
+                return std::make_shared<CachedBacking>(std::make_shared<CtrEncryptedBacking>(ctr, key, std::move(rawBacking), offset));
             }
             default:
                 return nullptr;
@@ -172,9 +172,22 @@ namespace skyline {
             std::shared_ptr<Backing> backing;
             std::shared_ptr<crypto::KeyStore> keyStore;
             bool encrypted{false};
+
+            /**
+             * @brief Reads the NCA header from the backing and decrypts it if required
+             * @param encrypted This is set to true if the header was encrypted
+             */
+            static NcaHeader ReadHeader(Backing &backing, const crypto::KeyStore &keyStore, bool &encrypted);
             bool rightsIdEmpty;
             bool useKeyArea;
 
+            /**
+             * @brief Sets up all sections of the NCA from the header which has already been read
+             */
+            void ReadSections();
+
+            NCA(std::shared_ptr<vfs::Backing> backing, std::shared_ptr<crypto::KeyStore> keyStore, const NcaHeader &header, bool encrypted, bool useKeyArea);
+
             void ReadPfs0(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry);
 
             void ReadRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry);
@@ -195,6 +208,12 @@ namespace skyline {
             NcaContentType contentType; //!< The content type of the NCA
 
             NCA(std::shared_ptr<vfs::Backing> backing, std::shared_ptr<crypto::KeyStore> keyStore, bool useKeyArea = false);
+
+            /**
+             * @brief Opens an NCA only if it has the supplied content type, the header is read first so no sections are set up for NCAs of any other type
+             * @return The NCA or std::nullopt if it has a different content type
+             */
+            static std::optional<NCA> OpenIfContentType(std::shared_ptr<vfs::Backing> backing, std::shared_ptr<crypto::KeyStore> keyStore, NcaContentType contentType, bool useKeyArea = false);
         };
     }
 }
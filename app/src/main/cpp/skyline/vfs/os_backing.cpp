@@ -3,24 +3,93 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/vfs.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include "os_backing.h"
 
 namespace skyline::vfs {
-    OsBacking::OsBacking(int fd, bool closable, Mode mode) : Backing(mode), fd(fd), closable(closable) {
+    OsBacking::OsBacking(int fd, bool closable, Mode mode, bool mapped) : Backing(mode), fd(fd), closable(closable) {
         struct stat fileInfo;
         if (fstat(fd, &fileInfo))
             throw exception("Failed to stat fd: {}", strerror(errno));
 
         size = static_cast<size_t>(fileInfo.st_size);
+
+        if (mapped && size) {
+            if (mode.write || mode.append)
+                throw exception("Cannot memory-map a writable OsBacking");
+
+            if (IsSafeToMap(fileInfo)) {
+                auto pointer{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+                if (pointer == MAP_FAILED)
+                    Logger::Warn("Failed to memory-map fd, falling back to regular reads: {}", strerror(errno));
+                else
+                    mapping = static_cast<const u8 *>(pointer);
+            }
+        }
+    }
+
+    bool OsBacking::IsSafeToMap(const struct stat &fileInfo) {
+        if (!S_ISREG(fileInfo.st_mode))
+            return false;
+
+        struct statfs fsInfo;
+        if (fstatfs(fd, &fsInfo)) {
+            Logger::Warn("Failed to stat filesystem of fd, falling back to regular reads: {}", strerror(errno));
+            return false;
+        }
+
+        constexpr decltype(fsInfo.f_type) FuseSuperMagic{0x65735546}, NfsSuperMagic{0x6969}, SmbSuperMagic{0x517B}, CifsSuperMagic{static_cast<decltype(fsInfo.f_type)>(0xFF534D42)};
+        switch (fsInfo.f_type) {
+            case FuseSuperMagic:
+            case NfsSuperMagic:
+            case SmbSuperMagic:
+            case CifsSuperMagic:
+                Logger::Debug("Not memory-mapping fd on a FUSE or network filesystem (0x{:X})", fsInfo.f_type);
+                return false;
+
+            default:
+                return true;
+        }
     }
 
     OsBacking::~OsBacking() {
+        if (mapping)
+            munmap(const_cast<u8 *>(mapping), size);
         if (closable)
             close(fd);
     }
 
+    void OsBacking::TrackAccess(size_t offset, size_t pSize) {
+        size_t end{offset + pSize};
+        if (sequentialEnd.exchange(end, std::memory_order_relaxed) != offset)
+            return;
+
+        // Only prefetch once the scan has consumed half of the previously prefetched region to avoid a madvise on every read
+        size_t prefetched{prefetchEnd.load(std::memory_order_relaxed)};
+        if (prefetched > end + (PrefetchSize / 2) || end >= size)
+            return;
+
+        size_t prefetchStart{util::AlignDown(std::max(prefetched, end), PAGE_SIZE)};
+        size_t prefetchStop{std::min(end + PrefetchSize, size)};
+        if (prefetchStart >= prefetchStop || !prefetchEnd.compare_exchange_strong(prefetched, prefetchStop, std::memory_order_relaxed))
+            return;
+
+        madvise(const_cast<u8 *>(mapping) + prefetchStart, prefetchStop - prefetchStart, MADV_WILLNEED);
+    }
+
     size_t OsBacking::ReadImpl(span<u8> output, size_t offset) {
+        if (mapping) {
+            if (offset >= size)
+                return 0;
+
+            size_t readSize{std::min(output.size(), size - offset)};
+            TrackAccess(offset, readSize);
+            std::memcpy(output.data(), mapping + offset, readSize);
+            return readSize;
+        }
+
         auto ret{pread64(fd, output.data(), output.size(), static_cast<off64_t>(offset))};
         if (ret < 0)
             throw exception("Failed to read from fd: {}", strerror(errno));
@@ -43,4 +112,12 @@ namespace skyline::vfs {
 
         size = pSize;
     }
+
+    span<const u8> OsBacking::GetViewImpl(size_t offset, size_t pSize) {
+        if (!mapping)
+            return {};
+
+        TrackAccess(offset, pSize);
+        return span<const u8>{mapping + offset, pSize};
+    }
 }
@@ -3,16 +3,34 @@
 
 #pragma once
 
+#include <sys/stat.h>
 #include "backing.h"
 
 namespace skyline::vfs {
     /**
      * @brief The OsBacking class provides the backing abstractions for a physical linux file
+     * @note A read-only file can optionally be memory-mapped, reads are then served directly from the page cache and views into the file can be retrieved with GetView
+     * @note Only regular files on local filesystems are mapped, an I/O error on a mapping is delivered as SIGBUS rather than an error code and the files exposed by content providers are commonly backed by FUSE or a remote source where those are expected
      */
     class OsBacking : public Backing {
       private:
+        static constexpr size_t PrefetchSize{0x200000}; //!< The amount of data ahead of a sequential scan which is prefetched into the page cache
+
         int fd; //!< An FD to the backing
         bool closable; //!< Whether the FD can be closed when the backing is destroyed
+        const u8 *mapping{}; //!< A read-only mapping of the entire file, this is only used if mapping was requested and the file is safe to map
+        std::atomic<size_t> sequentialEnd{}; //!< The end offset of the last access to the mapping
+        std::atomic<size_t> prefetchEnd{}; //!< The end offset of the last region which was prefetched
+
+        /**
+         * @brief Prefetches the region following the supplied access into the page cache if it continues a sequential scan
+         */
+        void TrackAccess(size_t offset, size_t pSize);
+
+        /**
+         * @return If the file is a regular file on a local filesystem, where a mapping won't fault on I/O errors that would be reported by pread
+         */
+        bool IsSafeToMap(const struct stat &fileInfo);
 
       protected:
         size_t ReadImpl(span<u8> output, size_t offset) override;
@@ -21,11 +39,14 @@ namespace skyline::vfs {
 
         void ResizeImpl(size_t size) override;
 
+        span<const u8> GetViewImpl(size_t offset, size_t pSize) override;
+
       public:
         /**
          * @param fd The file descriptor of the backing
+         * @param mapped If the file should be memory-mapped if possible, this is only supported for read-only backings and reads fall back to pread for files which can't be safely mapped
          */
-        OsBacking(int fd, bool closable = false, Mode = {true, false, false});
+        OsBacking(int fd, bool closable = false, Mode = {true, false, false}, bool mapped = false);
 
         ~OsBacking();
     };
@@ -19,6 +19,10 @@ namespace skyline::vfs {
             return backing->ReadUnchecked(output, baseOffset + offset);
         }
 
+        span<const u8> GetViewImpl(size_t offset, size_t pSize) override {
+            return backing->GetView(baseOffset + offset, pSize);
+        }
+
       public:
         /**
          * @param file The backing to create the RegionBacking from
@@ -5,116 +5,148 @@
 #include "rom_filesystem.h"
 
 namespace skyline::vfs {
-    RomFileSystem::RomFileSystem(std::shared_ptr<Backing> pBacking) : FileSystem(), backing(std::move(pBacking)) {
-        header = backing->Read<RomFsHeader>();
-        TraverseDirectory(0, "");
+    RomFileSystem::Metadata::Metadata(Backing &backing, const RomFsHeader &pHeader) : header(pHeader) {
+        // The tables are laid out back-to-back in practice so they're read as a single region, this avoids a read per entry or name during lookups
+        std::array<std::pair<u64, u64>, 4> tables{{
+            {header.dirHashTableOffset, header.dirHashTableSize},
+            {header.dirMetaTableOffset, header.dirMetaTableSize},
+            {header.fileHashTableOffset, header.fileHashTableSize},
+            {header.fileMetaTableOffset, header.fileMetaTableSize},
+        }};
+
+        baseOffset = std::numeric_limits<u64>::max();
+        u64 endOffset{};
+        for (const auto &[offset, size] : tables) {
+            baseOffset = std::min(baseOffset, offset);
+            endOffset = std::max(endOffset, offset + size);
+        }
+
+        data.resize(endOffset - baseOffset);
+        backing.Read(span(data), baseOffset);
     }
 
-    void RomFileSystem::TraverseFiles(u32 offset, const std::string &path) {
-        RomFsFileEntry entry;
-        do {
-            entry = backing->Read<RomFsFileEntry>(header.fileMetaTableOffset + offset);
+    u32 RomFileSystem::Metadata::GetBucket(u64 tableOffset, u64 tableSize, u32 parentOffset, std::string_view name) const {
+        size_t bucketCount{tableSize / sizeof(u32)};
+        if (!bucketCount)
+            return constant::RomFsEmptyEntry;
 
-            if (entry.nameSize) {
-                std::vector<char> name(entry.nameSize);
-                backing->Read(span(name), header.fileMetaTableOffset + offset + sizeof(RomFsFileEntry));
+        u32 hash{parentOffset ^ 123456789};
+        for (char character : name) {
+            hash = std::rotr(hash, 5);
+            hash ^= static_cast<u8>(character);
+        }
 
-                std::string fullPath{path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize)};
-                fileMap.emplace(fullPath, entry);
-            }
+        u32 offset;
+        std::memcpy(&offset, data.data() + (tableOffset - baseOffset) + (hash % bucketCount) * sizeof(u32), sizeof(u32));
+        return offset;
+    }
 
-            offset = entry.siblingOffset;
-        } while (offset != constant::RomFsEmptyEntry);
+    std::optional<u32> RomFileSystem::Metadata::FindDirectory(u32 parentOffset, std::string_view name) const {
+        for (u32 offset{GetBucket(header.dirHashTableOffset, header.dirHashTableSize, parentOffset, name)}; offset != constant::RomFsEmptyEntry;) {
+            auto [entry, entryName]{GetDirectory(offset)};
+            if (entry.parentOffset == parentOffset && entryName == name)
+                return offset;
+            offset = entry.hashSiblingOffset;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<u32> RomFileSystem::Metadata::FindFile(u32 parentOffset, std::string_view name) const {
+        for (u32 offset{GetBucket(header.fileHashTableOffset, header.fileHashTableSize, parentOffset, name)}; offset != constant::RomFsEmptyEntry;) {
+            auto [entry, entryName]{GetFile(offset)};
+            if (entry.parentOffset == parentOffset && entryName == name)
+                return offset;
+            offset = entry.hashSiblingOffset;
+        }
+        return std::nullopt;
+    }
+
+    RomFileSystem::RomFileSystem(std::shared_ptr<Backing> pBacking) : FileSystem(), backing(std::move(pBacking)) {
+        header = backing->Read<RomFsHeader>();
+        metadata = std::make_shared<Metadata>(*backing, header);
     }
 
-    void RomFileSystem::TraverseDirectory(u32 offset, const std::string &path) {
-        auto entry{backing->Read<RomFsDirectoryEntry>(header.dirMetaTableOffset + offset)};
+    std::optional<u32> RomFileSystem::ResolveDirectory(std::string_view path) {
+        u32 offset{}; // The root directory is always the first entry in the directory metadata table
+        while (!path.empty()) {
+            auto separator{path.find('/')};
+            auto component{path.substr(0, separator)};
+            path = (separator == std::string_view::npos) ? std::string_view{} : path.substr(separator + 1);
 
-        std::string childPath(path);
-        if (entry.nameSize) {
-            std::vector<char> name(entry.nameSize);
-            backing->Read(span(name), header.dirMetaTableOffset + offset + sizeof(RomFsDirectoryEntry));
-            childPath = path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize);
+            if (component.empty())
+                continue;
+
+            auto child{metadata->FindDirectory(offset, component)};
+            if (!child)
+                return std::nullopt;
+            offset = *child;
         }
+        return offset;
+    }
 
-        directoryMap.emplace(childPath, entry);
+    std::optional<RomFileSystem::RomFsFileEntry> RomFileSystem::ResolveFile(std::string_view path) {
+        auto separator{path.rfind('/')};
+        auto name{separator == std::string_view::npos ? path : path.substr(separator + 1)};
+        if (name.empty())
+            return std::nullopt;
 
-        if (entry.fileOffset != constant::RomFsEmptyEntry)
-            TraverseFiles(entry.fileOffset, childPath);
+        auto parent{ResolveDirectory(separator == std::string_view::npos ? std::string_view{} : path.substr(0, separator))};
+        if (!parent)
+            return std::nullopt;
 
-        if (entry.childOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.childOffset, childPath);
+        auto offset{metadata->FindFile(*parent, name)};
+        if (!offset)
+            return std::nullopt;
 
-        if (entry.siblingOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.siblingOffset, path);
+        return metadata->GetFile(*offset).first;
     }
 
     std::shared_ptr<Backing> RomFileSystem::OpenFileImpl(const std::string &path, Backing::Mode mode) {
-        try {
-            const auto &entry{fileMap.at(path)};
-            return std::make_shared<RegionBacking>(backing, header.dataOffset + entry.offset, entry.size, mode);
-        } catch (std::out_of_range &e) {
+        auto entry{ResolveFile(path)};
+        if (!entry)
             return nullptr;
-        }
+
+        return std::make_shared<RegionBacking>(backing, header.dataOffset + entry->offset, entry->size, mode);
     }
 
     std::optional<Directory::EntryType> RomFileSystem::GetEntryTypeImpl(const std::string &path) {
-        if (fileMap.count(path))
+        if (ResolveFile(path))
             return Directory::EntryType::File;
-        else if (directoryMap.count(path))
+        else if (ResolveDirectory(path))
             return Directory::EntryType::Directory;
 
         return std::nullopt;
     }
 
     std::shared_ptr<Directory> RomFileSystem::OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) {
-        try {
-            auto &entry{directoryMap.at(path)};
-            return std::make_shared<RomFileSystemDirectory>(backing, header, entry, listMode);
-        } catch (std::out_of_range &e) {
+        auto offset{ResolveDirectory(path)};
+        if (!offset)
             return nullptr;
-        }
+
+        return std::make_shared<RomFileSystemDirectory>(metadata, metadata->GetDirectory(*offset).first, listMode);
     }
 
-    RomFileSystemDirectory::RomFileSystemDirectory(std::shared_ptr<Backing> backing, const RomFileSystem::RomFsHeader &header, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode) : Directory(listMode), backing(std::move(backing)), header(header), ownEntry(ownEntry) {}
+    RomFileSystemDirectory::RomFileSystemDirectory(std::shared_ptr<RomFileSystem::Metadata> metadata, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode) : Directory(listMode), metadata(std::move(metadata)), ownEntry(ownEntry) {}
 
     std::vector<RomFileSystemDirectory::Entry> RomFileSystemDirectory::Read() {
         std::vector<Entry> contents;
 
         if (listMode.file) {
-            RomFileSystem::RomFsFileEntry romFsFileEntry;
-            u32 offset{ownEntry.fileOffset};
-
-            do {
-                romFsFileEntry = backing->Read<RomFileSystem::RomFsFileEntry>(header.fileMetaTableOffset + offset);
-
-                if (romFsFileEntry.nameSize) {
-                    std::vector<char> name(romFsFileEntry.nameSize);
-                    backing->Read(span(name), header.fileMetaTableOffset + offset + sizeof(RomFileSystem::RomFsFileEntry));
-
-                    contents.emplace_back(Entry{std::string(name.data(), romFsFileEntry.nameSize), EntryType::File, romFsFileEntry.size});
-                }
-
-                offset = romFsFileEntry.siblingOffset;
-            } while (offset != constant::RomFsEmptyEntry);
+            for (u32 offset{ownEntry.fileOffset}; offset != constant::RomFsEmptyEntry;) {
+                auto [entry, name]{metadata->GetFile(offset)};
+                if (!name.empty())
+                    contents.emplace_back(Entry{std::string(name), EntryType::File, entry.size});
+                offset = entry.siblingOffset;
+            }
         }
 
         if (listMode.directory) {
-            RomFileSystem::RomFsDirectoryEntry romFsDirectoryEntry;
-            u32 offset{ownEntry.childOffset};
-
-            do {
-                romFsDirectoryEntry = backing->Read<RomFileSystem::RomFsDirectoryEntry>(header.dirMetaTableOffset + offset);
-
-                if (romFsDirectoryEntry.nameSize) {
-                    std::vector<char> name(romFsDirectoryEntry.nameSize);
-                    backing->Read(span(name), header.dirMetaTableOffset + offset + sizeof(RomFileSystem::RomFsDirectoryEntry));
-
-                    contents.emplace_back(Entry{std::string(name.data(), romFsDirectoryEntry.nameSize), EntryType::Directory});
-                }
-
-                offset = romFsDirectoryEntry.siblingOffset;
-            } while (offset != constant::RomFsEmptyEntry);
+            for (u32 offset{ownEntry.childOffset}; offset != constant::RomFsEmptyEntry;) {
+                auto [entry, name]{metadata->GetDirectory(offset)};
+                if (!name.empty())
+                    contents.emplace_back(Entry{std::string(name), EntryType::Directory});
+                offset = entry.siblingOffset;
+            }
         }
 
         return contents;
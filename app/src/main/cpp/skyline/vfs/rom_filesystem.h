@@ -13,32 +13,9 @@ namespace skyline {
     namespace vfs {
         /**
          * @brief The RomFileSystem class abstracts access to a RomFS image using the vfs::FileSystem api
+         * @note Lookups are done through the hash tables stored in the RomFS itself, the image isn't traversed ahead of time
          */
         class RomFileSystem : public FileSystem {
-          private:
-            std::shared_ptr<Backing> backing;
-
-            /**
-             * @brief Traverses the sibling files of the given file and adds them to the file map
-             * @param offset The offset of the file entry to traverses the siblings of
-             * @param path The path to the parent directory of the supplied file entry
-             */
-            void TraverseFiles(u32 offset, const std::string &path);
-
-            /**
-             * @brief Traverses the directories within the given directory, adds them to the directory map and calls TraverseFiles on them
-             * @param offset The offset of the directory entry to traverses the directories in
-             * @param path The path to the supplied directory entry
-             */
-            void TraverseDirectory(u32 offset, const std::string &path);
-
-          protected:
-            std::shared_ptr<Backing> OpenFileImpl(const std::string &path, Backing::Mode mode) override;
-
-            std::optional<Directory::EntryType> GetEntryTypeImpl(const std::string &path) override;
-
-            std::shared_ptr<Directory> OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) override;
-
           public:
             struct RomFsHeader {
                 u64 headerSize; //!< The size of the header
@@ -59,7 +36,7 @@ namespace skyline {
                 u32 siblingOffset; //!< The offset from the directory metadata base of a sibling directory
                 u32 childOffset; //!< The offset from the directory metadata base of a child directory
                 u32 fileOffset; //!< The offset from the file metadata base of a child file
-                u32 hash; //!< The hash of the directory
+                u32 hashSiblingOffset; //!< The offset from the directory metadata base of the next directory in the same hash bucket
                 u32 nameSize; //!< The size of the directory's name in bytes
             };
 
@@ -68,13 +45,87 @@ namespace skyline {
                 u32 siblingOffset; //!< The offset from the file metadata base of a sibling file
                 u64 offset; //!< The offset from the file data base of the file contents
                 u64 size; //!< The size of the file in bytes
-                u32 hash; //!< The hash of the file
+                u32 hashSiblingOffset; //!< The offset from the file metadata base of the next file in the same hash bucket
                 u32 nameSize; //!< The size of the file's name in bytes
             };
 
-            std::unordered_map<std::string, RomFsFileEntry> fileMap; //!< A map that maps file names to their corresponding entry
-            std::unordered_map<std::string, RomFsDirectoryEntry> directoryMap; //!< A map that maps directory names to their corresponding entry
+            /**
+             * @brief A copy of all the hash and metadata tables of a RomFS, which is read from the backing in a single read
+             * @note Entry names are returned as views into this rather than being copied
+             */
+            class Metadata {
+              private:
+                std::vector<u8> data;
+                u64 baseOffset; //!< The offset of the start of the tables in the RomFS
+
+                template<typename EntryType>
+                std::pair<EntryType, std::string_view> GetEntry(u64 tableOffset, u64 tableSize, u32 offset) const {
+                    if (static_cast<u64>(offset) + sizeof(EntryType) > tableSize)
+                        throw exception("RomFS entry is out of bounds: 0x{:X}/0x{:X}", offset, tableSize);
+
+                    auto entryData{data.data() + (tableOffset - baseOffset) + offset};
+                    EntryType entry;
+                    std::memcpy(&entry, entryData, sizeof(EntryType));
+
+                    if (static_cast<u64>(offset) + sizeof(EntryType) + entry.nameSize > tableSize)
+                        throw exception("RomFS entry name is out of bounds: 0x{:X}/0x{:X}", offset, tableSize);
+
+                    return {entry, std::string_view(reinterpret_cast<const char *>(entryData + sizeof(EntryType)), entry.nameSize)};
+                }
+
+                /**
+                 * @return The offset of the first entry in the hash bucket corresponding to the supplied parent directory and name
+                 */
+                u32 GetBucket(u64 tableOffset, u64 tableSize, u32 parentOffset, std::string_view name) const;
+
+              public:
+                RomFsHeader header;
+
+                Metadata(Backing &backing, const RomFsHeader &header);
+
+                std::pair<RomFsDirectoryEntry, std::string_view> GetDirectory(u32 offset) const {
+                    return GetEntry<RomFsDirectoryEntry>(header.dirMetaTableOffset, header.dirMetaTableSize, offset);
+                }
+
+                std::pair<RomFsFileEntry, std::string_view> GetFile(u32 offset) const {
+                    return GetEntry<RomFsFileEntry>(header.fileMetaTableOffset, header.fileMetaTableSize, offset);
+                }
+
+                /**
+                 * @return The offset of the child directory with the supplied name in the directory metadata table, if it exists
+                 */
+                std::optional<u32> FindDirectory(u32 parentOffset, std::string_view name) const;
+
+                /**
+                 * @return The offset of the child file with the supplied name in the file metadata table, if it exists
+                 */
+                std::optional<u32> FindFile(u32 parentOffset, std::string_view name) const;
+            };
+
+          private:
+            std::shared_ptr<Backing> backing;
+            std::shared_ptr<Metadata> metadata;
+
+            /**
+             * @brief Resolves a path to a directory by looking up each of its components in the directory hash table
+             * @return The offset of the directory in the directory metadata table, if it exists
+             */
+            std::optional<u32> ResolveDirectory(std::string_view path);
+
+            /**
+             * @brief Resolves a path to a file by resolving its parent directory and looking it up in the file hash table
+             * @return The file's entry, if it exists
+             */
+            std::optional<RomFsFileEntry> ResolveFile(std::string_view path);
+
+          protected:
+            std::shared_ptr<Backing> OpenFileImpl(const std::string &path, Backing::Mode mode) override;
+
+            std::optional<Directory::EntryType> GetEntryTypeImpl(const std::string &path) override;
+
+            std::shared_ptr<Directory> OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) override;
 
+          public:
             RomFileSystem(std::shared_ptr<Backing> backing);
         };
 
@@ -84,11 +135,10 @@ namespace skyline {
         class RomFileSystemDirectory : public Directory {
           private:
             RomFileSystem::RomFsDirectoryEntry ownEntry; //!< This directory's entry in the RomFS header
-            RomFileSystem::RomFsHeader header; //!< A header of this files parent RomFS image
-            std::shared_ptr<Backing> backing;
+            std::shared_ptr<RomFileSystem::Metadata> metadata; //!< The metadata of this directory's parent RomFS image
 
           public:
-            RomFileSystemDirectory(std::shared_ptr<Backing> backing, const RomFileSystem::RomFsHeader &header, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode);
+            RomFileSystemDirectory(std::shared_ptr<RomFileSystem::Metadata> metadata, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode);
 
             std::vector<Entry> Read();
         };
@@ -96,12 +96,18 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
     var fps : Int = 0
     var averageFrametime : Float = 0.0f
     var averageFrametimeDeviation : Float = 0.0f
+    var averageInputLatency : Float = 0.0f
 
     /**
-     * Writes the current performance statistics into [fps], [averageFrametime] and [averageFrametimeDeviation] fields
+     * Writes the current performance statistics into [fps], [averageFrametime], [averageFrametimeDeviation] and [averageInputLatency] fields
      */
     private external fun updatePerformanceStatistics()
 
+    /**
+     * @return A human-readable summary of the amount of calls and latency of every SVC or null if SVC statistics aren't being collected
+     */
+    external fun getSvcStatistics() : String?
+
     /**
      * This initializes a guest controller in libskyline
      *
@@ -248,7 +254,7 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
                 postDelayed(object : Runnable {
                     override fun run() {
                         updatePerformanceStatistics()
-                        text = "$fps FPS\n${"%.1f".format(averageFrametime)}±${"%.2f".format(averageFrametimeDeviation)}ms"
+                        text = "$fps FPS\n${"%.1f".format(averageFrametime)}±${"%.2f".format(averageFrametimeDeviation)}ms\nInput: ${"%.1f".format(averageInputLatency)}ms"
                         postDelayed(this, 250)
                     }
                 }, 250)
@@ -15,24 +15,29 @@ import javax.inject.Singleton
 @Singleton
 class RomProvider @Inject constructor(@ApplicationContext private val context : Context) {
     /**
-     * This adds all files in [directory] with [extension] as an entry using [RomFile] to load metadata
+     * This collects all files in [directory] with an extension in [fileFormats], their metadata is loaded afterwards using [RomFile]
      */
     @SuppressLint("DefaultLocale")
-    private fun addEntries(fileFormats : Map<String, RomFormat>, directory : DocumentFile, entries : HashMap<RomFormat, ArrayList<AppEntry>>, systemLanguage : Int) {
+    private fun findEntries(fileFormats : Map<String, RomFormat>, directory : DocumentFile, entries : ArrayList<Pair<RomFormat, Uri>>) {
         directory.listFiles().forEach { file ->
             if (file.isDirectory) {
-                addEntries(fileFormats, file, entries, systemLanguage)
+                findEntries(fileFormats, file, entries)
             } else {
-                fileFormats[file.name?.substringAfterLast(".")?.lowercase()]?.let { romFormat->
-                    entries.getOrPut(romFormat, { arrayListOf() }).add(RomFile(context, romFormat, file.uri, systemLanguage).appEntry)
+                fileFormats[file.name?.substringAfterLast(".")?.lowercase()]?.let { romFormat ->
+                    entries.add(romFormat to file.uri)
                 }
             }
         }
     }
 
     fun loadRoms(searchLocation : Uri, systemLanguage : Int) = DocumentFile.fromTreeUri(context, searchLocation)!!.let { documentFile ->
+        val files = arrayListOf<Pair<RomFormat, Uri>>()
+        findEntries(mapOf("nro" to NRO, "nso" to NSO, "nca" to NCA, "nsp" to NSP, "xci" to XCI), documentFile, files)
+
         hashMapOf<RomFormat, ArrayList<AppEntry>>().apply {
-            addEntries(mapOf("nro" to NRO, "nso" to NSO, "nca" to NCA, "nsp" to NSP, "xci" to XCI), documentFile, this, systemLanguage)
+            RomFile.populate(context, files, systemLanguage).forEach { romFile ->
+                getOrPut(romFile.appEntry.format, { arrayListOf() }).add(romFile.appEntry)
+            }
         }
     }
 }
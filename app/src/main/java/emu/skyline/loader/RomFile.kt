@@ -16,6 +16,9 @@ import java.io.ObjectInputStream
 import java.io.ObjectOutputStream
 import java.io.Serializable
 import java.util.*
+import java.util.concurrent.Callable
+import java.util.concurrent.Executors
+import java.util.concurrent.TimeUnit
 
 /**
  * An enumeration of all supported ROM formats
@@ -103,7 +106,7 @@ data class AppEntry(var name : String, var author : String?, var icon : Bitmap?,
 /**
  * This class is used as interface between libskyline and Kotlin for loaders
  */
-internal class RomFile(context : Context, format : RomFormat, uri : Uri, systemLanguage : Int) {
+internal class RomFile private constructor(private val format : RomFormat, private val uri : Uri) {
     /**
      * @note This field is filled in by native code
      */
@@ -119,33 +122,80 @@ internal class RomFile(context : Context, format : RomFormat, uri : Uri, systemL
      */
     private var rawIcon : ByteArray? = null
 
-    val appEntry : AppEntry
+    lateinit var appEntry : AppEntry
+        private set
 
     var result = LoaderResult.Success
+        private set
 
     val valid : Boolean
         get() = result == LoaderResult.Success
 
-    init {
-        context.contentResolver.openFileDescriptor(uri, "r")!!.use {
-            result = LoaderResult.get(populate(format.ordinal, it.fd, context.filesDir.canonicalPath + "/", systemLanguage))
-        }
-
-        appEntry = applicationName?.let { name ->
-            applicationAuthor?.let { author ->
-                rawIcon?.let { icon ->
-                    AppEntry(name, author, BitmapFactory.decodeByteArray(icon, 0, icon.size), format, uri, result)
-                }
+    private fun createAppEntry(context : Context) = applicationName?.let { name ->
+        applicationAuthor?.let { author ->
+            rawIcon?.let { icon ->
+                AppEntry(name, author, BitmapFactory.decodeByteArray(icon, 0, icon.size), format, uri, result)
             }
-        } ?: AppEntry(context, format, uri, result)
-    }
+        }
+    } ?: AppEntry(context, format, uri, result)
 
     /**
-     * Parses ROM and writes its metadata to [applicationName], [applicationAuthor] and [rawIcon]
+     * Parses the ROM and writes its metadata to [applicationName], [applicationAuthor] and [rawIcon]
+     * @param scanner A handle to a native library scanner created with [createScanner]
      * @param format The format of the ROM
      * @param romFd A file descriptor of the ROM
-     * @param appFilesPath Path to internal app data storage, needed to read imported keys
-     * @return A pointer to the newly allocated object, or 0 if the ROM is invalid
+     * @return A value from [LoaderResult]
      */
-    private external fun populate(format : Int, romFd : Int, appFilesPath : String, systemLanguage : Int) : Int
+    private external fun populate(scanner : Long, format : Int, romFd : Int, systemLanguage : Int) : Int
+
+    companion object {
+        /**
+         * Parses the metadata of all supplied ROMs concurrently on a bounded pool of workers, a single native scanner is shared by all of them so that the key store and metadata cache are shared
+         * @note Every ROM is opened, parsed and closed within its own task so at most one file descriptor per worker is open at any time
+         * @param files The format and URI of every ROM that should be parsed
+         * @return A [RomFile] for every entry in [files] in the same order
+         */
+        fun populate(context : Context, files : List<Pair<RomFormat, Uri>>, systemLanguage : Int) : List<RomFile> {
+            if (files.isEmpty())
+                return emptyList()
+
+            val scanner = createScanner(context.filesDir.canonicalPath + "/")
+            val executor = Executors.newFixedThreadPool(Runtime.getRuntime().availableProcessors().coerceIn(1, files.size))
+            try {
+                return files.map { (format, uri) ->
+                    executor.submit(Callable {
+                        RomFile(format, uri).apply {
+                            result = try {
+                                context.contentResolver.openFileDescriptor(uri, "r")!!.use {
+                                    LoaderResult.get(populate(scanner, format.ordinal, it.fd, systemLanguage))
+                                }
+                            } catch (e : Exception) {
+                                LoaderResult.ParsingError
+                            }
+                            appEntry = createAppEntry(context)
+                        }
+                    })
+                }.map { it.get() }
+            } finally {
+                // The scanner must outlive every task that could still be using it
+                executor.shutdownNow()
+                executor.awaitTermination(Long.MAX_VALUE, TimeUnit.NANOSECONDS)
+                destroyScanner(scanner)
+            }
+        }
+
+        /**
+         * Creates a native library scanner which holds the key store and handles caching of metadata
+         * @param appFilesPath Path to internal app data storage, needed to read imported keys and to cache metadata
+         * @return A handle to the scanner or 0 if it couldn't be created
+         */
+        @JvmStatic
+        private external fun createScanner(appFilesPath : String) : Long
+
+        /**
+         * Destroys a scanner created with [createScanner], this also evicts the least recently used entries of the metadata cache
+         */
+        @JvmStatic
+        private external fun destroyScanner(scanner : Long)
+    }
 }
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <soc/gm20b/gmmu.h>
+#include "test.h"
+
+namespace skyline::test {
+    using GMMU = soc::gm20b::GMMU;
+
+    constexpr u64 PageSize{0x1000};
+    constexpr u64 BaseAddress{0x100000};
+
+    TEST(TranslateContiguousSingleMapping) {
+        GMMU gmmu;
+        std::vector<u8> backing(PageSize * 4);
+        gmmu.Map(BaseAddress, backing.data(), backing.size());
+
+        EXPECT(gmmu.TranslateContiguous(BaseAddress, backing.size()) == backing.data());
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + 0x10, PageSize) == backing.data() + 0x10);
+    }
+
+    TEST(TranslateContiguousAdjacentMappings) {
+        GMMU gmmu;
+        std::vector<u8> backing(PageSize * 4);
+
+        // Two mappings which are adjacent in both the GPU AS and host memory form a single contiguous range
+        gmmu.Map(BaseAddress, backing.data(), PageSize * 2);
+        gmmu.Map(BaseAddress + PageSize * 2, backing.data() + PageSize * 2, PageSize * 2);
+
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize, PageSize * 2) == backing.data() + PageSize);
+    }
+
+    TEST(TranslateContiguousSplitMappings) {
+        GMMU gmmu;
+        std::vector<u8> first(PageSize * 2), second(PageSize * 2);
+
+        // Mappings which are adjacent in the GPU AS but not in host memory can't be accessed through a single pointer
+        gmmu.Map(BaseAddress, first.data(), first.size());
+        gmmu.Map(BaseAddress + first.size(), second.data(), second.size());
+
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize, PageSize * 2) == nullptr);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + first.size(), second.size()) == second.data());
+
+        // The fallback path must still be able to access the entire range
+        std::array<u8, PageSize * 2> data;
+        data.fill(0xAB);
+        gmmu.Write(BaseAddress + PageSize, data.data(), data.size());
+        EXPECT(first[PageSize] == 0xAB && first.back() == 0xAB && second.front() == 0xAB && second[PageSize - 1] == 0xAB);
+    }
+
+    TEST(TranslateContiguousSparseMapping) {
+        GMMU gmmu;
+        std::vector<u8> backing(PageSize);
+        gmmu.Map(BaseAddress, backing.data(), backing.size());
+        gmmu.Map(BaseAddress + PageSize, GMMU::SparsePlaceholderAddress(), PageSize * 2, {true});
+
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize, PageSize) == nullptr);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress, PageSize * 2) == nullptr);
+
+        // Sparse mappings read as zero through the fallback path
+        std::array<u8, PageSize> data;
+        data.fill(0xFF);
+        gmmu.Read(data.data(), BaseAddress + PageSize, data.size());
+        EXPECT(std::all_of(data.begin(), data.end(), [](u8 value) { return value == 0; }));
+    }
+
+    TEST(TranslateContiguousUnmappedRange) {
+        GMMU gmmu;
+        std::vector<u8> backing(PageSize * 2);
+        gmmu.Map(BaseAddress, backing.data(), backing.size());
+
+        EXPECT(gmmu.TranslateContiguous(BaseAddress - PageSize, PageSize) == nullptr);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize, PageSize * 2) == nullptr);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize * 8, PageSize) == nullptr);
+
+        // A hole punched into a mapping splits it into two ranges which aren't contiguous
+        gmmu.Unmap(BaseAddress + PageSize / 2, PageSize / 2);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress, PageSize * 2) == nullptr);
+        EXPECT(gmmu.TranslateContiguous(BaseAddress + PageSize, PageSize) == backing.data() + PageSize);
+    }
+
+    TEST(TlbInvalidatedOnRemap) {
+        GMMU gmmu;
+        std::vector<u8> first(PageSize * 2, 0x11), second(PageSize * 2, 0x22);
+        gmmu.Map(BaseAddress, first.data(), first.size());
+        EXPECT(gmmu.Read<u32>(BaseAddress + PageSize) == 0x11111111);
+
+        // The translation of the previous mapping is cached by the TLB of this thread, it must not be used after the remap
+        gmmu.Map(BaseAddress, second.data(), second.size());
+        EXPECT(gmmu.Read<u32>(BaseAddress + PageSize) == 0x22222222);
+        gmmu.Write(BaseAddress, reinterpret_cast<u8 *>(first.data()), sizeof(u32));
+        EXPECT(second[0] == 0x11 && second[4] == 0x22);
+
+        gmmu.Unmap(BaseAddress, second.size());
+        bool faulted{};
+        try {
+            gmmu.Read<u32>(BaseAddress);
+        } catch (const std::exception &) {
+            faulted = true;
+        }
+        EXPECT(faulted);
+    }
+
+    TEST(ReadWriteAcrossMappings) {
+        GMMU gmmu;
+        std::vector<u8> first(PageSize * 3), second(PageSize * 2);
+        gmmu.Map(BaseAddress, first.data(), first.size());
+        gmmu.Map(BaseAddress + first.size(), GMMU::SparsePlaceholderAddress(), PageSize, {true});
+        gmmu.Map(BaseAddress + first.size() + PageSize, second.data(), second.size());
+
+        size_t size{first.size() + PageSize + second.size()};
+        std::vector<u8> data(size);
+        for (size_t index{}; index < size; index++)
+            data[index] = static_cast<u8>(index * 7);
+        gmmu.Write(BaseAddress, data.data(), size);
+
+        EXPECT(std::memcmp(first.data(), data.data(), first.size()) == 0);
+        EXPECT(std::memcmp(second.data(), data.data() + first.size() + PageSize, second.size()) == 0);
+
+        // Writes to the sparse mapping are discarded and it reads back as zero
+        std::vector<u8> readBack(size);
+        gmmu.Read(readBack.data(), BaseAddress, size);
+        EXPECT(std::memcmp(readBack.data(), data.data(), first.size()) == 0);
+        EXPECT(std::all_of(readBack.begin() + first.size(), readBack.begin() + first.size() + PageSize, [](u8 value) { return value == 0; }));
+        EXPECT(std::memcmp(readBack.data() + first.size() + PageSize, second.data(), second.size()) == 0);
+    }
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <gpu/texture/format.h>
+#include <gpu/texture/bc_decoder.h>
+#include "test.h"
+
+namespace skyline::test {
+    namespace bcn = gpu::texture::bcn;
+    namespace format = gpu::format;
+
+    constexpr u32 Rgba(u32 red, u32 green, u32 blue, u32 alpha) {
+        return red | (green << 8) | (blue << 16) | (alpha << 24);
+    }
+
+    /**
+     * @return The RGBA8 texels of the supplied compressed texture decoded by bcn::Decode
+     */
+    static std::vector<u32> DecodeTexels(gpu::texture::Format format, const std::vector<u8> &input, gpu::texture::Dimensions dimensions) {
+        std::vector<u32> texels(static_cast<size_t>(dimensions.width) * dimensions.height * dimensions.depth);
+        EXPECT(bcn::GetDecodedFormat(format)->GetSize(dimensions) == texels.size() * sizeof(u32));
+        bcn::Decode(format, input.data(), reinterpret_cast<u8 *>(texels.data()), dimensions);
+        return texels;
+    }
+
+    /**
+     * @return A 4x4 golden image with the four supplied texels repeated in every row
+     */
+    static std::vector<u32> RepeatRows(std::array<u32, 4> row) {
+        std::vector<u32> texels;
+        for (u32 y{}; y < 4; y++)
+            texels.insert(texels.end(), row.begin(), row.end());
+        return texels;
+    }
+
+    // Every row of these blocks selects palette entries 0, 1, 2 and 3 in order
+    constexpr u8 RowIndices{0b11100100};
+
+    TEST(DecodeBc1FourColor) {
+        // Red (0xF800) as the first endpoint and blue (0x001F) as the second selects the 4-color mode
+        std::vector<u8> block{0x00, 0xF8, 0x1F, 0x00, RowIndices, RowIndices, RowIndices, RowIndices};
+        EXPECT(DecodeTexels(format::BC1Unorm, block, {4, 4, 1}) == RepeatRows({Rgba(255, 0, 0, 255), Rgba(0, 0, 255, 255), Rgba(170, 0, 85, 255), Rgba(85, 0, 170, 255)}));
+    }
+
+    TEST(DecodeBc1PunchThrough) {
+        // The first endpoint being smaller selects the 3-color mode with the last index being transparent black
+        std::vector<u8> block{0x1F, 0x00, 0x00, 0xF8, RowIndices, RowIndices, RowIndices, RowIndices};
+        EXPECT(DecodeTexels(format::BC1Unorm, block, {4, 4, 1}) == RepeatRows({Rgba(0, 0, 255, 255), Rgba(255, 0, 0, 255), Rgba(127, 0, 127, 255), 0}));
+    }
+
+    TEST(DecodeBc2) {
+        // Explicit 4-bit alpha of the texel index, the color block of BC2 is always in the 4-color mode regardless of endpoint order
+        std::vector<u8> block{0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0x1F, 0x00, 0x00, 0xF8, RowIndices, RowIndices, RowIndices, RowIndices};
+        std::array<u32, 4> colors{Rgba(0, 0, 255, 0), Rgba(255, 0, 0, 0), Rgba(85, 0, 170, 0), Rgba(170, 0, 85, 0)};
+
+        std::vector<u32> expected;
+        for (u32 texel{}; texel < 16; texel++)
+            expected.push_back(colors[texel % 4] | ((texel * 0x11) << 24));
+        EXPECT(DecodeTexels(format::BC2Unorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc3) {
+        // An 8-value alpha block with texel N selecting index N % 8 and an opaque white color block
+        std::vector<u8> block{0xFF, 0x00, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00};
+        std::array<u32, 8> alpha{255, 0, 219, 182, 146, 109, 73, 36};
+
+        std::vector<u32> expected;
+        for (u32 texel{}; texel < 16; texel++)
+            expected.push_back(Rgba(255, 255, 255, alpha[texel % 8]));
+        EXPECT(DecodeTexels(format::BC3Unorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc4Unorm) {
+        // The first endpoint not being larger selects the 6-value mode with explicit 0 and 1 values
+        std::vector<u8> block{0x00, 0xFF, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA};
+        std::array<u32, 8> red{0, 255, 51, 102, 153, 204, 0, 255};
+
+        std::vector<u32> expected;
+        for (u32 texel{}; texel < 16; texel++)
+            expected.push_back(Rgba(red[texel % 8], 0, 0, 255));
+        EXPECT(DecodeTexels(format::BC4Unorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc4Snorm) {
+        // -128 is treated as -127, the decoded values are two's complement bytes
+        std::vector<u8> block{0x80, 0x7F, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA};
+        std::array<u32, 8> red{0x81, 0x7F, 0xB4, 0xE7, 0x19, 0x4C, 0x81, 0x7F};
+
+        std::vector<u32> expected;
+        for (u32 texel{}; texel < 16; texel++)
+            expected.push_back(Rgba(red[texel % 8], 0, 0, 0x7F));
+        EXPECT(DecodeTexels(format::BC4Snorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc5) {
+        // Red uses the 8-value mode with every texel selecting index 2, green uses the 6-value mode with every texel selecting index 7
+        std::vector<u8> block{0xFF, 0x00, 0x92, 0x24, 0x49, 0x92, 0x24, 0x49, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        EXPECT(DecodeTexels(format::BC5Unorm, block, {4, 4, 1}) == std::vector<u32>(16, Rgba(219, 255, 0, 255)));
+    }
+
+    TEST(DecodeBc7Mode6) {
+        // A single subset with per-endpoint P-bits and 4-bit indices, texel N selects index N
+        std::vector<u8> block{0xC0, 0x3F, 0x00, 0xF0, 0x07, 0x02, 0xFF, 0xFF, 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE};
+        std::vector<u32> expected{
+            0xFF8101FF, 0xFF8111EF, 0xFF8125DB, 0xFF8134CB, 0xFF8144BB, 0xFF8154AB, 0xFF816897, 0xFF817887,
+            0xFE808778, 0xFE809768, 0xFE80AB54, 0xFE80BB44, 0xFE80CB34, 0xFE80DA24, 0xFE80EE10, 0xFE80FE00,
+        };
+        EXPECT(DecodeTexels(format::BC7Unorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc7Mode5Rotation) {
+        // Separate color and alpha indices with the alpha channel rotated into red, texel N selects color index N % 4 and alpha index N / 4
+        std::vector<u8> block{0x60, 0x7F, 0x00, 0x10, 0x08, 0xF8, 0x03, 0xFC, 0xCB, 0xC9, 0xC9, 0xC9, 0x01, 0x55, 0xAA, 0xFF};
+        std::vector<u32> expected{
+            0xFF008100, 0xAB548100, 0x54AB8100, 0x00FF8100, 0xFF008154, 0xAB548154, 0x54AB8154, 0x00FF8154,
+            0xFF0081AB, 0xAB5481AB, 0x54AB81AB, 0x00FF81AB, 0xFF0081FF, 0xAB5481FF, 0x54AB81FF, 0x00FF81FF,
+        };
+        EXPECT(DecodeTexels(format::BC7Unorm, block, {4, 4, 1}) == expected);
+    }
+
+    TEST(DecodeBc7ReservedMode) {
+        std::vector<u8> block(16, 0);
+        EXPECT(DecodeTexels(format::BC7Unorm, block, {4, 4, 1}) == std::vector<u32>(16, 0));
+    }
+
+    TEST(DecodeClipsPartialBlocks) {
+        // A 5x3x2 texture is 2x1 blocks per slice, texels of the blocks outside of the texture must be discarded
+        std::vector<u8> blocks;
+        std::array<u8, 4> colors{0x00, 0x40, 0x80, 0xFF};
+        for (u8 color : colors)
+            blocks.insert(blocks.end(), {color, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}); // Every texel selects the first endpoint
+
+        auto texels{DecodeTexels(format::BC4Unorm, blocks, {5, 3, 2})};
+        for (u32 z{}; z < 2; z++)
+            for (u32 y{}; y < 3; y++)
+                for (u32 x{}; x < 5; x++)
+                    EXPECT(texels[(z * 3 + y) * 5 + x] == Rgba(colors[z * 2 + (x / 4)], 0, 0, 255));
+    }
+
+    TEST(DecodedFormats) {
+        EXPECT(bcn::IsDecodable(format::BC1Unorm) && bcn::IsDecodable(format::BC7Srgb));
+        EXPECT(!bcn::IsDecodable(format::BC6HUfloat) && !bcn::IsDecodable(format::R8G8B8A8Unorm));
+        EXPECT(bcn::GetDecodedFormat(format::BC3Srgb) == format::A8B8G8R8Srgb);
+        EXPECT(bcn::GetDecodedFormat(format::BC5Snorm) == format::A8B8G8R8Snorm);
+        EXPECT(bcn::GetDecodedFormat(format::BC7Unorm) == format::R8G8B8A8Unorm);
+    }
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <soc/gm20b/gmmu.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    using GMMU = soc::gm20b::GMMU;
+
+    constexpr u64 PageSize{0x1000};
+    constexpr u64 BaseAddress{0x100000};
+    constexpr size_t MappingCount{256}; //!< The amount of separate mappings in the AS, this determines the cost of a block lookup
+
+    /**
+     * @brief A GMMU with MappingCount non-contiguous single-page mappings followed by a single large mapping
+     */
+    struct GmmuFixture {
+        static constexpr size_t LargeMappingSize{0x400000};
+
+        GMMU gmmu;
+        std::vector<u8> smallBacking;
+        std::vector<u8> largeBacking;
+
+        GmmuFixture() : smallBacking(MappingCount * PageSize * 2), largeBacking(LargeMappingSize) {
+            // Every other host page is skipped so that adjacent mappings can't be merged
+            for (size_t index{}; index < MappingCount; index++)
+                gmmu.Map(BaseAddress + index * PageSize, smallBacking.data() + index * PageSize * 2, PageSize);
+            gmmu.Map(LargeBase(), largeBacking.data(), largeBacking.size());
+        }
+
+        static constexpr u64 LargeBase() {
+            return BaseAddress + MappingCount * PageSize;
+        }
+    };
+
+    BENCHMARK(GmmuReadSmallRepeated) {
+        static GmmuFixture fixture;
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            DoNotOptimize(fixture.gmmu.Read<u32>(BaseAddress + (iteration % 16) * sizeof(u32)));
+    }
+
+    BENCHMARK(GmmuReadSmallScattered) {
+        static GmmuFixture fixture;
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            DoNotOptimize(fixture.gmmu.Read<u32>(BaseAddress + ((iteration * 97) % MappingCount) * PageSize));
+    }
+
+    BENCHMARK(GmmuReadSmallWithinLargeMapping) {
+        static GmmuFixture fixture;
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            DoNotOptimize(fixture.gmmu.Read<u32>(GmmuFixture::LargeBase() + ((iteration * 0x1234) % (GmmuFixture::LargeMappingSize / sizeof(u32))) * sizeof(u32)));
+    }
+
+    BENCHMARK(GmmuReadLarge) {
+        static GmmuFixture fixture;
+        static std::vector<u8> destination(GmmuFixture::LargeMappingSize);
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            fixture.gmmu.Read(destination.data(), GmmuFixture::LargeBase(), destination.size());
+            ClobberMemory();
+        }
+    }
+
+    BENCHMARK(GmmuWriteAcrossMappings) {
+        static GmmuFixture fixture;
+        static std::vector<u8> source(MappingCount * PageSize);
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            fixture.gmmu.Write(BaseAddress, source.data(), source.size());
+            ClobberMemory();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <crypto/aes_ctr_cipher.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    using AesCtrCipher = crypto::AesCtrCipher;
+
+    /**
+     * @brief A random key, counter and buffer for decrypting a single read of a typical size from a CTR-encrypted NCA section
+     */
+    struct AesCtrFixture {
+        static constexpr size_t BufferSize{0x10000}; //!< The size of every decryption, this matches the block size of the ROM block cache
+
+        AesCtrCipher::Block key;
+        AesCtrCipher::Block ctr;
+        std::vector<u8> buffer;
+
+        AesCtrFixture() : buffer(BufferSize + AesCtrCipher::BlockSize) {
+            std::mt19937 random{BufferSize};
+            std::generate(key.begin(), key.end(), [&random]() { return static_cast<u8>(random()); });
+            std::generate(ctr.begin(), ctr.end(), [&random]() { return static_cast<u8>(random()); });
+            std::generate(buffer.begin(), buffer.end(), [&random]() { return static_cast<u8>(random()); });
+        }
+    };
+
+    BENCHMARK(AesCtrCipherDecrypt64KiB) {
+        static AesCtrFixture fixture;
+        static AesCtrCipher cipher{fixture.key, fixture.ctr};
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            cipher.Decrypt(span(fixture.buffer.data(), AesCtrFixture::BufferSize), iteration * AesCtrFixture::BufferSize);
+            ClobberMemory();
+        }
+    }
+
+    BENCHMARK(AesCtrCipherDecrypt64KiBUnaligned) {
+        static AesCtrFixture fixture;
+        static AesCtrCipher cipher{fixture.key, fixture.ctr};
+        // The head and tail of the data are partial blocks which are transformed separately from the bulk of it
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            cipher.Decrypt(span(fixture.buffer.data() + 3, AesCtrFixture::BufferSize), iteration * AesCtrFixture::BufferSize + 3);
+            ClobberMemory();
+        }
+    }
+
+    /**
+     * @brief An mbedtls AES encryption context with the supplied key, it can't be copied as it points into itself
+     */
+    struct MbedtlsAesContext {
+        mbedtls_aes_context context;
+
+        MbedtlsAesContext(const AesCtrCipher::Block &key) {
+            mbedtls_aes_init(&context);
+            mbedtls_aes_setkey_enc(&context, key.data(), static_cast<unsigned int>(key.size() * 8));
+        }
+
+        ~MbedtlsAesContext() {
+            mbedtls_aes_free(&context);
+        }
+    };
+
+    /**
+     * @brief The baseline of decrypting with mbedtls' CTR mode which requires resetting the counter for every read, this is what CtrEncryptedBacking used prior to AesCtrCipher
+     */
+    BENCHMARK(MbedtlsCtrDecrypt64KiB) {
+        static AesCtrFixture fixture;
+        static MbedtlsAesContext aes{fixture.key};
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            AesCtrCipher::Block counter{fixture.ctr}, streamBlock{};
+            u64 block;
+            std::memcpy(&block, counter.data() + sizeof(u64), sizeof(u64));
+            block = util::SwapEndianness(util::SwapEndianness(block) + iteration * (AesCtrFixture::BufferSize / AesCtrCipher::BlockSize));
+            std::memcpy(counter.data() + sizeof(u64), &block, sizeof(u64));
+
+            size_t streamOffset{};
+            mbedtls_aes_crypt_ctr(&aes.context, AesCtrFixture::BufferSize, &streamOffset, counter.data(), streamBlock.data(), fixture.buffer.data(), fixture.buffer.data());
+            ClobberMemory();
+        }
+    }
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <gpu/texture/format.h>
+#include <gpu/texture/bc_decoder.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    namespace bcn = gpu::texture::bcn;
+    namespace format = gpu::format;
+
+    constexpr gpu::texture::Dimensions TextureDimensions{1024, 1024, 1};
+
+    /**
+     * @brief A texture of random blocks, this covers all modes of formats with per-block modes such as BC7
+     */
+    struct RandomTexture {
+        gpu::texture::Format format;
+        std::vector<u8> input, output;
+
+        RandomTexture(gpu::texture::Format format) : format(format), input(format->GetSize(TextureDimensions)), output(bcn::GetDecodedFormat(format)->GetSize(TextureDimensions)) {
+            std::mt19937 random{};
+            std::generate(input.begin(), input.end(), [&random]() { return static_cast<u8>(random()); });
+        }
+
+        void Decode(size_t iterations) {
+            for (size_t iteration{}; iteration < iterations; iteration++) {
+                bcn::Decode(format, input.data(), output.data(), TextureDimensions);
+                ClobberMemory();
+            }
+        }
+    };
+
+    BENCHMARK(DecodeBc1) {
+        static RandomTexture texture{format::BC1Unorm};
+        texture.Decode(iterations);
+    }
+
+    BENCHMARK(DecodeBc3) {
+        static RandomTexture texture{format::BC3Unorm};
+        texture.Decode(iterations);
+    }
+
+    BENCHMARK(DecodeBc5) {
+        static RandomTexture texture{format::BC5Unorm};
+        texture.Decode(iterations);
+    }
+
+    BENCHMARK(DecodeBc7) {
+        static RandomTexture texture{format::BC7Unorm};
+        texture.Decode(iterations);
+    }
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::benchmark {
+    /**
+     * @brief A single benchmark which is registered by the BENCHMARK macro and run by the benchmark executable
+     * @note The function is supplied the amount of iterations to run, the runner scales this until the duration is significant
+     */
+    struct BenchmarkCase {
+        const char *name;
+        void (*function)(size_t iterations);
+    };
+
+    /**
+     * @return All registered benchmarks in the order of their registration
+     */
+    inline std::vector<BenchmarkCase> &GetBenchmarkCases() {
+        static std::vector<BenchmarkCase> benchmarkCases;
+        return benchmarkCases;
+    }
+
+    struct BenchmarkRegistration {
+        BenchmarkRegistration(const char *name, void (*function)(size_t)) {
+            GetBenchmarkCases().push_back({name, function});
+        }
+    };
+
+    /**
+     * @brief Forces the compiler to materialize a value which is otherwise unused, so the computation of it can't be optimized out
+     */
+    template<typename Type>
+    inline void DoNotOptimize(const Type &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Forces the compiler to assume that all memory has been read and written at this point
+     */
+    inline void ClobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+}
+
+#define BENCHMARK(name) \
+    static void Benchmark##name(size_t iterations); \
+    static ::skyline::benchmark::BenchmarkRegistration BenchmarkRegistration##name{#name, Benchmark##name}; \
+    static void Benchmark##name(size_t iterations)
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cstdio>
+#include <chrono>
+#include "benchmark.h"
+
+/**
+ * @brief Runs all registered benchmarks and prints the time taken per iteration, a filter can be supplied as the first argument to only run benchmarks with it in their name
+ * @note The iteration count of every benchmark is doubled until a single run takes at least MinimumDuration
+ */
+int main(int argc, char **argv) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::chrono::milliseconds MinimumDuration{200};
+    constexpr size_t MaximumIterations{1ULL << 32};
+
+    std::string_view filter{argc > 1 ? argv[1] : ""};
+
+    for (const auto &benchmarkCase : skyline::benchmark::GetBenchmarkCases()) {
+        if (!filter.empty() && std::string_view(benchmarkCase.name).find(filter) == std::string_view::npos)
+            continue;
+
+        benchmarkCase.function(1); // Warm up any caches and lazily initialized state
+
+        size_t iterations{1};
+        Clock::duration duration{};
+        while (true) {
+            auto start{Clock::now()};
+            benchmarkCase.function(iterations);
+            duration = Clock::now() - start;
+
+            if (duration >= MinimumDuration || iterations >= MaximumIterations)
+                break;
+            iterations *= 2;
+        }
+
+        auto nanoseconds{std::chrono::duration<double, std::nano>(duration).count()};
+        std::printf("%-48s %14.1f ns/iteration %12zu iterations\n", benchmarkCase.name, nanoseconds / static_cast<double>(iterations), iterations);
+    }
+
+    return 0;
+}
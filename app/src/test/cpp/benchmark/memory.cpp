@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <kernel/memory.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    using MemoryManager = kernel::MemoryManager;
+
+    /**
+     * @brief A huge page aligned heap-like region which is fully populated, so only the TLB cost of accessing it is measured
+     */
+    template<bool HugePages>
+    struct HeapFixture {
+        static constexpr size_t HeapSize{256 * 1024 * 1024}; //!< Large enough that regular pages can't be covered by the TLB
+
+        u8 *mapping;
+        span<u8> heap;
+
+        HeapFixture() : mapping{static_cast<u8 *>(mmap(nullptr, HeapSize + MemoryManager::HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0))} {
+            if (mapping == MAP_FAILED)
+                throw exception("Cannot map benchmark heap: {}", strerror(errno));
+
+            heap = span(util::AlignUp(mapping, MemoryManager::HugePageSize), HeapSize);
+            if (HugePages)
+                MemoryManager::AdviseHugePages(heap);
+            else
+                madvise(heap.data(), heap.size(), MADV_NOHUGEPAGE); // Hosts with THP set to "always" would otherwise use huge pages regardless
+            std::memset(heap.data(), 1, heap.size());
+        }
+
+        ~HeapFixture() {
+            munmap(mapping, HeapSize + MemoryManager::HugePageSize);
+        }
+    };
+
+    /**
+     * @brief Reads a byte from a pseudo-random page of the heap on every iteration, this is bound by the latency of TLB misses
+     */
+    template<bool HugePages>
+    void ReadHeapScattered(size_t iterations) {
+        static HeapFixture<HugePages> fixture;
+        constexpr size_t PageCount{HeapFixture<HugePages>::HeapSize / PAGE_SIZE};
+
+        // A LCG is used as the page sequence must be unpredictable for the prefetcher, every read feeds into the next address so they can't be overlapped
+        u32 state{1};
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            state = state * 1664525 + 1013904223 + fixture.heap[(state % PageCount) * PAGE_SIZE];
+        DoNotOptimize(state);
+    }
+
+    BENCHMARK(HeapReadScatteredRegularPages) {
+        ReadHeapScattered<false>(iterations);
+    }
+
+    BENCHMARK(HeapReadScatteredHugePages) {
+        ReadHeapScattered<true>(iterations);
+    }
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    /**
+     * @brief A stand-in for KThread with only the state the queue operations touch, KThread can't be constructed without a running guest process
+     */
+    struct QueuedThread {
+        i8 priority;
+
+        QueuedThread(i8 priority) : priority{priority} {}
+    };
+
+    /**
+     * @brief A core's queue of threads with the same locking and queue operations as Scheduler::CoreContext
+     * @tparam ThreadReference The type of a queued thread, this is either a borrowed pointer or a std::shared_ptr as the queues held prior to them being borrowed
+     */
+    template<typename ThreadReference>
+    struct CoreQueueFixture {
+        static constexpr std::array<i8, 8> Priorities{44, 44, 44, 44, 44, 59, 59, 63}; //!< The priorities of queued threads, the first one is the thread which yields and waits
+
+        std::vector<std::shared_ptr<QueuedThread>> threads; //!< All threads are owned here akin to KProcess::threads
+        std::mutex mutex;
+        std::list<ThreadReference> queue;
+
+        CoreQueueFixture() {
+            for (i8 priority : Priorities) {
+                auto &thread{threads.emplace_back(std::make_shared<QueuedThread>(priority))};
+                if constexpr (std::is_pointer_v<ThreadReference>)
+                    queue.push_back(thread.get());
+                else
+                    queue.push_back(thread);
+            }
+        }
+
+        static bool IsHigherPriority(const i8 priority, const ThreadReference &it) {
+            return priority < it->priority;
+        }
+
+        /**
+         * @brief Moves the thread at the front of the queue behind all threads of the same priority, as is done by Scheduler::Rotate
+         */
+        void Rotate(const ThreadReference &thread) {
+            std::unique_lock lock(mutex);
+            if (queue.front() == thread)
+                queue.splice(std::upper_bound(queue.begin(), queue.end(), thread->priority, IsHigherPriority), queue, queue.begin());
+            auto &front{queue.front()};
+            DoNotOptimize(front);
+        }
+
+        /**
+         * @brief Removes the thread from the queue and inserts it back by its priority, as is done by Scheduler::RemoveThread and Scheduler::InsertThread when a wait is signalled
+         */
+        void WaitAndWake(const ThreadReference &thread) {
+            {
+                std::unique_lock lock(mutex);
+                auto it{std::find(queue.begin(), queue.end(), thread)};
+                if (it != queue.end())
+                    queue.erase(it);
+            }
+            {
+                std::unique_lock lock(mutex);
+                queue.insert(std::upper_bound(queue.begin(), queue.end(), thread->priority, IsHigherPriority), thread);
+            }
+        }
+    };
+
+    /**
+     * @brief A guest thread which alternates between yielding and waiting on an object that is signalled immediately, this is how most titles spin on a condition
+     */
+    template<typename ThreadReference>
+    void YieldWaitLoop(size_t iterations) {
+        static CoreQueueFixture<ThreadReference> fixture;
+        ThreadReference thread;
+        if constexpr (std::is_pointer_v<ThreadReference>)
+            thread = fixture.threads.front().get();
+        else
+            thread = fixture.threads.front();
+
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            fixture.Rotate(thread);
+            fixture.WaitAndWake(thread);
+        }
+    }
+
+    BENCHMARK(SchedulerQueueYieldWaitBorrowed) {
+        YieldWaitLoop<QueuedThread *>(iterations);
+    }
+
+    /**
+     * @brief The baseline of the queue holding shared references which requires atomic reference count updates on every insertion and removal
+     */
+    BENCHMARK(SchedulerQueueYieldWaitShared) {
+        YieldWaitLoop<std::shared_ptr<QueuedThread>>(iterations);
+    }
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <barrier>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    /**
+     * @brief A model of the sync waiter table in KProcess which is used by conditional variables and the address arbiter
+     * @note KProcess can't be used directly as waiting requires a running guest process, the bucket layout, hashing and linking are the same as in it
+     */
+    template<size_t BucketCount>
+    struct SyncWaiterTable {
+        struct Waiter {
+            void *address{};
+            Waiter *next{};
+            Waiter *previous{};
+            std::atomic<bool> signalled{};
+        };
+
+        struct alignas(64) Bucket {
+            std::mutex mutex;
+            Waiter *head{};
+            Waiter *tail{};
+        };
+
+        std::array<Bucket, BucketCount> buckets;
+
+        Bucket &GetBucket(void *address) {
+            if constexpr (BucketCount == 1) {
+                return buckets[0];
+            } else {
+                constexpr u8 HashShift{64 - std::countr_zero(BucketCount)};
+                return buckets[(reinterpret_cast<u64>(address) * 0x9E3779B97F4A7C15) >> HashShift];
+            }
+        }
+
+        /**
+         * @brief Inserts the waiter at the tail of the bucket and yields until it has been signalled
+         * @note The wake is a spin rather than a scheduler wake as the cost of the table is what's being measured
+         */
+        void Wait(void *address, Waiter &waiter) {
+            auto &bucket{GetBucket(address)};
+            {
+                std::lock_guard lock(bucket.mutex);
+                waiter.address = address;
+                waiter.previous = bucket.tail;
+                waiter.next = nullptr;
+                (bucket.tail ? bucket.tail->next : bucket.head) = &waiter;
+                bucket.tail = &waiter;
+            }
+
+            while (!waiter.signalled.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            waiter.signalled.store(false, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Removes the first waiter on the address from its bucket and signals it
+         * @return If there was a waiter on the address
+         */
+        bool Signal(void *address) {
+            auto &bucket{GetBucket(address)};
+            std::lock_guard lock(bucket.mutex);
+            for (Waiter *waiter{bucket.head}; waiter; waiter = waiter->next) {
+                if (waiter->address == address) {
+                    (waiter->previous ? waiter->previous->next : bucket.head) = waiter->next;
+                    (waiter->next ? waiter->next->previous : bucket.tail) = waiter->previous;
+                    waiter->signalled.store(true, std::memory_order_release);
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /**
+     * @brief Runs ThreadCount / 2 pairs of threads concurrently, in every pair one thread waits on a distinct key and the other signals it
+     * @note Every iteration is a single wait and signal by all pairs, so the time per iteration only stays flat if the pairs don't contend with each other
+     */
+    template<size_t BucketCount, size_t ThreadCount>
+    void WaitSignalPairs(size_t iterations) {
+        static SyncWaiterTable<BucketCount> table;
+        static std::array<u32, ThreadCount / 2> keys{}; // The addresses of these stand in for the guest addresses of conditional variables
+
+        std::barrier start{ThreadCount};
+        std::vector<std::thread> threads;
+        for (size_t pair{}; pair < ThreadCount / 2; pair++) {
+            void *key{&keys[pair]};
+            threads.emplace_back([&, key] {
+                typename SyncWaiterTable<BucketCount>::Waiter waiter;
+                start.arrive_and_wait();
+                for (size_t iteration{}; iteration < iterations; iteration++)
+                    table.Wait(key, waiter);
+            });
+            threads.emplace_back([&, key] {
+                start.arrive_and_wait();
+                for (size_t iteration{}; iteration < iterations; iteration++)
+                    while (!table.Signal(key))
+                        std::this_thread::yield();
+            });
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    BENCHMARK(SyncWaiterWaitSignal4Threads) {
+        WaitSignalPairs<64, 4>(iterations);
+    }
+
+    BENCHMARK(SyncWaiterWaitSignal8Threads) {
+        WaitSignalPairs<64, 8>(iterations);
+    }
+
+    BENCHMARK(SyncWaiterWaitSignal16Threads) {
+        WaitSignalPairs<64, 16>(iterations);
+    }
+
+    BENCHMARK(SyncWaiterWaitSignal32Threads) {
+        WaitSignalPairs<64, 32>(iterations);
+    }
+
+    /**
+     * @brief The baseline of all waiters sharing a single lock and list, as was the case prior to the sync waiter table being sharded
+     */
+    BENCHMARK(SyncWaiterWaitSignal32ThreadsSingleBucket) {
+        WaitSignalPairs<1, 32>(iterations);
+    }
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <soc/host1x/syncpoint.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    using Syncpoint = soc::host1x::Syncpoint;
+
+    constexpr size_t WaiterCount{4096}; //!< The amount of concurrently registered waiters, this is far more than any title registers but it shows how the cost scales with them
+
+    /**
+     * @brief A syncpoint with WaiterCount waiters on thresholds that won't be reached during the benchmark
+     */
+    struct PendingWaitersFixture {
+        static constexpr u32 FarThreshold{0x7FFFFFFF}; //!< The furthest threshold ahead of the initial value which isn't treated as having been reached
+
+        Syncpoint syncpoint;
+
+        PendingWaitersFixture() {
+            for (u32 index{}; index < WaiterCount; index++)
+                syncpoint.RegisterWaiter(FarThreshold - index, [] {});
+        }
+    };
+
+    BENCHMARK(SyncpointIncrementWithPendingWaiters) {
+        static PendingWaitersFixture fixture;
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            DoNotOptimize(fixture.syncpoint.Increment());
+    }
+
+    BENCHMARK(SyncpointRegisterDeregisterWithPendingWaiters) {
+        static PendingWaitersFixture fixture;
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            auto handle{fixture.syncpoint.RegisterWaiter(fixture.syncpoint.Load() + static_cast<u32>(iteration % WaiterCount) + 1, [] {})};
+            fixture.syncpoint.DeregisterWaiter(handle);
+        }
+    }
+
+    /**
+     * @brief Registers WaiterCount waiters on the next value and dispatches all of them with a single increment on every iteration
+     */
+    BENCHMARK(SyncpointDispatchManyWaiters) {
+        static Syncpoint syncpoint;
+        size_t calls{};
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            u32 threshold{syncpoint.Load() + 1};
+            for (size_t index{}; index < WaiterCount; index++)
+                syncpoint.RegisterWaiter(threshold, [&calls] { calls++; });
+            syncpoint.Increment();
+        }
+        DoNotOptimize(calls);
+    }
+
+    /**
+     * @brief The latency of a thread blocked in Wait being woken by an increment from another thread, this is done with WaiterCount other waiters pending
+     * @note The woken thread signals back on a second syncpoint, so every iteration is a full round trip of two wakes
+     */
+    BENCHMARK(SyncpointWaitWakeRoundTrip) {
+        static PendingWaitersFixture fixture;
+        static Syncpoint reply;
+        auto &request{fixture.syncpoint};
+
+        u32 requestStart{request.Load()}, replyStart{reply.Load()};
+        std::thread waiter{[&] {
+            for (u32 iteration{1}; iteration <= iterations; iteration++) {
+                request.Wait(requestStart + iteration, std::chrono::steady_clock::duration::max());
+                reply.Increment();
+            }
+        }};
+
+        for (u32 iteration{1}; iteration <= iterations; iteration++) {
+            request.Increment();
+            reply.Wait(replyStart + iteration, std::chrono::steady_clock::duration::max());
+        }
+        waiter.join();
+    }
+}
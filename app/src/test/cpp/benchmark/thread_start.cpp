@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <condition_variable>
+#include <kernel/types/KThread.h>
+#include "benchmark.h"
+
+namespace skyline::benchmark {
+    /**
+     * @brief The latency of starting a guest thread on a newly created host thread, as was done prior to the HostThreadPool
+     */
+    BENCHMARK(ThreadStartCreateHostThread) {
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            std::thread thread{[]() {
+                pthread_setname_np(pthread_self(), "HOS-0");
+                kernel::type::KThread::InstallSignalHandlers();
+            }};
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief A single worker which has its signal handlers installed upfront and waits for work akin to the workers of the HostThreadPool
+     */
+    struct PooledWorker {
+        std::mutex mutex;
+        std::condition_variable condition;
+        u64 requested{}; //!< The amount of starts that have been requested
+        u64 completed{}; //!< The amount of starts that the worker has handled
+        bool stop{};
+        std::thread thread;
+
+        PooledWorker() : thread{&PooledWorker::Run, this} {}
+
+        ~PooledWorker() {
+            {
+                std::lock_guard lock(mutex);
+                stop = true;
+            }
+            condition.notify_all();
+            thread.join();
+        }
+
+        void Run() {
+            kernel::type::KThread::InstallSignalHandlers();
+
+            std::unique_lock lock(mutex);
+            while (true) {
+                condition.wait(lock, [this] { return stop || requested != completed; });
+                if (stop)
+                    return;
+                completed = requested;
+                condition.notify_all();
+            }
+        }
+
+        /**
+         * @brief Hands off a start to the worker and waits for it to be picked up
+         */
+        void Start() {
+            std::unique_lock lock(mutex);
+            requested++;
+            condition.notify_all();
+            condition.wait(lock, [this] { return requested == completed; });
+        }
+    };
+
+    /**
+     * @brief The latency of starting a guest thread on an idle worker of the HostThreadPool, this is only the handoff as the worker is already initialized
+     */
+    BENCHMARK(ThreadStartPooledWorker) {
+        static PooledWorker worker;
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            worker.Start();
+    }
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <gpu/texture/block_linear.h>
+#include <soc/gm20b/gmmu.h>
+#include "test.h"
+
+namespace skyline::test {
+    using gpu::BlockLinearLayout;
+
+    /**
+     * @brief A surface with a width that isn't GOB-aligned, a height that isn't block-aligned and multiple blocks along every axis
+     */
+    constexpr BlockLinearLayout TestLayout{
+        .widthBytes = 200,
+        .height = 40,
+        .depth = 3,
+        .blockHeight = 2,
+        .blockDepth = 2,
+    };
+
+    /**
+     * @return The offset of a byte in a block-linear surface, this is a naive per-byte implementation of the GOB swizzle to check the copies against
+     */
+    static size_t ReferenceOffset(const BlockLinearLayout &layout, u32 x, u32 y, u32 z) {
+        size_t widthGobs{(layout.widthBytes + 63) / 64};
+        size_t heightBlocks{(layout.height + (8 * layout.blockHeight) - 1) / (8 * layout.blockHeight)};
+        size_t blockBytes{512ULL * layout.blockHeight * layout.blockDepth};
+
+        size_t block{((z / layout.blockDepth) * heightBlocks + (y / (8 * layout.blockHeight))) * widthGobs + (x / 64)};
+        size_t gob{(z % layout.blockDepth) * layout.blockHeight + ((y / 8) % layout.blockHeight)};
+        size_t withinGob{((x % 64) / 32) * 256 + ((y % 8) / 2) * 64 + ((x % 32) / 16) * 32 + (y % 2) * 16 + (x % 16)};
+        return block * blockBytes + gob * 512 + withinGob;
+    }
+
+    static std::vector<u8> GetRandomData(size_t size, u32 seed) {
+        std::vector<u8> data(size);
+        std::mt19937 random{seed};
+        std::generate(data.begin(), data.end(), [&random]() { return static_cast<u8>(random()); });
+        return data;
+    }
+
+    TEST(BlockLinearLayoutMatchesReference) {
+        EXPECT(TestLayout.GetSize() == 4 * 3 * 2 * (512 * 2 * 2));
+
+        for (u32 z{}; z < TestLayout.depth; z++)
+            for (u32 y{}; y < TestLayout.height; y++)
+                for (u32 x{}; x < TestLayout.widthBytes; x++)
+                    EXPECT(TestLayout.GetSectorOffset(x, y, z) + (x % BlockLinearLayout::SectorWidth) == ReferenceOffset(TestLayout, x, y, z));
+    }
+
+    TEST(BlockLinearSpansCoverLine) {
+        for (u32 originX : {0U, 5U, 16U, 63U, 70U}) {
+            u32 lineBytes{TestLayout.widthBytes - originX};
+            u32 expectedLineOffset{};
+            gpu::ForEachBlockLinearSpan(TestLayout, originX, 9, 1, lineBytes, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                // Spans are in order, don't overlap and never cross a sector boundary
+                EXPECT(lineOffset == expectedLineOffset);
+                EXPECT(size > 0 && size <= BlockLinearLayout::SectorWidth);
+                EXPECT(surfaceOffset / BlockLinearLayout::SectorWidth == (surfaceOffset + size - 1) / BlockLinearLayout::SectorWidth);
+                EXPECT(surfaceOffset == ReferenceOffset(TestLayout, originX + lineOffset, 9, 1));
+                expectedLineOffset += size;
+            });
+            EXPECT(expectedLineOffset == lineBytes);
+        }
+    }
+
+    TEST(BlockLinearToPitchCopy) {
+        constexpr u32 OriginX{24}, OriginY{5}, Layer{1}, LineBytes{100}, LineCount{20}, Pitch{128};
+        constexpr u8 Padding{0xEE};
+
+        auto surface{GetRandomData(TestLayout.GetSize(), 1)};
+        std::vector<u8> pitch(Pitch * LineCount, Padding);
+        gpu::CopyBlockLinearRegion<true>(TestLayout, surface.data(), OriginX, OriginY, Layer, pitch.data(), Pitch, LineBytes, LineCount);
+
+        for (u32 line{}; line < LineCount; line++) {
+            for (u32 x{}; x < LineBytes; x++)
+                EXPECT(pitch[line * Pitch + x] == surface[ReferenceOffset(TestLayout, OriginX + x, OriginY + line, Layer)]);
+            for (u32 x{LineBytes}; x < Pitch; x++)
+                EXPECT(pitch[line * Pitch + x] == Padding);
+        }
+    }
+
+    TEST(PitchToBlockLinearCopy) {
+        constexpr u32 OriginX{37}, OriginY{11}, Layer{2}, LineBytes{90}, LineCount{17}, Pitch{96};
+        constexpr u8 Untouched{0xEE};
+
+        auto pitch{GetRandomData(Pitch * LineCount, 2)};
+        std::vector<u8> surface(TestLayout.GetSize(), Untouched);
+        gpu::CopyBlockLinearRegion<false>(TestLayout, surface.data(), OriginX, OriginY, Layer, pitch.data(), Pitch, LineBytes, LineCount);
+
+        std::vector<bool> written(surface.size());
+        for (u32 line{}; line < LineCount; line++) {
+            for (u32 x{}; x < LineBytes; x++) {
+                size_t offset{ReferenceOffset(TestLayout, OriginX + x, OriginY + line, Layer)};
+                EXPECT(surface[offset] == pitch[line * Pitch + x]);
+                written[offset] = true;
+            }
+        }
+
+        // Bytes outside the copy region must be preserved
+        for (size_t offset{}; offset < surface.size(); offset++)
+            if (!written[offset])
+                EXPECT(surface[offset] == Untouched);
+    }
+
+    TEST(BlockLinearCopyRoundTrip) {
+        constexpr u32 LineBytes{TestLayout.widthBytes}, LineCount{TestLayout.height};
+
+        auto input{GetRandomData(LineBytes * LineCount, 3)};
+        std::vector<u8> surface(TestLayout.GetSize()), output(input.size());
+        gpu::CopyBlockLinearRegion<false>(TestLayout, surface.data(), 0, 0, 0, input.data(), LineBytes, LineBytes, LineCount);
+        gpu::CopyBlockLinearRegion<true>(TestLayout, surface.data(), 0, 0, 0, output.data(), LineBytes, LineBytes, LineCount);
+
+        EXPECT(input == output);
+    }
+
+    TEST(BlockLinearSpansThroughSplitMappings) {
+        // Inline transfers supply tightly packed lines which are written sector by sector through the GMMU when the surface isn't contiguous in host memory
+        constexpr u32 OriginX{8}, OriginY{3}, Layer{1}, LineBytes{150}, LineCount{30};
+        constexpr u64 SurfaceAddress{0x100000};
+        constexpr u8 Untouched{0xEE};
+
+        size_t surfaceSize{TestLayout.GetSize()}, firstSize{util::AlignDown(surfaceSize / 2, PAGE_SIZE)};
+        std::vector<u8> first(firstSize, Untouched), second(surfaceSize - firstSize, Untouched);
+        soc::gm20b::GMMU gmmu;
+        gmmu.Map(SurfaceAddress, first.data(), first.size());
+        gmmu.Map(SurfaceAddress + first.size(), second.data(), second.size());
+        EXPECT(gmmu.TranslateContiguous(SurfaceAddress, surfaceSize) == nullptr);
+
+        auto data{GetRandomData(LineBytes * LineCount, 4)};
+        for (u32 line{}; line < LineCount; line++) {
+            u8 *lineData{data.data() + static_cast<size_t>(line) * LineBytes};
+            gpu::ForEachBlockLinearSpan(TestLayout, OriginX, OriginY + line, Layer, LineBytes, [&](size_t surfaceOffset, u32 lineOffset, u32 size) {
+                gmmu.Write(SurfaceAddress + surfaceOffset, lineData + lineOffset, size);
+            });
+        }
+
+        std::vector<u8> expected(surfaceSize, Untouched), actual(first);
+        actual.insert(actual.end(), second.begin(), second.end());
+        gpu::CopyBlockLinearRegion<false>(TestLayout, expected.data(), OriginX, OriginY, Layer, data.data(), LineBytes, LineBytes, LineCount);
+        EXPECT(actual == expected);
+    }
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cstdio>
+#include "test.h"
+
+/**
+ * @brief Runs all registered tests, a filter can be supplied as the first argument to only run tests with it in their name
+ * @return The amount of failed tests
+ */
+int main(int argc, char **argv) {
+    std::string_view filter{argc > 1 ? argv[1] : ""};
+
+    int failures{};
+    for (const auto &testCase : skyline::test::GetTestCases()) {
+        if (!filter.empty() && std::string_view(testCase.name).find(filter) == std::string_view::npos)
+            continue;
+
+        try {
+            testCase.function();
+            std::printf("[PASS] %s\n", testCase.name);
+        } catch (const std::exception &e) {
+            std::printf("[FAIL] %s: %s\n", testCase.name, e.what());
+            failures++;
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <fstream>
+#include <kernel/memory.h>
+#include "test.h"
+
+namespace skyline::test {
+    using namespace kernel;
+
+    /**
+     * @brief A private anonymous mapping akin to the guest address space carveout, it's unmapped on destruction
+     */
+    struct AnonymousMapping {
+        span<u8> memory;
+
+        AnonymousMapping(size_t size) {
+            auto ptr{mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+            if (ptr == MAP_FAILED)
+                throw exception("Cannot map memory test memory: {}", strerror(errno));
+            memory = span(static_cast<u8 *>(ptr), size);
+        }
+
+        ~AnonymousMapping() {
+            munmap(memory.data(), memory.size());
+        }
+    };
+
+    /**
+     * @return If transparent huge pages can be used by mappings advised with MADV_HUGEPAGE on the host
+     */
+    static bool IsHugePageSupported() {
+        std::ifstream file{"/sys/kernel/mm/transparent_hugepage/enabled"};
+        std::string modes;
+        return std::getline(file, modes) && modes.find("[never]") == std::string::npos;
+    }
+
+    /**
+     * @return The value of the supplied field in bytes from the entry in /proc/self/smaps for the mapping containing the supplied address
+     */
+    static size_t GetSmapsField(const void *address, std::string_view field) {
+        std::ifstream smaps{"/proc/self/smaps"};
+        bool inMapping{};
+        for (std::string line; std::getline(smaps, line);) {
+            uintptr_t start, end;
+            if (std::sscanf(line.c_str(), "%lx-%lx ", &start, &end) == 2 && line.find(':') > line.find(' ')) {
+                inMapping = start <= reinterpret_cast<uintptr_t>(address) && reinterpret_cast<uintptr_t>(address) < end;
+            } else if (inMapping && line.starts_with(field) && line[field.size()] == ':') {
+                return std::stoul(line.substr(field.size() + 1)) * 1024; // All sizes are in KiB
+            }
+        }
+        throw exception("Cannot find {} in smaps for 0x{:X}", field, address);
+    }
+
+    /**
+     * @brief An anonymous mapping with a huge page aligned region of the supplied size inside it
+     */
+    struct HugePageMapping : AnonymousMapping {
+        span<u8> region;
+
+        HugePageMapping(size_t size) : AnonymousMapping{size + MemoryManager::HugePageSize} {
+            region = span(util::AlignUp(memory.data(), MemoryManager::HugePageSize), size);
+        }
+    };
+
+    TEST(ResidentSizeTracksTouchedPages) {
+        constexpr size_t PageCount{32};
+        AnonymousMapping mapping{PageCount * PAGE_SIZE};
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory) == 0);
+
+        for (size_t page{}; page < PageCount; page += 2)
+            mapping.memory[page * PAGE_SIZE] = 1;
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory) == (PageCount / 2) * PAGE_SIZE);
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory.subspan(0, PAGE_SIZE)) == PAGE_SIZE);
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory.subspan(PAGE_SIZE, PAGE_SIZE)) == 0);
+    }
+
+    TEST(ResidentSizeAcrossBatches) {
+        constexpr size_t PageCount{0x1000 + 0x10}; // Larger than a single batch of mincore
+        AnonymousMapping mapping{PageCount * PAGE_SIZE};
+        std::memset(mapping.memory.data(), 0xAB, mapping.memory.size());
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory) == PageCount * PAGE_SIZE);
+    }
+
+    TEST(FreeMemoryReleasesPages) {
+        constexpr size_t PageCount{16};
+        AnonymousMapping mapping{PageCount * PAGE_SIZE};
+        std::memset(mapping.memory.data(), 0xAB, mapping.memory.size());
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory) == PageCount * PAGE_SIZE);
+
+        // Only the pages in the supplied range should be released, the surrounding ones must retain their contents
+        auto freed{mapping.memory.subspan(4 * PAGE_SIZE, 8 * PAGE_SIZE)};
+        MemoryManager::FreeMemory(freed);
+        EXPECT(MemoryManager::GetResidentSize(freed) == 0);
+        EXPECT(MemoryManager::GetResidentSize(mapping.memory) == (PageCount - 8) * PAGE_SIZE);
+        EXPECT(mapping.memory[4 * PAGE_SIZE - 1] == 0xAB);
+        EXPECT(mapping.memory[12 * PAGE_SIZE] == 0xAB);
+
+        // The released pages are zero-filled on their next access as HOS guarantees for newly mapped memory
+        EXPECT(std::all_of(freed.begin(), freed.end(), [](u8 value) { return value == 0; }));
+
+        MemoryManager::FreeMemory(span<u8>{}); // An empty range is a no-op
+    }
+
+    TEST(HugePagesBackAdvisedMemory) {
+        if (!IsHugePageSupported())
+            return; // There's nothing to verify if the host kernel can't use THP
+
+        HugePageMapping mapping{4 * MemoryManager::HugePageSize};
+        EXPECT(MemoryManager::AdviseHugePages(mapping.region));
+        std::memset(mapping.region.data(), 0xAB, mapping.region.size());
+
+        EXPECT(GetSmapsField(mapping.region.data(), "AnonHugePages") > 0);
+        EXPECT(MemoryManager::GetResidentSize(mapping.region) == mapping.region.size());
+    }
+
+    TEST(ReleasedTailOfHugePagesIsNotResident) {
+        if (!IsHugePageSupported())
+            return;
+
+        // This mirrors KPrivateMemory::Resize shrinking a heap by an amount which isn't a multiple of the huge page size
+        HugePageMapping mapping{4 * MemoryManager::HugePageSize};
+        EXPECT(MemoryManager::AdviseHugePages(mapping.region));
+        std::memset(mapping.region.data(), 0xAB, mapping.region.size());
+        EXPECT(GetSmapsField(mapping.region.data(), "AnonHugePages") == mapping.region.size());
+
+        auto tail{mapping.region.last(MemoryManager::HugePageSize + MemoryManager::HugePageSize / 2)};
+        EXPECT(mprotect(tail.data(), tail.size(), PROT_NONE) == 0);
+        MemoryManager::FreeMemory(tail);
+
+        // Only the huge page straddling the split is broken up, the whole huge pages before it must remain intact
+        EXPECT(GetSmapsField(tail.data(), "Rss") == 0);
+        EXPECT(GetSmapsField(mapping.region.data(), "AnonHugePages") >= 2 * MemoryManager::HugePageSize);
+        EXPECT(MemoryManager::GetResidentSize(mapping.region) == mapping.region.size() - tail.size());
+    }
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <fstream>
+#include <soc/gm20b/gpfifo.h>
+#include <soc/gm20b/pushbuffer_capture.h>
+#include "test.h"
+
+namespace skyline::test {
+    using soc::gm20b::GpEntry;
+    using soc::gm20b::PushBufferCapture;
+    using soc::gm20b::PushBufferCaptureReader;
+
+    /**
+     * @brief Writes a capture of two channels on two address spaces with every type of record
+     */
+    static void WriteCapture(const std::string &path, const std::vector<u32> &pushBuffer) {
+        PushBufferCapture capture{path};
+        u32 firstAs{capture.CreateAddressSpace()}, secondAs{capture.CreateAddressSpace()};
+        capture.RecordMap(firstAs, 0x100000, 0x20000, false);
+        capture.RecordMap(secondAs, 0x200000, 0x10000, true);
+
+        u32 firstChannel{capture.CreateChannel(firstAs)}, secondChannel{capture.CreateChannel(secondAs)};
+        capture.RecordGpEntry(firstChannel, GpEntry{0x100000, static_cast<u32>(pushBuffer.size())}, pushBuffer);
+        capture.RecordGpEntry(secondChannel, GpEntry{0, 0}, {});
+        capture.RecordSyncpointIncrement(firstChannel, 5, 100);
+        capture.RecordUnmap(firstAs, 0x100000, 0x20000);
+    }
+
+    static std::vector<u8> ReadFile(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    static void WriteFile(const std::string &path, const std::vector<u8> &contents) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    }
+
+    TEST(PushBufferCaptureRoundTrip) {
+        auto path{GetTemporaryPath("skyline_test_capture.skpb")};
+        std::vector<u32> pushBuffer{0x20018000, 0xDEADBEEF, 0x80000001};
+        WriteCapture(path, pushBuffer);
+
+        PushBufferCaptureReader reader{path};
+        std::remove(path.c_str());
+        EXPECT(reader.records.size() == 8);
+
+        // IDs are assigned in order of creation regardless of the type of the object
+        auto &firstMap{std::get<PushBufferCapture::MapRecord>(reader.records[0])};
+        EXPECT(firstMap.addressSpace == 0 && firstMap.virtualAddress == 0x100000 && firstMap.size == 0x20000 && !firstMap.sparse);
+        auto &secondMap{std::get<PushBufferCapture::MapRecord>(reader.records[1])};
+        EXPECT(secondMap.addressSpace == 1 && secondMap.virtualAddress == 0x200000 && secondMap.size == 0x10000 && secondMap.sparse);
+
+        auto &firstChannel{std::get<PushBufferCapture::ChannelRecord>(reader.records[2])};
+        EXPECT(firstChannel.channel == 2 && firstChannel.addressSpace == 0);
+        auto &secondChannel{std::get<PushBufferCapture::ChannelRecord>(reader.records[3])};
+        EXPECT(secondChannel.channel == 3 && secondChannel.addressSpace == 1);
+
+        auto &entry{std::get<PushBufferCaptureReader::GpEntryData>(reader.records[4])};
+        EXPECT(entry.record.channel == 2);
+        EXPECT(util::BitCast<GpEntry>(entry.record.entry).Address() == 0x100000);
+        EXPECT(entry.pushBuffer == pushBuffer);
+
+        auto &control{std::get<PushBufferCaptureReader::GpEntryData>(reader.records[5])};
+        EXPECT(control.record.channel == 3 && control.pushBuffer.empty());
+
+        auto &increment{std::get<PushBufferCapture::SyncpointIncrementRecord>(reader.records[6])};
+        EXPECT(increment.channel == 2 && increment.id == 5 && increment.value == 100);
+
+        auto &unmap{std::get<PushBufferCapture::UnmapRecord>(reader.records[7])};
+        EXPECT(unmap.addressSpace == 0 && unmap.virtualAddress == 0x100000 && unmap.size == 0x20000);
+    }
+
+    TEST(PushBufferCaptureReaderRejectsMalformed) {
+        auto path{GetTemporaryPath("skyline_test_capture.skpb")};
+        WriteCapture(path, {0x20018000, 0xDEADBEEF});
+        auto original{ReadFile(path)};
+
+        auto rejects{[&](const std::vector<u8> &contents) {
+            WriteFile(path, contents);
+            try {
+                PushBufferCaptureReader reader{path};
+            } catch (const std::exception &) {
+                return true;
+            }
+            return false;
+        }};
+
+        EXPECT(!rejects(original));
+
+        auto badMagic{original};
+        badMagic[0] ^= 0xFF;
+        EXPECT(rejects(badMagic));
+
+        auto truncated{original};
+        truncated.pop_back();
+        EXPECT(rejects(truncated));
+
+        // The first record is a map, changing its type to an unknown one or its size to a mismatching one must be detected
+        constexpr size_t FirstRecord{sizeof(PushBufferCapture::FileHeader)};
+        auto unknownType{original};
+        reinterpret_cast<PushBufferCapture::RecordHeader *>(unknownType.data() + FirstRecord)->type = static_cast<PushBufferCapture::RecordType>(0xFF);
+        EXPECT(rejects(unknownType));
+
+        auto wrongSize{original};
+        reinterpret_cast<PushBufferCapture::RecordHeader *>(wrongSize.data() + FirstRecord)->size -= sizeof(u32);
+        EXPECT(rejects(wrongSize));
+
+        // A GpEntry referencing a channel which was never created
+        {
+            PushBufferCapture capture{path};
+            capture.RecordGpEntry(7, GpEntry{0, 0}, {});
+        }
+        EXPECT(rejects(ReadFile(path)));
+
+        std::remove(path.c_str());
+    }
+}
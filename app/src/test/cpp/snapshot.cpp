@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <fstream>
+#include <random>
+#include <sys/mman.h>
+#include <kernel/snapshot.h>
+#include "test.h"
+
+namespace skyline::test {
+    using namespace kernel;
+
+    /**
+     * @brief A guest-like memory layout of a readable chunk with a compressible, an untouched, an incompressible and a zero-filled page followed by a chunk without read permission
+     */
+    struct SnapshotLayout {
+        static constexpr size_t PageCount{5};
+
+        u8 *region;
+        std::array<ChunkDescriptor, 2> chunks;
+        snapshot::ThreadRecord thread{};
+        std::array<snapshot::HandleRecord, 2> handles{snapshot::HandleRecord{0xD000, 1}, snapshot::HandleRecord{0xD001, 3}};
+
+        SnapshotLayout() : region{static_cast<u8 *>(mmap(nullptr, PageCount * PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0))} {
+            if (region == MAP_FAILED)
+                throw exception("Cannot map snapshot test memory: {}", strerror(errno));
+
+            std::memset(region, 0xAB, PAGE_SIZE);
+            std::mt19937 random{PageCount};
+            std::generate(region + 2 * PAGE_SIZE, region + 3 * PAGE_SIZE, [&random]() { return static_cast<u8>(random()); });
+            std::memset(region + 3 * PAGE_SIZE, 0, PAGE_SIZE);
+            std::memset(region + 4 * PAGE_SIZE, 0xCD, PAGE_SIZE);
+
+            chunks = {
+                ChunkDescriptor{.ptr = region, .size = 4 * PAGE_SIZE, .permission = {true, true, false}, .state = memory::states::Heap},
+                ChunkDescriptor{.ptr = region + 4 * PAGE_SIZE, .size = PAGE_SIZE, .permission = {false, false, false}, .state = memory::states::Heap},
+            };
+
+            thread.id = 1;
+            thread.handle = 0xD000;
+            thread.priority = 44;
+            thread.coreId = 3;
+            thread.tpidrroEl0 = reinterpret_cast<u64>(region);
+        }
+
+        ~SnapshotLayout() {
+            munmap(region, PageCount * PAGE_SIZE);
+        }
+
+        snapshot::Header Encode(SnapshotEncoder &encoder, const std::string &path) {
+            return encoder.Encode(path, chunks, span(&thread, 1), handles);
+        }
+    };
+
+    TEST(SnapshotRoundTrip) {
+        SnapshotLayout layout;
+        SnapshotEncoder encoder;
+        auto path{GetTemporaryPath("skyline_test_snapshot-0.sksnap")};
+        auto header{layout.Encode(encoder, path)};
+
+        SnapshotReader reader(path);
+        std::remove(path.c_str());
+        EXPECT(std::memcmp(&reader.header, &header, sizeof(snapshot::Header)) == 0);
+        EXPECT(reader.header.index == 0 && reader.header.pageSize == PAGE_SIZE);
+
+        EXPECT(reader.chunks.size() == layout.chunks.size());
+        for (size_t index{}; index < layout.chunks.size(); index++) {
+            auto &chunk{reader.chunks[index]};
+            EXPECT(chunk.address == reinterpret_cast<u64>(layout.chunks[index].ptr) && chunk.size == layout.chunks[index].size);
+            EXPECT(chunk.permission == layout.chunks[index].permission.raw && chunk.state == layout.chunks[index].state.value);
+        }
+
+        EXPECT(reader.threads.size() == 1 && std::memcmp(&reader.threads[0], &layout.thread, sizeof(snapshot::ThreadRecord)) == 0);
+        EXPECT(reader.handles.size() == layout.handles.size() && std::memcmp(reader.handles.data(), layout.handles.data(), sizeof(layout.handles)) == 0);
+
+        // Only the compressible and incompressible pages have non-zero contents, the unreadable chunk must not be written
+        EXPECT(reader.pages.size() == 2);
+        EXPECT(reader.pages[0].address == reinterpret_cast<u64>(layout.region) && std::memcmp(reader.pages[0].contents.data(), layout.region, PAGE_SIZE) == 0);
+        EXPECT(reader.pages[1].address == reinterpret_cast<u64>(layout.region + 2 * PAGE_SIZE) && std::memcmp(reader.pages[1].contents.data(), layout.region + 2 * PAGE_SIZE, PAGE_SIZE) == 0);
+    }
+
+    TEST(SnapshotIncremental) {
+        SnapshotLayout layout;
+        SnapshotEncoder encoder;
+        auto firstPath{GetTemporaryPath("skyline_test_snapshot-0.sksnap")}, secondPath{GetTemporaryPath("skyline_test_snapshot-1.sksnap")};
+        layout.Encode(encoder, firstPath);
+        std::remove(firstPath.c_str());
+
+        // The first page is freed and the previously untouched page is written to, the incompressible page is unchanged
+        EXPECT(madvise(layout.region, PAGE_SIZE, MADV_DONTNEED) == 0);
+        layout.region[PAGE_SIZE + 0x10] = 0x55;
+        layout.Encode(encoder, secondPath);
+
+        SnapshotReader reader(secondPath);
+        std::remove(secondPath.c_str());
+        EXPECT(reader.header.index == 1 && reader.pages.size() == 2);
+        EXPECT(reader.pages[0].address == reinterpret_cast<u64>(layout.region));
+        EXPECT(std::all_of(reader.pages[0].contents.begin(), reader.pages[0].contents.end(), [](u8 value) { return value == 0; }));
+        EXPECT(reader.pages[1].address == reinterpret_cast<u64>(layout.region + PAGE_SIZE) && std::memcmp(reader.pages[1].contents.data(), layout.region + PAGE_SIZE, PAGE_SIZE) == 0);
+    }
+
+    TEST(SnapshotRestore) {
+        SnapshotLayout layout;
+        SnapshotEncoder encoder;
+        std::array<std::string, 3> paths{GetTemporaryPath("skyline_test_snapshot-0.sksnap"), GetTemporaryPath("skyline_test_snapshot-1.sksnap"), GetTemporaryPath("skyline_test_snapshot-2.sksnap")};
+        std::array<std::vector<u8>, 3> expected; //!< The expected guest memory at every snapshot, the chunk without read permission is always zero
+
+        auto snapshot{[&](size_t index) {
+            layout.Encode(encoder, paths[index]);
+            expected[index].assign(SnapshotLayout::PageCount * PAGE_SIZE, 0);
+            for (const auto &chunk : layout.chunks)
+                if (chunk.permission.r)
+                    std::memcpy(expected[index].data() + (chunk.ptr - layout.region), chunk.ptr, chunk.size);
+        }};
+
+        snapshot(0);
+
+        // The compressible page is overwritten, the previously untouched page is written to and the incompressible page is freed
+        std::memset(layout.region, 0x11, PAGE_SIZE);
+        layout.region[PAGE_SIZE + 0x10] = 0x55;
+        EXPECT(madvise(layout.region + 2 * PAGE_SIZE, PAGE_SIZE, MADV_DONTNEED) == 0);
+        snapshot(1);
+
+        // The second half of the readable chunk loses its read permission, it must be zeroed on restoring
+        layout.chunks[0].size = 2 * PAGE_SIZE;
+        layout.chunks[1] = ChunkDescriptor{.ptr = layout.region + 2 * PAGE_SIZE, .size = 3 * PAGE_SIZE, .permission = {false, false, false}, .state = memory::states::Heap};
+        snapshot(2);
+
+        // Memory is restored into a separate buffer filled with garbage to ensure every byte is written, it's addressed by the guest addresses in the snapshots
+        std::vector<u8> restored(SnapshotLayout::PageCount * PAGE_SIZE);
+        for (size_t count{1}; count <= paths.size(); count++) {
+            std::fill(restored.begin(), restored.end(), 0xEE);
+            SnapshotReader::Restore(span(paths.data(), count), restored, reinterpret_cast<u64>(layout.region));
+            EXPECT(restored == expected[count - 1]);
+        }
+
+        // Snapshots must be restored from the first one onwards as later ones only contain changed pages
+        bool rejected{};
+        try {
+            SnapshotReader::Restore(span(paths.data() + 1, 1), restored, reinterpret_cast<u64>(layout.region));
+        } catch (const std::exception &) {
+            rejected = true;
+        }
+        EXPECT(rejected);
+
+        for (const auto &path : paths)
+            std::remove(path.c_str());
+    }
+
+    TEST(SnapshotReaderRejectsMalformed) {
+        SnapshotLayout layout;
+        SnapshotEncoder encoder;
+        auto path{GetTemporaryPath("skyline_test_snapshot-0.sksnap")};
+        layout.Encode(encoder, path);
+
+        std::vector<u8> original;
+        {
+            std::ifstream file(path, std::ios::binary);
+            original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        auto rejects{[&](const std::vector<u8> &contents) {
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+            }
+
+            try {
+                SnapshotReader reader(path);
+            } catch (const std::exception &) {
+                return true;
+            }
+            return false;
+        }};
+
+        EXPECT(!rejects(original));
+
+        auto badMagic{original};
+        badMagic[0] ^= 0xFF;
+        EXPECT(rejects(badMagic));
+
+        auto truncated{original};
+        truncated.pop_back();
+        EXPECT(rejects(truncated));
+
+        auto trailing{original};
+        trailing.push_back(0);
+        EXPECT(rejects(trailing));
+
+        auto hugeCount{original};
+        reinterpret_cast<snapshot::Header *>(hugeCount.data())->chunkCount = std::numeric_limits<u64>::max();
+        EXPECT(rejects(hugeCount));
+
+        size_t firstPage{sizeof(snapshot::Header) + layout.chunks.size() * sizeof(snapshot::ChunkRecord) + sizeof(snapshot::ThreadRecord) + layout.handles.size() * sizeof(snapshot::HandleRecord)};
+        auto oversizedPage{original};
+        reinterpret_cast<snapshot::PageRecord *>(oversizedPage.data() + firstPage)->compressedSize = PAGE_SIZE + 1;
+        EXPECT(rejects(oversizedPage));
+
+        auto pageOutsideChunk{original};
+        reinterpret_cast<snapshot::PageRecord *>(pageOutsideChunk.data() + firstPage)->address = reinterpret_cast<u64>(layout.region + 4 * PAGE_SIZE);
+        EXPECT(rejects(pageOutsideChunk));
+
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <gpu/interconnect/surface_accessor.h>
+#include "test.h"
+
+namespace skyline::test {
+    using gpu::BlockLinearLayout;
+    using gpu::interconnect::SurfaceAccessor;
+
+    constexpr u64 SurfaceAddress{0x100000};
+    constexpr BlockLinearLayout SurfaceLayout{
+        .widthBytes = 256,
+        .height = 64,
+        .depth = 2,
+        .blockHeight = 4,
+        .blockDepth = 1,
+    };
+    constexpr u32 SurfacePitch{320};
+    constexpr u32 SurfaceHeight{64};
+
+    /**
+     * @brief A surface which is backed by a single contiguous host allocation and by two separate ones in two GMMUs, this allows comparing the contiguous and GMMU paths
+     */
+    struct SplitSurface {
+        std::vector<u8> contiguous, first, second;
+        soc::gm20b::GMMU contiguousGmmu, splitGmmu;
+
+        SplitSurface(size_t size) : contiguous(size), first(util::AlignDown(size / 2, PAGE_SIZE)), second(size - first.size()) {
+            contiguousGmmu.Map(SurfaceAddress, contiguous.data(), contiguous.size());
+            splitGmmu.Map(SurfaceAddress, first.data(), first.size());
+            splitGmmu.Map(SurfaceAddress + first.size(), second.data(), second.size());
+        }
+
+        SurfaceAccessor GetAccessor(soc::gm20b::GMMU &gmmu, bool blockLinear, u32 layer) {
+            return SurfaceAccessor{
+                .base = gmmu.TranslateContiguous(SurfaceAddress, contiguous.size()),
+                .gmmu = gmmu,
+                .address = SurfaceAddress,
+                .blockLinear = blockLinear,
+                .layout = SurfaceLayout,
+                .pitch = SurfacePitch,
+                .layer = layer,
+            };
+        }
+
+        std::vector<u8> GetSplitContents() const {
+            std::vector<u8> contents(first);
+            contents.insert(contents.end(), second.begin(), second.end());
+            return contents;
+        }
+    };
+
+    /**
+     * @brief Writes random lines at an unaligned offset through both paths and checks that they produce identical surfaces and read back the same lines
+     */
+    static void CheckAccessorPaths(size_t surfaceSize, bool blockLinear, u32 layer) {
+        constexpr u32 XBytes{20}, LineBytes{200}, FirstLine{3}, LineCount{50};
+
+        SplitSurface surface{surfaceSize};
+        auto contiguous{surface.GetAccessor(surface.contiguousGmmu, blockLinear, layer)};
+        auto split{surface.GetAccessor(surface.splitGmmu, blockLinear, layer)};
+        EXPECT(contiguous.base != nullptr);
+        EXPECT(split.base == nullptr);
+
+        std::mt19937 random{layer};
+        std::vector<u8> line(LineBytes), readBack(LineBytes);
+        for (u32 y{FirstLine}; y < FirstLine + LineCount; y++) {
+            std::generate(line.begin(), line.end(), [&random]() { return static_cast<u8>(random()); });
+            contiguous.WriteLine(y, XBytes, line);
+            split.WriteLine(y, XBytes, line);
+
+            split.ReadLine(y, XBytes, readBack);
+            EXPECT(readBack == line);
+        }
+
+        EXPECT(surface.GetSplitContents() == surface.contiguous);
+    }
+
+    TEST(SurfaceAccessorPitch) {
+        CheckAccessorPaths(static_cast<size_t>(SurfacePitch) * SurfaceHeight, false, 0);
+    }
+
+    TEST(SurfaceAccessorBlockLinear) {
+        CheckAccessorPaths(SurfaceLayout.GetSize(), true, 0);
+    }
+
+    TEST(SurfaceAccessorBlockLinearLayer) {
+        SplitSurface surface{SurfaceLayout.GetSize()};
+        auto accessor{surface.GetAccessor(surface.splitGmmu, true, 1)};
+
+        // Lines of the second layer must only be written to the second half of the surface which holds it
+        std::vector<u8> line(SurfaceLayout.widthBytes, 0xAB);
+        for (u32 y{}; y < SurfaceLayout.height; y++)
+            accessor.WriteLine(y, 0, line);
+
+        auto contents{surface.GetSplitContents()};
+        size_t layerSize{contents.size() / SurfaceLayout.depth};
+        EXPECT(std::all_of(contents.begin(), contents.begin() + layerSize, [](u8 value) { return value == 0; }));
+        EXPECT(std::all_of(contents.begin() + layerSize, contents.end(), [](u8 value) { return value == 0xAB; }));
+
+        CheckAccessorPaths(SurfaceLayout.GetSize(), true, 1);
+    }
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <kernel/svc_statistics.h>
+#include "test.h"
+
+namespace skyline::test {
+    using SvcStatistics = kernel::svc::SvcStatistics;
+
+    constexpr u16 SetHeapSize{0x01};
+    constexpr u16 SleepThread{0x0B};
+
+    TEST(SvcStatisticsCountsCalls) {
+        auto statistics{std::make_unique<SvcStatistics>()};
+        EXPECT(statistics->Aggregate().empty());
+
+        statistics->Record(0, SleepThread, 300);
+        statistics->Record(0, SleepThread, 100);
+        statistics->Record(1, SetHeapSize, 50);
+
+        // Only SVCs which have been called are summarized and they're ordered by their ID
+        auto summaries{statistics->Aggregate()};
+        EXPECT(summaries.size() == 2);
+        EXPECT(summaries[0].id == SetHeapSize);
+        EXPECT(std::string_view{summaries[0].name} == "SvcSetHeapSize");
+        EXPECT(summaries[0].count == 1);
+        EXPECT(summaries[0].totalTime == 50);
+        EXPECT(summaries[1].id == SleepThread);
+        EXPECT(std::string_view{summaries[1].name} == "SvcSleepThread");
+        EXPECT(summaries[1].count == 2);
+        EXPECT(summaries[1].totalTime == 400);
+    }
+
+    TEST(SvcStatisticsSumsCores) {
+        auto statistics{std::make_unique<SvcStatistics>()};
+        for (u8 coreId{}; coreId < constant::CoreCount; coreId++)
+            statistics->Record(coreId, SleepThread, 10);
+        statistics->Record(0xFF, SleepThread, 10); // A parked thread doesn't have a valid core
+
+        auto summaries{statistics->Aggregate()};
+        EXPECT(summaries.size() == 1);
+        EXPECT(summaries[0].count == constant::CoreCount + 1);
+        EXPECT(summaries[0].totalTime == (constant::CoreCount + 1) * 10);
+    }
+
+    TEST(SvcStatisticsHistogramBuckets) {
+        auto statistics{std::make_unique<SvcStatistics>()};
+
+        // Bucket N holds durations in [2^(N - 1), 2^N) with bucket 0 only holding a duration of 0
+        constexpr std::array<std::pair<i64, size_t>, 9> durations{{
+            {0, 0},
+            {1, 1},
+            {2, 2},
+            {3, 2},
+            {4, 3},
+            {1023, 10},
+            {1024, 11},
+            {1LL << 40, SvcStatistics::HistogramBucketCount - 1}, // Anything beyond the last bucket is clamped to it
+            {-5, 0}, // A negative duration from a non-monotonic clock is treated as 0
+        }};
+        for (auto [duration, bucket] : durations)
+            statistics->Record(0, SleepThread, duration);
+
+        auto summary{statistics->Aggregate().at(0)};
+        std::array<u64, SvcStatistics::HistogramBucketCount> expected{};
+        for (auto [duration, bucket] : durations)
+            expected[bucket]++;
+        EXPECT(summary.histogram == expected);
+        EXPECT(summary.count == durations.size());
+        EXPECT(summary.totalTime == 0 + 1 + 2 + 3 + 4 + 1023 + 1024 + (1ULL << 40));
+    }
+
+    TEST(SvcStatisticsDump) {
+        auto statistics{std::make_unique<SvcStatistics>()};
+        statistics->Record(0, SetHeapSize, 1000);
+        statistics->Record(0, SleepThread, 3000);
+
+        // SVCs are ordered by their total time in the dump
+        auto dump{statistics->Dump()};
+        auto sleepThread{dump.find("SvcSleepThread (0x0B): 1 calls")}, setHeapSize{dump.find("SvcSetHeapSize (0x01): 1 calls")};
+        EXPECT(sleepThread != std::string::npos);
+        EXPECT(setHeapSize != std::string::npos);
+        EXPECT(sleepThread < setHeapSize);
+        EXPECT(dump.find("<1024ns: 1") != std::string::npos);
+        EXPECT(dump.find("<4096ns: 1") != std::string::npos);
+    }
+}
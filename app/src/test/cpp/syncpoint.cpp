@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <soc/host1x/syncpoint.h>
+#include "test.h"
+
+namespace skyline::test {
+    using Syncpoint = soc::host1x::Syncpoint;
+
+    TEST(SyncpointCallbackDeregistersItself) {
+        Syncpoint syncpoint;
+        Syncpoint::WaiterHandle handle;
+        size_t calls{};
+        handle = syncpoint.RegisterWaiter(1, [&] {
+            calls++;
+            syncpoint.DeregisterWaiter(handle);
+        });
+
+        EXPECT(handle);
+        syncpoint.Increment();
+        EXPECT(calls == 1);
+    }
+
+    TEST(SyncpointCallbackIncrements) {
+        Syncpoint syncpoint;
+        bool secondCalled{};
+        syncpoint.RegisterWaiter(2, [&] { secondCalled = true; });
+        syncpoint.RegisterWaiter(1, [&] { syncpoint.Increment(); });
+
+        EXPECT(syncpoint.Increment() == 1);
+        EXPECT(secondCalled && syncpoint.Load() == 2);
+    }
+
+    TEST(SyncpointCallbackCancelsPendingWaiter) {
+        Syncpoint syncpoint;
+        bool secondCalled{};
+        Syncpoint::WaiterHandle second;
+
+        // Both waiters are dequeued by the same increment, the first one is run first as it was registered first
+        syncpoint.RegisterWaiter(1, [&] { syncpoint.DeregisterWaiter(second); });
+        second = syncpoint.RegisterWaiter(1, [&] { secondCalled = true; });
+
+        syncpoint.Increment();
+        EXPECT(!secondCalled);
+    }
+
+    TEST(SyncpointDeregisterWaitsForRunningCallback) {
+        Syncpoint syncpoint;
+        std::atomic<bool> started{}, finished{};
+        auto handle{syncpoint.RegisterWaiter(1, [&] {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+        })};
+
+        std::thread incrementThread([&] { syncpoint.Increment(); });
+        while (!started)
+            std::this_thread::yield();
+
+        syncpoint.DeregisterWaiter(handle);
+        bool finishedOnReturn{finished};
+        incrementThread.join();
+        EXPECT(finishedOnReturn);
+    }
+
+    TEST(SyncpointWraparound) {
+        Syncpoint syncpoint;
+        EXPECT(Syncpoint::IsThresholdReached(0, 0xFFFFFFFF));
+        EXPECT(!Syncpoint::IsThresholdReached(0xFFFFFFFF, 0));
+
+        bool called{};
+        syncpoint.RegisterWaiter(3, [&] { called = true; });
+        syncpoint.Increment();
+        syncpoint.Increment();
+        EXPECT(!called);
+        syncpoint.Increment();
+        EXPECT(called);
+    }
+}
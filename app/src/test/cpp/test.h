@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::test {
+    /**
+     * @brief A single test case which is registered by the TEST macro and run by the test executable
+     */
+    struct TestCase {
+        const char *name;
+        void (*function)();
+    };
+
+    /**
+     * @return All registered test cases in the order of their registration
+     */
+    inline std::vector<TestCase> &GetTestCases() {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    struct TestRegistration {
+        TestRegistration(const char *name, void (*function)()) {
+            GetTestCases().push_back({name, function});
+        }
+    };
+
+    /**
+     * @brief An exception thrown by a failed expectation, it's caught by the test runner to fail the current test
+     */
+    struct TestFailure : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * @return A path for a temporary file with the supplied name
+     */
+    inline std::string GetTemporaryPath(std::string_view name) {
+        const char *directory{getenv("TMPDIR")};
+        return fmt::format("{}/{}", directory ? directory : "/data/local/tmp", name);
+    }
+}
+
+#define TEST(name) \
+    static void Test##name(); \
+    static ::skyline::test::TestRegistration Registration##name{#name, Test##name}; \
+    static void Test##name()
+
+#define EXPECT(condition) \
+    do { \
+        if (!(condition)) \
+            throw ::skyline::test::TestFailure(fmt::format("{}:{}: Expected '{}'", __FILE__, __LINE__, #condition)); \
+    } while (false)